@@ -0,0 +1,98 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * This module provides a thin abstraction over the AES-CTR used to encrypt
+ * and decrypt image payloads.  Whole buffers are handed to the backend, so
+ * that a crypto engine can process them in a single operation.
+ *
+ * Bootutil runs the counter mode itself (aes_ctr.c) on top of the block
+ * cipher of the crypto library, MCUBOOT_USE_MBED_TLS or MCUBOOT_USE_TINYCRYPT,
+ * and uses AES-NI instead on x86 hosts (the simulator) that have it.  The
+ * CC310 bootloader library has no AES, so MCUBOOT_USE_CC310 builds use
+ * TinyCrypt's.
+ */
+
+#ifndef __BOOTUTIL_AES_CTR_H_
+#define __BOOTUTIL_AES_CTR_H_
+
+#include "mcuboot_config/mcuboot_config.h"
+
+#if (defined(MCUBOOT_USE_MBED_TLS) + \
+     defined(MCUBOOT_USE_TINYCRYPT) + \
+     defined(MCUBOOT_USE_CC310)) != 1
+    #error "One crypto backend must be defined either CC310, MBED_TLS or TINYCRYPT"
+#endif
+
+#ifdef MCUBOOT_USE_MBED_TLS
+    #include <mbedtls/aes.h>
+#endif /* MCUBOOT_USE_MBED_TLS */
+
+#if defined(MCUBOOT_USE_TINYCRYPT) || defined(MCUBOOT_USE_CC310)
+    #if defined(MCUBOOT_AES_256)
+        #error "TinyCrypt only implements AES-128, MCUBOOT_AES_256 needs MBED_TLS"
+    #endif
+    #include <tinycrypt/aes.h>
+#endif /* MCUBOOT_USE_TINYCRYPT || MCUBOOT_USE_CC310 */
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BOOTUTIL_AES_BLOCK_SIZE 16
+
+/*
+ * bootutil_aes_ctr_set_key() takes a BOOT_ENC_KEY_SIZE bytes key.
+ *
+ * bootutil_aes_ctr_encrypt() encrypts, or decrypts, `len` bytes of `buf` in
+ * place.  `counter` is the big endian counter block the data starts in, and
+ * `blk_off` the offset of the data within that block.  On return, `counter`
+ * holds the block following the one the data ends in.
+ */
+
+#if (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 5))
+#define BOOTUTIL_AES_CTR_HAVE_AESNI
+#endif
+
+#ifdef MCUBOOT_AES_256
+#define BOOTUTIL_AES_CTR_ROUNDS 14
+#else
+#define BOOTUTIL_AES_CTR_ROUNDS 10
+#endif
+
+typedef struct {
+#if defined(MCUBOOT_USE_MBED_TLS)
+    mbedtls_aes_context aes;
+#else
+    struct tc_aes_key_sched_struct aes;
+#endif
+#ifdef BOOTUTIL_AES_CTR_HAVE_AESNI
+    /* Set when the AES-NI round keys below are used. */
+    uint8_t aesni;
+    uint8_t aesni_keys[(BOOTUTIL_AES_CTR_ROUNDS + 1) * BOOTUTIL_AES_BLOCK_SIZE];
+#endif
+} bootutil_aes_ctr_context;
+
+/*
+ * Returns 1 if AES-NI is compiled in and supported by this CPU.
+ */
+int bootutil_aes_ctr_aesni_usable(void);
+
+void bootutil_aes_ctr_init(bootutil_aes_ctr_context *ctx);
+int bootutil_aes_ctr_set_key(bootutil_aes_ctr_context *ctx,
+                             const uint8_t *key);
+void bootutil_aes_ctr_encrypt(bootutil_aes_ctr_context *ctx,
+                              uint8_t counter[BOOTUTIL_AES_BLOCK_SIZE],
+                              uint32_t blk_off, uint8_t *buf, uint32_t len);
+void bootutil_aes_ctr_drop(bootutil_aes_ctr_context *ctx);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __BOOTUTIL_AES_CTR_H_ */
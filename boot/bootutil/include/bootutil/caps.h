@@ -45,6 +45,13 @@ uint32_t bootutil_get_caps(void);
 #define BOOTUTIL_CAP_ENC_EC256              (1<<10)
 #define BOOTUTIL_CAP_SWAP_USING_MOVE        (1<<11)
 #define BOOTUTIL_CAP_DOWNGRADE_PREVENTION   (1<<12)
+#define BOOTUTIL_CAP_HASH_CHUNKS            (1<<13)
+#define BOOTUTIL_CAP_SHA384                 (1<<14)
+#define BOOTUTIL_CAP_SHA512                 (1<<15)
+#define BOOTUTIL_CAP_ENC_X25519             (1<<16)
+#define BOOTUTIL_CAP_AES256                 (1<<17)
+#define BOOTUTIL_CAP_VALIDATED_RECORD       (1<<18)
+#define BOOTUTIL_CAP_UNIFORM_SECTOR_SIZE    (1<<19)
 
 /*
  * Query the number of images this bootloader is configured for.  This
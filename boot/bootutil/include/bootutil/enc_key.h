@@ -25,28 +25,37 @@
 #include <flash_map_backend/flash_map_backend.h>
 #include "mcuboot_config/mcuboot_config.h"
 #include "bootutil/image.h"
-
-#if defined(MCUBOOT_USE_MBED_TLS)
-#include "mbedtls/aes.h"
-#else
-#include "tinycrypt/aes.h"
+#ifdef MCUBOOT_ENC_IMAGES
+#include "bootutil/aes_ctr.h"
 #endif
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+#ifdef MCUBOOT_AES_256
+#define BOOT_ENC_KEY_SIZE       32
+#else
 #define BOOT_ENC_KEY_SIZE       16
+#endif
 #define BOOT_ENC_KEY_SIZE_BITS  (BOOT_ENC_KEY_SIZE * 8)
 
+#if defined(MCUBOOT_AES_256) && \
+    (defined(MCUBOOT_ENCRYPT_EC256) || defined(MCUBOOT_ENCRYPT_X25519))
+#error "MCUBOOT_AES_256 is only supported with MCUBOOT_ENCRYPT_RSA or MCUBOOT_ENCRYPT_KW"
+#endif
+
 #define TLV_ENC_RSA_SZ    256
-#define TLV_ENC_KW_SZ     24
+#define TLV_ENC_KW_SZ     (BOOT_ENC_KEY_SIZE + 8)
 #define TLV_ENC_EC256_SZ  (65 + 32 + 16)
+#define TLV_ENC_X25519_SZ (32 + 32 + 16)
 
 #if defined(MCUBOOT_ENCRYPT_RSA)
 #define BOOT_ENC_TLV_SIZE TLV_ENC_RSA_SZ
 #elif defined(MCUBOOT_ENCRYPT_EC256)
 #define BOOT_ENC_TLV_SIZE TLV_ENC_EC256_SZ
+#elif defined(MCUBOOT_ENCRYPT_X25519)
+#define BOOT_ENC_TLV_SIZE TLV_ENC_X25519_SZ
 #else
 #define BOOT_ENC_TLV_SIZE TLV_ENC_KW_SZ
 #endif
@@ -54,14 +63,14 @@ extern "C" {
 #define BOOT_ENC_TLV_ALIGN_SIZE \
     ((((BOOT_ENC_TLV_SIZE - 1) / BOOT_MAX_ALIGN) + 1) * BOOT_MAX_ALIGN)
 
+#ifdef MCUBOOT_ENC_IMAGES
 struct enc_key_data {
     uint8_t valid;
-#if defined(MCUBOOT_USE_MBED_TLS)
-    mbedtls_aes_context aes;
-#else
-    struct tc_aes_key_sched_struct aes;
-#endif
+    /* The plain key, for the swap status of later swaps in the same boot. */
+    uint8_t key[BOOT_ENC_KEY_SIZE];
+    bootutil_aes_ctr_context aes_ctr;
 };
+#endif
 
 extern const struct bootutil_key bootutil_enc_key;
 struct boot_status;
@@ -57,6 +57,11 @@ struct flash_area;
  * ih_load_addr field of the header.
  */
 #define IMAGE_F_RAM_LOAD                 0x00000020
+/*
+ * Indicates that the image hash is not a SHA256 of the image but the SHA256
+ * of its IMAGE_TLV_SHA256_CHUNKS list of chunk digests.
+ */
+#define IMAGE_F_HASH_CHUNKS              0x00000040
 
 /*
  * ECSDA224 is with NIST P-224
@@ -67,7 +72,7 @@ struct flash_area;
  * Image trailer TLV types.
  *
  * Signature is generated by computing signature over the image hash.
- * Currently the only image hash type is SHA256.
+ * The image hash is SHA256, or SHA384 or SHA512 (see bootutil/sha256.h).
  *
  * Signature comes in the form of 2 TLVs.
  *   1st on identifies the public key which should be used to verify it.
@@ -75,14 +80,18 @@ struct flash_area;
  */
 #define IMAGE_TLV_KEYHASH           0x01   /* hash of the public key */
 #define IMAGE_TLV_SHA256            0x10   /* SHA256 of image hdr and body */
+#define IMAGE_TLV_SHA384            0x11   /* SHA384 of image hdr and body */
+#define IMAGE_TLV_SHA512            0x12   /* SHA512 of image hdr and body */
+#define IMAGE_TLV_SHA256_CHUNKS     0x14   /* Chunk size, SHA256 of each chunk */
 #define IMAGE_TLV_RSA2048_PSS       0x20   /* RSA2048 of hash output */
 #define IMAGE_TLV_ECDSA224          0x21   /* ECDSA of hash output */
 #define IMAGE_TLV_ECDSA256          0x22   /* ECDSA of hash output */
 #define IMAGE_TLV_RSA3072_PSS       0x23   /* RSA3072 of hash output */
 #define IMAGE_TLV_ED25519           0x24   /* ed25519 of hash output */
 #define IMAGE_TLV_ENC_RSA2048       0x30   /* Key encrypted with RSA-OAEP-2048 */
-#define IMAGE_TLV_ENC_KW128         0x31   /* Key encrypted with AES-KW-128 */
+#define IMAGE_TLV_ENC_KW128         0x31   /* Key encrypted with AES-KW */
 #define IMAGE_TLV_ENC_EC256         0x32   /* Key encrypted with ECIES-EC256 */
+#define IMAGE_TLV_ENC_X25519        0x33   /* Key encrypted with ECIES-X25519 */
 #define IMAGE_TLV_DEPENDENCY        0x40   /* Image depends on other image */
 #define IMAGE_TLV_SEC_CNT           0x50   /* security counter */
 #define IMAGE_TLV_BOOT_RECORD       0x60   /* measured boot record */
@@ -147,6 +156,8 @@ int bootutil_img_validate(struct enc_key_data *enc_state, int image_index,
                           const struct flash_area *fap,
                           uint8_t *tmp_buf, uint32_t tmp_buf_sz,
                           uint8_t *seed, int seed_len, uint8_t *out_hash);
+int bootutil_img_validate_hash(int image_index, struct image_header *hdr,
+                               const struct flash_area *fap, uint8_t *hash);
 
 struct image_tlv_iter {
     const struct image_header *hdr;
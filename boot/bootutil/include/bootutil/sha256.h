@@ -24,6 +24,12 @@
  * At this point, there are two choices: MCUBOOT_USE_MBED_TLS, or
  * MCUBOOT_USE_TINYCRYPT.  It is a compile error there is not exactly
  * one of these defined.
+ *
+ * With MCUBOOT_USE_BOOTUTIL_SHA256, SHA256 is instead provided by
+ * bootutil itself (sha256.c), whatever the crypto library.
+ *
+ * Images are hashed through the bootutil_img_hash_* functions, which use
+ * SHA256 unless MCUBOOT_SHA384 or MCUBOOT_SHA512 is defined.
  */
 
 #ifndef __BOOTUTIL_CRYPTO_H_
@@ -46,16 +52,75 @@
 #endif /* MCUBOOT_USE_TINYCRYPT */
 
 #ifdef MCUBOOT_USE_CC310
+#ifdef MCUBOOT_USE_BOOTUTIL_SHA256
+    #error "MCUBOOT_USE_BOOTUTIL_SHA256 is not supported with MCUBOOT_USE_CC310"
+#endif
     #include <cc310_glue.h>
 #endif /* MCUBOOT_USE_CC310 */
 
+#if defined(MCUBOOT_SHA384) && defined(MCUBOOT_SHA512)
+    #error "Only one of MCUBOOT_SHA384 and MCUBOOT_SHA512 can be defined"
+#endif
+
+#if defined(MCUBOOT_SHA384) || defined(MCUBOOT_SHA512)
+#if defined(MCUBOOT_USE_MBED_TLS)
+    #include <mbedtls/sha512.h>
+#elif defined(MCUBOOT_USE_TINYCRYPT)
+    #include <tinycrypt/sha512.h>
+#else
+    #error "SHA384 and SHA512 image hashes need mbedTLS or TinyCrypt"
+#endif
+#endif
+
 #include <stdint.h>
+#include <string.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-#ifdef MCUBOOT_USE_MBED_TLS
+#if defined(MCUBOOT_USE_BOOTUTIL_SHA256)
+/*
+ * Compresses `nblocks` consecutive 64-byte blocks of data into `state`.
+ */
+typedef void bootutil_sha256_blocks_t(uint32_t state[8], const uint8_t *data,
+                                      uint32_t nblocks);
+
+typedef struct {
+    uint32_t state[8];
+    uint64_t len;                       /* Bytes hashed so far. */
+    bootutil_sha256_blocks_t *blocks;
+    uint8_t buf[64];
+} bootutil_sha256_context;
+
+/*
+ * A block function built into bootutil.
+ */
+struct bootutil_sha256_impl {
+    const char *name;
+    bootutil_sha256_blocks_t *blocks;
+};
+
+/*
+ * Returns the number of block functions usable on this CPU, best last,
+ * and sets `impls` to point to them.  The first one is always the portable
+ * C one.
+ */
+int bootutil_sha256_impls(const struct bootutil_sha256_impl **impls);
+
+/*
+ * With MCUBOOT_SHA256_PLATFORM_BLOCKS, the platform provides the block
+ * function, e.g. to use a hash accelerator or hand written assembly.
+ */
+void bootutil_sha256_platform_blocks(uint32_t state[8], const uint8_t *data,
+                                     uint32_t nblocks);
+
+void bootutil_sha256_init(bootutil_sha256_context *ctx);
+void bootutil_sha256_update(bootutil_sha256_context *ctx, const void *data,
+                            uint32_t data_len);
+void bootutil_sha256_finish(bootutil_sha256_context *ctx, uint8_t *output);
+
+#elif defined(MCUBOOT_USE_MBED_TLS)
 typedef mbedtls_sha256_context bootutil_sha256_context;
 
 static inline void bootutil_sha256_init(bootutil_sha256_context *ctx)
@@ -76,9 +141,8 @@ static inline void bootutil_sha256_finish(bootutil_sha256_context *ctx,
 {
     (void)mbedtls_sha256_finish_ret(ctx, output);
 }
-#endif /* MCUBOOT_USE_MBED_TLS */
 
-#ifdef MCUBOOT_USE_TINYCRYPT
+#elif defined(MCUBOOT_USE_TINYCRYPT)
 typedef struct tc_sha256_state_struct bootutil_sha256_context;
 static inline void bootutil_sha256_init(bootutil_sha256_context *ctx)
 {
@@ -97,9 +161,8 @@ static inline void bootutil_sha256_finish(bootutil_sha256_context *ctx,
 {
     tc_sha256_final(output, ctx);
 }
-#endif /* MCUBOOT_USE_TINYCRYPT */
 
-#ifdef MCUBOOT_USE_CC310
+#elif defined(MCUBOOT_USE_CC310)
 static inline void bootutil_sha256_init(bootutil_sha256_context *ctx)
 {
     cc310_sha256_init(ctx);
@@ -119,6 +182,106 @@ static inline void bootutil_sha256_finish(bootutil_sha256_context *ctx,
 }
 #endif /* MCUBOOT_USE_CC310 */
 
+/*
+ * Image hash: the hash computed over images and stored in their
+ * BOOTUTIL_IMG_HASH_TLV TLV.  SHA384 and SHA512 are faster than SHA256
+ * per byte on 64-bit cores.
+ */
+#if defined(MCUBOOT_SHA384) || defined(MCUBOOT_SHA512)
+#ifdef MCUBOOT_SHA384
+#define BOOTUTIL_IMG_HASH_SIZE  48
+#define BOOTUTIL_IMG_HASH_TLV   IMAGE_TLV_SHA384
+#else
+#define BOOTUTIL_IMG_HASH_SIZE  64
+#define BOOTUTIL_IMG_HASH_TLV   IMAGE_TLV_SHA512
+#endif
+
+#ifdef MCUBOOT_USE_MBED_TLS
+typedef mbedtls_sha512_context bootutil_img_hash_context;
+
+static inline void bootutil_img_hash_init(bootutil_img_hash_context *ctx)
+{
+    mbedtls_sha512_init(ctx);
+    (void)mbedtls_sha512_starts_ret(ctx, BOOTUTIL_IMG_HASH_SIZE == 48);
+}
+
+static inline void bootutil_img_hash_update(bootutil_img_hash_context *ctx,
+                                            const void *data,
+                                            uint32_t data_len)
+{
+    (void)mbedtls_sha512_update_ret(ctx, data, data_len);
+}
+
+static inline void bootutil_img_hash_finish(bootutil_img_hash_context *ctx,
+                                            uint8_t *output)
+{
+    (void)mbedtls_sha512_finish_ret(ctx, output);
+}
+#else /* MCUBOOT_USE_TINYCRYPT */
+typedef struct tc_sha512_state_struct bootutil_img_hash_context;
+
+/* SHA384 is SHA512 with other initial values, truncated. */
+static inline void bootutil_img_hash_init(bootutil_img_hash_context *ctx)
+{
+    tc_sha512_init(ctx);
+#ifdef MCUBOOT_SHA384
+    ctx->iv[0] = 0xcbbb9d5dc1059ed8ULL;
+    ctx->iv[1] = 0x629a292a367cd507ULL;
+    ctx->iv[2] = 0x9159015a3070dd17ULL;
+    ctx->iv[3] = 0x152fecd8f70e5939ULL;
+    ctx->iv[4] = 0x67332667ffc00b31ULL;
+    ctx->iv[5] = 0x8eb44a8768581511ULL;
+    ctx->iv[6] = 0xdb0c2e0d64f98fa7ULL;
+    ctx->iv[7] = 0x47b5481dbefa4fa4ULL;
+#endif
+}
+
+static inline void bootutil_img_hash_update(bootutil_img_hash_context *ctx,
+                                            const void *data,
+                                            uint32_t data_len)
+{
+    tc_sha512_update(ctx, data, data_len);
+}
+
+static inline void bootutil_img_hash_finish(bootutil_img_hash_context *ctx,
+                                            uint8_t *output)
+{
+#ifdef MCUBOOT_SHA384
+    uint8_t digest[TC_SHA512_DIGEST_SIZE];
+
+    tc_sha512_final(digest, ctx);
+    memcpy(output, digest, BOOTUTIL_IMG_HASH_SIZE);
+#else
+    tc_sha512_final(output, ctx);
+#endif
+}
+#endif /* MCUBOOT_USE_TINYCRYPT */
+
+#else /* SHA256 */
+#define BOOTUTIL_IMG_HASH_SIZE  32
+#define BOOTUTIL_IMG_HASH_TLV   IMAGE_TLV_SHA256
+
+typedef bootutil_sha256_context bootutil_img_hash_context;
+
+static inline void bootutil_img_hash_init(bootutil_img_hash_context *ctx)
+{
+    bootutil_sha256_init(ctx);
+}
+
+static inline void bootutil_img_hash_update(bootutil_img_hash_context *ctx,
+                                            const void *data,
+                                            uint32_t data_len)
+{
+    bootutil_sha256_update(ctx, data, data_len);
+}
+
+static inline void bootutil_img_hash_finish(bootutil_img_hash_context *ctx,
+                                            uint8_t *output)
+{
+    bootutil_sha256_finish(ctx, output);
+}
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -26,9 +26,31 @@
 extern "C" {
 #endif
 
+/*
+ * An RSA public key with exponent 65537, in the form used for Montgomery
+ * multiplication: the numbers are stored least significant word first.
+ */
+struct bootutil_rsa_key {
+    /* Number of 32-bit words of the modulus, or 0 if the key doesn't have
+     * this form, and is parsed instead. */
+    uint32_t words;
+    /* -1 / N mod 2^32. */
+    uint32_t n0inv;
+    /* The modulus N. */
+    const uint32_t *n;
+    /* R^2 mod N, where R = 2^(32 * words). */
+    const uint32_t *rr;
+};
+
 struct bootutil_key {
     const uint8_t *key;
     const unsigned int *len;
+    /* SHA256 of the key, as emitted by imgtool getpub, or NULL to have it
+     * computed each time it is looked up. */
+    const uint8_t *hash;
+    /* The same RSA key, as emitted by imgtool getpub, or NULL to have the
+     * key parsed for each signature checked. */
+    const struct bootutil_rsa_key *rsa;
 };
 
 extern const struct bootutil_key bootutil_keys[];
@@ -0,0 +1,49 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __VALIDATED_RECORD_H__
+#define __VALIDATED_RECORD_H__
+
+/**
+ * @file validated_record.h
+ *
+ * With MCUBOOT_VALIDATED_RECORD, once the image in the primary slot has been
+ * fully validated, the boot loader writes a record to the slot's trailer: an
+ * HMAC-SHA256, keyed with a device-unique secret, of the image header and of
+ * the image's SHA256 TLV.  On later boots a matching record replaces hashing
+ * the image and verifying its signature.
+ *
+ * The record is erased along with the trailer by any upgrade.  A record
+ * left over from another image, or written with another secret, does not
+ * match; once the image has been fully validated, the trailer sectors
+ * holding it are erased and a new one is written, unless the image is
+ * waiting to be confirmed or shares these sectors.  Data
+ * written to the image behind the boot loader's back is however not
+ * detected, so the platform must prevent that as it would without
+ * MCUBOOT_VALIDATE_PRIMARY_SLOT.
+ */
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Retrieves the device-unique secret the records are authenticated with.
+ * It must not be readable by the booted images.
+ *
+ * @param key               Pointer set to the secret.
+ * @param key_len           Pointer to store the length of the secret, which
+ *                          must be between 1 and 64 bytes.
+ *
+ * @return                  0 on success; nonzero on failure.
+ */
+int32_t boot_validated_record_key_get(const uint8_t **key, uint32_t *key_len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __VALIDATED_RECORD_H__ */
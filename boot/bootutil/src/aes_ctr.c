@@ -0,0 +1,307 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * AES-CTR of bootutil/aes_ctr.h, on top of the AES of mbedTLS
+ * (MCUBOOT_USE_MBED_TLS) or of TinyCrypt (MCUBOOT_USE_TINYCRYPT and
+ * MCUBOOT_USE_CC310).
+ *
+ * The keystream of several counter blocks is generated at a time, then XORed
+ * into the data a word at a time.  The blocks are encrypted with the crypto
+ * library's AES, or with AES-NI on x86 hosts (the simulator), four blocks
+ * being interleaved to hide the latency of the aesenc instructions.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "mcuboot_config/mcuboot_config.h"
+
+#if defined(MCUBOOT_ENC_IMAGES)
+
+#include "bootutil/aes_ctr.h"
+#include "bootutil/enc_key.h"
+
+#if !defined(MCUBOOT_USE_MBED_TLS)
+#include "tinycrypt/constants.h"
+#endif
+
+#ifdef BOOTUTIL_AES_CTR_HAVE_AESNI
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+/*
+ * Number of counter blocks encrypted at a time.
+ */
+#ifndef MCUBOOT_ENC_CTR_BLOCKS
+#define MCUBOOT_ENC_CTR_BLOCKS  4
+#endif
+
+static void
+aes_ctr_inc(uint8_t *ctr)
+{
+    int j;
+
+    for (j = BOOTUTIL_AES_BLOCK_SIZE; j > 0; --j) {
+        if (++ctr[j - 1] != 0) {
+            break;
+        }
+    }
+}
+
+/*
+ * Encrypts `blocks` consecutive values of the counter `ctr` into `stream`
+ * with the crypto library, leaving `ctr` at the next value.
+ */
+static void
+aes_ctr_blocks_lib(bootutil_aes_ctr_context *ctx, uint8_t *ctr,
+                   uint8_t *stream, uint32_t blocks)
+{
+    for (; blocks > 0; blocks--, stream += BOOTUTIL_AES_BLOCK_SIZE) {
+#if defined(MCUBOOT_USE_MBED_TLS)
+        mbedtls_aes_crypt_ecb(&ctx->aes, MBEDTLS_AES_ENCRYPT, ctr, stream);
+#else
+        tc_aes_encrypt(stream, ctr, &ctx->aes);
+#endif
+        aes_ctr_inc(ctr);
+    }
+}
+
+#ifdef BOOTUTIL_AES_CTR_HAVE_AESNI
+int
+bootutil_aes_ctr_aesni_usable(void)
+{
+    unsigned int eax, ebx, ecx, edx;
+
+    /* AES-NI and SSE2. */
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+        return 0;
+    }
+
+    return (ecx & (1 << 25)) != 0 && (edx & (1 << 26)) != 0;
+}
+
+__attribute__((target("aes,sse2")))
+static inline __m128i
+aesni_expand(__m128i key, __m128i assist)
+{
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+
+    return _mm_xor_si128(key, assist);
+}
+
+/*
+ * Round key i from the one two (AES-256) or one (AES-128) keys back, and
+ * the rotated, substituted and rcon'ed last word of round key i - 1.
+ */
+#define AESNI_EXPAND(k, i, back, rcon) \
+    ((k)[i] = aesni_expand((k)[(i) - (back)], \
+        _mm_shuffle_epi32(_mm_aeskeygenassist_si128((k)[(i) - 1], (rcon)), \
+                          0xff)))
+
+/*
+ * The odd AES-256 round keys only substitute the last word of key i - 1.
+ */
+#define AESNI_EXPAND_ODD(k, i) \
+    ((k)[i] = aesni_expand((k)[(i) - 2], \
+        _mm_shuffle_epi32(_mm_aeskeygenassist_si128((k)[(i) - 1], 0), 0xaa)))
+
+/*
+ * Expands an AES-128 or AES-256 key into the round keys.
+ */
+__attribute__((target("aes,sse2")))
+static void
+aesni_set_key(uint8_t *round_keys, const uint8_t *key)
+{
+    __m128i k[BOOTUTIL_AES_CTR_ROUNDS + 1];
+    int i;
+
+    k[0] = _mm_loadu_si128((const __m128i *)key);
+#ifdef MCUBOOT_AES_256
+    k[1] = _mm_loadu_si128((const __m128i *)(key + 16));
+    AESNI_EXPAND(k, 2, 2, 0x01);
+    AESNI_EXPAND_ODD(k, 3);
+    AESNI_EXPAND(k, 4, 2, 0x02);
+    AESNI_EXPAND_ODD(k, 5);
+    AESNI_EXPAND(k, 6, 2, 0x04);
+    AESNI_EXPAND_ODD(k, 7);
+    AESNI_EXPAND(k, 8, 2, 0x08);
+    AESNI_EXPAND_ODD(k, 9);
+    AESNI_EXPAND(k, 10, 2, 0x10);
+    AESNI_EXPAND_ODD(k, 11);
+    AESNI_EXPAND(k, 12, 2, 0x20);
+    AESNI_EXPAND_ODD(k, 13);
+    AESNI_EXPAND(k, 14, 2, 0x40);
+#else
+    AESNI_EXPAND(k, 1, 1, 0x01);
+    AESNI_EXPAND(k, 2, 1, 0x02);
+    AESNI_EXPAND(k, 3, 1, 0x04);
+    AESNI_EXPAND(k, 4, 1, 0x08);
+    AESNI_EXPAND(k, 5, 1, 0x10);
+    AESNI_EXPAND(k, 6, 1, 0x20);
+    AESNI_EXPAND(k, 7, 1, 0x40);
+    AESNI_EXPAND(k, 8, 1, 0x80);
+    AESNI_EXPAND(k, 9, 1, 0x1b);
+    AESNI_EXPAND(k, 10, 1, 0x36);
+#endif
+
+    for (i = 0; i <= BOOTUTIL_AES_CTR_ROUNDS; i++) {
+        _mm_storeu_si128((__m128i *)&round_keys[i * 16], k[i]);
+    }
+}
+
+__attribute__((target("aes,sse2")))
+static void
+aes_ctr_blocks_aesni(bootutil_aes_ctr_context *ctx, uint8_t *ctr,
+                     uint8_t *stream, uint32_t blocks)
+{
+    __m128i k[BOOTUTIL_AES_CTR_ROUNDS + 1];
+    __m128i b[4];
+    uint32_t n;
+    uint32_t i;
+    int r;
+
+    for (r = 0; r <= BOOTUTIL_AES_CTR_ROUNDS; r++) {
+        k[r] = _mm_loadu_si128((const __m128i *)&ctx->aesni_keys[r * 16]);
+    }
+
+    while (blocks > 0) {
+        n = blocks < 4 ? blocks : 4;
+        for (i = 0; i < n; i++) {
+            b[i] = _mm_xor_si128(_mm_loadu_si128((const __m128i *)ctr), k[0]);
+            aes_ctr_inc(ctr);
+        }
+        for (r = 1; r < BOOTUTIL_AES_CTR_ROUNDS; r++) {
+            for (i = 0; i < n; i++) {
+                b[i] = _mm_aesenc_si128(b[i], k[r]);
+            }
+        }
+        for (i = 0; i < n; i++) {
+            b[i] = _mm_aesenclast_si128(b[i], k[BOOTUTIL_AES_CTR_ROUNDS]);
+            _mm_storeu_si128((__m128i *)stream, b[i]);
+            stream += BOOTUTIL_AES_BLOCK_SIZE;
+        }
+        blocks -= n;
+    }
+}
+#else
+int
+bootutil_aes_ctr_aesni_usable(void)
+{
+    return 0;
+}
+#endif /* BOOTUTIL_AES_CTR_HAVE_AESNI */
+
+/*
+ * XORs `len` bytes of keystream into `buf`, a word at a time.  The words go
+ * through memcpy, which compilers turn into plain loads and stores where the
+ * target allows unaligned accesses, and which keeps this free of aliasing
+ * assumptions about the callers' buffers.
+ */
+static void
+aes_ctr_xor(uint8_t *buf, const uint8_t *stream, uint32_t len)
+{
+    uint32_t b;
+    uint32_t s;
+
+    for (; len >= sizeof(uint32_t); len -= sizeof(uint32_t)) {
+        memcpy(&b, buf, sizeof b);
+        memcpy(&s, stream, sizeof s);
+        b ^= s;
+        memcpy(buf, &b, sizeof b);
+        buf += sizeof(uint32_t);
+        stream += sizeof(uint32_t);
+    }
+
+    while (len > 0) {
+        *buf++ ^= *stream++;
+        len--;
+    }
+}
+
+void
+bootutil_aes_ctr_init(bootutil_aes_ctr_context *ctx)
+{
+    memset(ctx, 0, sizeof *ctx);
+#if defined(MCUBOOT_USE_MBED_TLS)
+    mbedtls_aes_init(&ctx->aes);
+#endif
+}
+
+int
+bootutil_aes_ctr_set_key(bootutil_aes_ctr_context *ctx, const uint8_t *key)
+{
+#if defined(MCUBOOT_USE_MBED_TLS)
+    if (mbedtls_aes_setkey_enc(&ctx->aes, key, BOOT_ENC_KEY_SIZE_BITS)) {
+        return -1;
+    }
+#else
+    /* set_encrypt and set_decrypt do the same thing in tinycrypt */
+    if (tc_aes128_set_encrypt_key(&ctx->aes, key) != TC_CRYPTO_SUCCESS) {
+        return -1;
+    }
+#endif
+
+#ifdef BOOTUTIL_AES_CTR_HAVE_AESNI
+    ctx->aesni = bootutil_aes_ctr_aesni_usable();
+    if (ctx->aesni) {
+        aesni_set_key(ctx->aesni_keys, key);
+    }
+#endif
+
+    return 0;
+}
+
+void
+bootutil_aes_ctr_encrypt(bootutil_aes_ctr_context *ctx,
+                         uint8_t counter[BOOTUTIL_AES_BLOCK_SIZE],
+                         uint32_t blk_off, uint8_t *buf, uint32_t len)
+{
+    uint8_t stream[MCUBOOT_ENC_CTR_BLOCKS * BOOTUTIL_AES_BLOCK_SIZE];
+    uint32_t blocks;
+    uint32_t n;
+
+    while (len > 0) {
+        blocks = (blk_off + len + BOOTUTIL_AES_BLOCK_SIZE - 1) /
+                 BOOTUTIL_AES_BLOCK_SIZE;
+        if (blocks > MCUBOOT_ENC_CTR_BLOCKS) {
+            blocks = MCUBOOT_ENC_CTR_BLOCKS;
+        }
+#ifdef BOOTUTIL_AES_CTR_HAVE_AESNI
+        if (ctx->aesni) {
+            aes_ctr_blocks_aesni(ctx, counter, stream, blocks);
+        } else
+#endif
+        {
+            aes_ctr_blocks_lib(ctx, counter, stream, blocks);
+        }
+
+        n = blocks * BOOTUTIL_AES_BLOCK_SIZE - blk_off;
+        if (n > len) {
+            n = len;
+        }
+        aes_ctr_xor(buf, stream + blk_off, n);
+
+        buf += n;
+        len -= n;
+        blk_off = 0;
+    }
+
+    memset(stream, 0, sizeof stream);
+}
+
+void
+bootutil_aes_ctr_drop(bootutil_aes_ctr_context *ctx)
+{
+#if defined(MCUBOOT_USE_MBED_TLS)
+    mbedtls_aes_free(&ctx->aes);
+#endif
+    memset(ctx, 0, sizeof *ctx);
+}
+
+#endif /* MCUBOOT_ENC_IMAGES */
@@ -147,6 +147,51 @@ boot_magic_compatible_check(uint8_t tbl_val, uint8_t val)
     }
 }
 
+/**
+ * Checks whether a buffer only contains the erased value of a flash area.
+ * The bulk of the buffer is checked a word at a time.
+ *
+ * @param fap                   The flash area the data belongs to.
+ * @param buf                   The data to check.
+ * @param len                   The number of bytes to check.
+ *
+ * @return                      true if all bytes are erased; false otherwise.
+ */
+bool
+boot_buf_is_erased(const struct flash_area *fap, const void *buf, size_t len)
+{
+    const uint8_t *u8p;
+    const uint32_t *u32p;
+    uint32_t pattern;
+    uint8_t erased_val;
+
+    erased_val = flash_area_erased_val(fap);
+    pattern = erased_val * 0x01010101UL;
+
+    u8p = buf;
+    while (len > 0 && ((uintptr_t)u8p & (sizeof(uint32_t) - 1)) != 0) {
+        if (*u8p != erased_val) {
+            return false;
+        }
+        u8p++;
+        len--;
+    }
+
+    for (u32p = (const uint32_t *)u8p; len >= sizeof(uint32_t); len -= 4) {
+        if (*u32p++ != pattern) {
+            return false;
+        }
+    }
+
+    for (u8p = (const uint8_t *)u32p; len > 0; len--) {
+        if (*u8p++ != erased_val) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 uint32_t
 boot_status_sz(uint32_t min_write_sz)
 {
@@ -166,6 +211,9 @@ boot_trailer_sz(uint32_t min_write_sz)
 #  else
            BOOT_ENC_KEY_SIZE * 2                  +
 #  endif
+#endif
+#ifdef MCUBOOT_VALIDATED_RECORD
+           BOOT_VALIDATED_RECORD_SZ               +
 #endif
            /* swap_type + copy_done + image_ok + swap_size */
            BOOT_MAX_ALIGN * 4                     +
@@ -201,6 +249,103 @@ boot_status_off(const struct flash_area *fap)
     return fap->fa_size - off_from_end;
 }
 
+#ifdef MCUBOOT_VALIDATED_RECORD
+/*
+ * The validated record sits right after the status area.
+ */
+uint32_t
+boot_validated_record_off(const struct flash_area *fap)
+{
+    return boot_status_off(fap) + boot_status_sz(flash_area_align(fap));
+}
+#endif
+
+/**
+ * Reads the status entries of an area into the buffer pool, as many at a
+ * time as fit, and summarizes which of them were written.  Only the first
+ * byte of an entry tells whether it was written, the rest is padding up to
+ * the write size.  Chunks reported empty by the flash are accounted for as
+ * a whole, which makes scanning the mostly erased status area of a swap
+ * that stopped early cheap.
+ *
+ * @param state                 Boot loader status information.
+ * @param fap                   The flash area holding the status.
+ * @param max_entries           The number of entries in the status area.
+ * @param scan                  On success, the summary of the entries.
+ *
+ * @return                      0 on success; nonzero on failure.
+ */
+int
+boot_scan_status(struct boot_loader_state *state,
+                 const struct flash_area *fap, int max_entries,
+                 struct boot_status_scan *scan)
+{
+    const uint8_t *buf;
+    uint32_t off;
+    uint8_t write_sz;
+    uint8_t erased_val;
+    bool written;
+    bool prev_written;
+    bool chunk_empty;
+    int chunk_entries;
+    int entry;
+    int i;
+    int rc;
+
+    scan->first = -1;
+    scan->last = -1;
+    scan->first_gap = max_entries;
+    scan->gaps = 0;
+    scan->gap_status = 0;
+
+    write_sz = BOOT_WRITE_SZ(state);
+    erased_val = flash_area_erased_val(fap);
+    off = boot_status_off(fap);
+    buf = BOOT_BUF(state, 0);
+    prev_written = false;
+
+    for (entry = 0; entry < max_entries; entry += chunk_entries) {
+        chunk_entries = BOOT_BUF_SZ / write_sz;
+        if (chunk_entries > max_entries - entry) {
+            chunk_entries = max_entries - entry;
+        }
+
+        rc = flash_area_read_is_empty(fap, off + entry * write_sz,
+                                      BOOT_BUF(state, 0),
+                                      chunk_entries * write_sz);
+        if (rc < 0) {
+            return BOOT_EFLASH;
+        }
+        chunk_empty = (rc == 1);
+
+        for (i = 0; i < chunk_entries; i++) {
+            written = !chunk_empty && buf[i * write_sz] != erased_val;
+
+            if (written) {
+                if (scan->first < 0) {
+                    scan->first = entry + i;
+                } else if (!prev_written) {
+                    scan->gaps++;
+                }
+                if (scan->first_gap == max_entries) {
+                    scan->gap_status = buf[i * write_sz];
+                }
+                scan->last = entry + i;
+            } else if (prev_written && scan->first_gap == max_entries) {
+                scan->first_gap = entry + i;
+            }
+            prev_written = written;
+
+            if (chunk_empty) {
+                /* The rest of the chunk is erased as well. */
+                break;
+            }
+        }
+    }
+
+    return 0;
+}
+
 static inline uint32_t
 boot_magic_off(const struct flash_area *fap)
 {
@@ -244,63 +389,164 @@ boot_enc_key_off(const struct flash_area *fap, uint8_t slot)
 }
 #endif
 
+/*
+ * While the boot loader runs, decoded trailers are cached so that each one is
+ * only read from flash once, as long as it isn't modified: anything writing
+ * to or erasing a trailer must call boot_trailer_cache_invalidate().  The
+ * cache is only enabled by context_boot_go(), other users of this file, like
+ * applications marking images, always read the flash.
+ */
+#define BOOT_TRAILER_CACHE_ENTRIES  (BOOT_IMAGE_NUMBER * BOOT_NUM_SLOTS + 1)
+
+struct boot_trailer_cache_entry {
+    uint8_t valid;
+    uint8_t fa_id;
+    struct boot_swap_state state;
+};
+
+struct boot_trailer_cache {
+    bool enabled;
+    struct boot_trailer_cache_entry entries[BOOT_TRAILER_CACHE_ENTRIES];
+};
+
+#ifdef __BOOTSIM__
+/* The simulator runs one boot loader per thread. */
+static __thread struct boot_trailer_cache boot_trailer_cache;
+#else
+static struct boot_trailer_cache boot_trailer_cache;
+#endif
+
+/**
+ * Enables or disables the trailer cache; either way, its content is dropped.
+ */
+void
+boot_trailer_cache_enable(bool enable)
+{
+    memset(&boot_trailer_cache, 0, sizeof boot_trailer_cache);
+    boot_trailer_cache.enabled = enable;
+}
+
+/**
+ * Drops the cached trailer of a flash area, to be called after it is written
+ * to or erased.
+ */
+void
+boot_trailer_cache_invalidate(const struct flash_area *fap)
+{
+    size_t i;
+
+    for (i = 0; i < BOOT_TRAILER_CACHE_ENTRIES; i++) {
+        if (boot_trailer_cache.entries[i].fa_id == fap->fa_id) {
+            boot_trailer_cache.entries[i].valid = 0;
+        }
+    }
+}
+
+static struct boot_trailer_cache_entry *
+boot_trailer_cache_find(const struct flash_area *fap, bool *hit)
+{
+    struct boot_trailer_cache_entry *entry;
+    struct boot_trailer_cache_entry *free_entry;
+    size_t i;
+
+    *hit = false;
+    if (!boot_trailer_cache.enabled) {
+        return NULL;
+    }
+
+    free_entry = NULL;
+    for (i = 0; i < BOOT_TRAILER_CACHE_ENTRIES; i++) {
+        entry = &boot_trailer_cache.entries[i];
+        if (!entry->valid) {
+            if (free_entry == NULL) {
+                free_entry = entry;
+            }
+        } else if (entry->fa_id == fap->fa_id) {
+            *hit = true;
+            return entry;
+        }
+    }
+
+    return free_entry;
+}
+
+/**
+ * Reads and decodes the image trailer of a flash area.
+ *
+ * The swap_info, copy_done, image_ok and magic fields are adjacent at the
+ * end of the area, so they are fetched with a single read and decoded from
+ * RAM: a field is considered unset when all of its bytes hold the erased
+ * value of the flash.
+ */
 int
 boot_read_swap_state(const struct flash_area *fap,
                      struct boot_swap_state *state)
 {
-    uint32_t magic[BOOT_MAGIC_ARR_SZ];
+    uint32_t tail[(BOOT_MAX_ALIGN * 3 + BOOT_MAGIC_SZ) / sizeof(uint32_t)];
+    struct boot_trailer_cache_entry *entry;
+    const uint8_t *buf;
     uint32_t off;
+    uint8_t erased_val;
     uint8_t swap_info;
+    uint8_t flag;
+    bool empty;
+    bool hit;
     int rc;
 
-    off = boot_magic_off(fap);
-    rc = flash_area_read_is_empty(fap, off, magic, BOOT_MAGIC_SZ);
-    if (rc < 0) {
-        return BOOT_EFLASH;
-    }
-    if (rc == 1) {
-        state->magic = BOOT_MAGIC_UNSET;
-    } else {
-        state->magic = boot_magic_decode(magic);
+    entry = boot_trailer_cache_find(fap, &hit);
+    if (hit) {
+        *state = entry->state;
+        return 0;
     }
 
     off = boot_swap_info_off(fap);
-    rc = flash_area_read_is_empty(fap, off, &swap_info, sizeof swap_info);
+    assert(fap->fa_size - off == sizeof tail);
+    rc = flash_area_read_is_empty(fap, off, tail, sizeof tail);
     if (rc < 0) {
         return BOOT_EFLASH;
     }
+    empty = (rc == 1);
+    buf = (const uint8_t *)tail;
+    erased_val = flash_area_erased_val(fap);
+
+    if (empty ||
+        boot_buf_is_erased(fap, &buf[boot_magic_off(fap) - off],
+                           BOOT_MAGIC_SZ)) {
+        state->magic = BOOT_MAGIC_UNSET;
+    } else {
+        state->magic = boot_magic_decode(&tail[(boot_magic_off(fap) - off) /
+                                               sizeof(uint32_t)]);
+    }
 
     /* Extract the swap type and image number */
+    swap_info = buf[0];
     state->swap_type = BOOT_GET_SWAP_TYPE(swap_info);
     state->image_num = BOOT_GET_IMAGE_NUM(swap_info);
 
-    if (rc == 1 || state->swap_type > BOOT_SWAP_TYPE_REVERT) {
+    if (empty || swap_info == erased_val ||
+        state->swap_type > BOOT_SWAP_TYPE_REVERT) {
         state->swap_type = BOOT_SWAP_TYPE_NONE;
         state->image_num = 0;
     }
 
-    off = boot_copy_done_off(fap);
-    rc = flash_area_read_is_empty(fap, off, &state->copy_done,
-            sizeof state->copy_done);
-    if (rc < 0) {
-        return BOOT_EFLASH;
-    }
-    if (rc == 1) {
+    flag = buf[boot_copy_done_off(fap) - off];
+    if (empty || flag == erased_val) {
         state->copy_done = BOOT_FLAG_UNSET;
     } else {
-        state->copy_done = boot_flag_decode(state->copy_done);
+        state->copy_done = boot_flag_decode(flag);
     }
 
-    off = boot_image_ok_off(fap);
-    rc = flash_area_read_is_empty(fap, off, &state->image_ok,
-                                  sizeof state->image_ok);
-    if (rc < 0) {
-        return BOOT_EFLASH;
-    }
-    if (rc == 1) {
+    flag = buf[boot_image_ok_off(fap) - off];
+    if (empty || flag == erased_val) {
         state->image_ok = BOOT_FLAG_UNSET;
     } else {
-        state->image_ok = boot_flag_decode(state->image_ok);
+        state->image_ok = boot_flag_decode(flag);
+    }
+
+    if (entry != NULL) {
+        entry->valid = 1;
+        entry->fa_id = fap->fa_id;
+        entry->state = *state;
     }
 
     return 0;
@@ -445,6 +691,7 @@ boot_write_magic(const struct flash_area *fap)
     BOOT_LOG_DBG("writing magic; fa_id=%d off=0x%lx (0x%lx)",
                  fap->fa_id, (unsigned long)off,
                  (unsigned long)(fap->fa_off + off));
+    boot_trailer_cache_invalidate(fap);
     rc = flash_area_write(fap, off, boot_img_magic, BOOT_MAGIC_SZ);
     if (rc != 0) {
         return BOOT_EFLASH;
@@ -478,6 +725,7 @@ boot_write_trailer(const struct flash_area *fap, uint32_t off,
     memcpy(buf, inbuf, inlen);
     memset(&buf[inlen], erased_val, align - inlen);
 
+    boot_trailer_cache_invalidate(fap);
     rc = flash_area_write(fap, off, buf, align);
     if (rc != 0) {
         return BOOT_EFLASH;
@@ -701,6 +949,7 @@ boot_set_pending(int permanent)
             return BOOT_EFLASH;
         }
 
+        boot_trailer_cache_invalidate(fap);
         flash_area_erase(fap, 0, fap->fa_size);
         flash_area_close(fap);
         return BOOT_EBADIMAGE;
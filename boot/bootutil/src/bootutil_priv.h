@@ -30,6 +30,7 @@
 
 #include "bootutil/bootutil.h"
 #include "bootutil/image.h"
+#include "bootutil/sha256.h"
 #include "mcuboot_config/mcuboot_config.h"
 
 #ifdef MCUBOOT_ENC_IMAGES
@@ -57,7 +58,67 @@ struct flash_area;
 #define BOOT_EBADARGS    7
 #define BOOT_EBADVERSION 8
 
-#define BOOT_TMPBUF_SZ  256
+/*
+ * Size and alignment of the buffers shared by the image copy, hashing and
+ * status scanning code.  Platforms with large program pages or fast burst
+ * reads should make the size a multiple of the page size; DMA capable
+ * backends may need a larger alignment.
+ */
+#ifdef MCUBOOT_BUF_SZ
+#define BOOT_BUF_SZ     MCUBOOT_BUF_SZ
+#else
+#define BOOT_BUF_SZ     1024
+#endif
+
+#ifdef MCUBOOT_BUF_ALIGN
+#define BOOT_BUF_ALIGN  MCUBOOT_BUF_ALIGN
+#else
+#define BOOT_BUF_ALIGN  8
+#endif
+
+#if (BOOT_BUF_SZ % BOOT_BUF_ALIGN) != 0
+#error "MCUBOOT_BUF_SZ must be a multiple of MCUBOOT_BUF_ALIGN"
+#endif
+
+/* The status scan reads at least one entry per buffer, and the comparison
+ * of regions splits a buffer in two. */
+#if BOOT_BUF_SZ < (2 * BOOT_MAX_ALIGN)
+#error "MCUBOOT_BUF_SZ must be at least 2 * BOOT_MAX_ALIGN"
+#endif
+
+/*
+ * The union below gives the buffers the alignment of any scalar type, which
+ * covers the default of 8.  Ports asking for more must also provide
+ * MCUBOOT_BUF_ALIGN_ATTR, their compiler's spelling of that alignment.
+ */
+#if defined(MCUBOOT_SIG_VERIFY_TIMING) && !defined(MCUBOOT_CYCLE_COUNT)
+#error "MCUBOOT_SIG_VERIFY_TIMING requires MCUBOOT_CYCLE_COUNT()"
+#endif
+
+#ifndef MCUBOOT_BUF_ALIGN_ATTR
+#if BOOT_BUF_ALIGN > 8
+#error "MCUBOOT_BUF_ALIGN above 8 requires MCUBOOT_BUF_ALIGN_ATTR"
+#endif
+#define MCUBOOT_BUF_ALIGN_ATTR
+#endif
+
+union boot_buf {
+    uint8_t bytes[BOOT_BUF_SZ];
+    uint64_t align_u64;
+    double align_double;
+    void *align_ptr;
+};
+
+/*
+ * Number of buffers in the pool; asynchronous flash backends get a second
+ * one so that reading the next chunk of a copy overlaps programming the
+ * previous one.
+ */
+#ifdef MCUBOOT_USE_FLASH_ASYNC
+#define BOOT_BUF_COUNT  2
+#else
+#define BOOT_BUF_COUNT  1
+#endif
 
 /** Number of image slots in flash; currently limited to two. */
 #define BOOT_NUM_SLOTS                  2
@@ -82,6 +143,9 @@ struct boot_status {
     uint8_t op;           /* What operation are we performing? */
     uint8_t use_scratch;  /* Are status bytes ever written to scratch? */
     uint8_t swap_type;    /* The type of swap in effect */
+#ifdef MCUBOOT_SWAP_SKIP_IDENTICAL
+    uint8_t skipped;      /* Is the current area identical in both slots? */
+#endif
     uint32_t swap_size;   /* Total size of swapped image */
 #ifdef MCUBOOT_ENC_IMAGES
     uint8_t enckey[BOOT_NUM_SLOTS][BOOT_ENC_KEY_SIZE];
@@ -112,6 +176,12 @@ struct boot_status {
 #define BOOT_STATUS_STATE_1 2
 #define BOOT_STATUS_STATE_2 3
 
+/*
+ * Added to the state written in a status entry when the area was skipped
+ * because it held the same data in both slots.
+ */
+#define BOOT_STATUS_SKIPPED 0x80
+
 /**
  * End-of-image slot structure.
  *
@@ -154,6 +224,19 @@ struct boot_swap_state {
     uint8_t image_num;  /* Boot status belongs to this image */
 };
 
+/**
+ * Summary of which entries of a status area were written, as gathered by
+ * boot_scan_status().
+ */
+struct boot_status_scan {
+    int first;          /* First written entry, -1 if none. */
+    int last;           /* Last written entry, -1 if none. */
+    int first_gap;      /* First erased entry after `first`, or the number
+                           of entries if there is none. */
+    int gaps;           /* Number of erased runs between written entries. */
+    uint8_t gap_status; /* Status byte of the entry preceding `first_gap`. */
+};
+
 #ifdef MCUBOOT_IMAGE_NUMBER
 #define BOOT_IMAGE_NUMBER          MCUBOOT_IMAGE_NUMBER
 #else
@@ -210,6 +293,57 @@ _Static_assert(BOOT_IMAGE_NUMBER > 0, "Invalid value for BOOT_IMAGE_NUMBER");
 
 #define BOOT_MAGIC_SZ (sizeof boot_img_magic)
 
+#ifdef MCUBOOT_VALIDATED_RECORD
+#ifndef MCUBOOT_VALIDATE_PRIMARY_SLOT
+#error "MCUBOOT_VALIDATED_RECORD requires MCUBOOT_VALIDATE_PRIMARY_SLOT"
+#endif
+/* HMAC-SHA256 proving that the image in the primary slot was validated. */
+#define BOOT_VALIDATED_RECORD_SZ        32
+#endif
+
+/*
+ * With MCUBOOT_UNIFORM_SECTOR_SIZE, every image slot and the scratch area are
+ * made of sectors of that size.  The layout is then known at build time: no
+ * sector arrays are read from the flash map, and the sector accessors below
+ * are plain arithmetic.
+ */
+#ifdef MCUBOOT_UNIFORM_SECTOR_SIZE
+#if (MCUBOOT_UNIFORM_SECTOR_SIZE) <= 0
+#error "MCUBOOT_UNIFORM_SECTOR_SIZE must be a positive sector size"
+#endif
+#endif
+
+/*
+ * With MCUBOOT_MAX_SECTOR_RUNS, the sector layout of each area is kept as
+ * runs of consecutive sectors of equal size, up to that many runs per area,
+ * instead of one entry per sector.  This makes the layout of large slots
+ * made of small sectors take a few bytes instead of a few kilobytes.
+ */
+#ifdef MCUBOOT_MAX_SECTOR_RUNS
+#ifdef MCUBOOT_UNIFORM_SECTOR_SIZE
+#error "MCUBOOT_MAX_SECTOR_RUNS and MCUBOOT_UNIFORM_SECTOR_SIZE are exclusive"
+#endif
+#ifndef MCUBOOT_USE_FLASH_AREA_GET_SECTORS
+#error "MCUBOOT_MAX_SECTOR_RUNS requires MCUBOOT_USE_FLASH_AREA_GET_SECTORS"
+#endif
+#define BOOT_MAX_SECTOR_RUNS MCUBOOT_MAX_SECTOR_RUNS
+
+struct boot_sector_run {
+    uint32_t size;      /* Size of each sector of the run. */
+    uint16_t count;     /* Number of sectors in the run. */
+};
+
+struct boot_sector_map {
+    struct boot_sector_run runs[BOOT_MAX_SECTOR_RUNS];
+    uint8_t num_runs;
+};
+#endif
+
+#if !defined(MCUBOOT_UNIFORM_SECTOR_SIZE) && !defined(MCUBOOT_MAX_SECTOR_RUNS)
+/* The sector layouts are read into arrays with one entry per sector. */
+#define BOOT_SECTOR_ARRAYS 1
+#endif
+
 /**
  * Compatibility shim for flash sector type.
  *
@@ -221,19 +355,68 @@ typedef struct flash_sector boot_sector_t;
 typedef struct flash_area boot_sector_t;
 #endif
 
+#ifdef MCUBOOT_HASH_ON_COPY
+#define BOOT_COPY_HASH_IDLE     0
+#define BOOT_COPY_HASH_RUNNING  1
+#define BOOT_COPY_HASH_DONE     2
+
+/*
+ * Hash of an image computed while it is copied into the primary slot, so
+ * that validating the primary slot after the upgrade doesn't read it back.
+ * Any write to the hashed range that is not the next one in order makes the
+ * hash unusable; it is only kept in RAM, so an upgrade resumed after a reset
+ * is always validated by re-reading the slot.
+ */
+struct boot_copy_hash {
+    bootutil_img_hash_context hash_ctx;
+    uint32_t off;           /* Offset of the next byte to hash. */
+    uint32_t size;          /* Size of the hashed part of the image. */
+    uint8_t hash[BOOTUTIL_IMG_HASH_SIZE];
+    uint8_t state;          /* One of BOOT_COPY_HASH_... */
+};
+#endif
+
+#ifdef MCUBOOT_BATCH_VERIFY
+#ifndef MCUBOOT_SIGN_ED25519
+#error "MCUBOOT_BATCH_VERIFY requires MCUBOOT_SIGN_ED25519"
+#endif
+
+/*
+ * Image signatures collected while validating the primary slots, and then
+ * verified all at once.
+ */
+struct bootutil_sig_batch {
+    struct {
+        uint8_t hash[BOOTUTIL_IMG_HASH_SIZE];
+        uint8_t sig[64];
+        uint8_t key_id;
+        uint8_t image_index;
+    } sigs[BOOT_IMAGE_NUMBER];
+    uint8_t count;
+};
+#endif
+
 /** Private state maintained during boot. */
 struct boot_loader_state {
     struct {
         struct image_header hdr;
         const struct flash_area *area;
+#if defined(MCUBOOT_MAX_SECTOR_RUNS)
+        struct boot_sector_map map;
+#elif defined(BOOT_SECTOR_ARRAYS)
         boot_sector_t *sectors;
+#endif
         size_t num_sectors;
     } imgs[BOOT_IMAGE_NUMBER][BOOT_NUM_SLOTS];
 
 #if MCUBOOT_SWAP_USING_SCRATCH
     struct {
         const struct flash_area *area;
+#if defined(MCUBOOT_MAX_SECTOR_RUNS)
+        struct boot_sector_map map;
+#elif defined(BOOT_SECTOR_ARRAYS)
         boot_sector_t *sectors;
+#endif
         size_t num_sectors;
     } scratch;
 #endif
@@ -248,17 +431,59 @@ struct boot_loader_state {
 #if (BOOT_IMAGE_NUMBER > 1)
     uint8_t curr_img_idx;
 #endif
+
+#ifdef MCUBOOT_HASH_ON_COPY
+    struct boot_copy_hash copy_hash[BOOT_IMAGE_NUMBER];
+#endif
+
+#ifdef MCUBOOT_BATCH_VERIFY
+    /* If set, image signatures are added to it instead of verified. */
+    struct bootutil_sig_batch *sig_batch;
+#endif
+
+    /*
+     * Buffer pool, the users never run concurrently: copies, image hashing
+     * and status scans all borrow from here.
+     */
+    union boot_buf bufs[BOOT_BUF_COUNT] MCUBOOT_BUF_ALIGN_ATTR;
 };
 
 int bootutil_verify_sig(uint8_t *hash, uint32_t hlen, uint8_t *sig,
                         size_t slen, uint8_t key_id);
 
+#ifdef MCUBOOT_BATCH_VERIFY
+int bootutil_img_hash(struct enc_key_data *enc_state, int image_index,
+                      struct image_header *hdr, const struct flash_area *fap,
+                      uint8_t *tmp_buf, uint32_t tmp_buf_sz,
+                      uint8_t *hash_result, uint8_t *seed, int seed_len);
+int bootutil_img_validate_hash_batch(int image_index,
+                                     struct image_header *hdr,
+                                     const struct flash_area *fap,
+                                     uint8_t *hash,
+                                     struct bootutil_sig_batch *batch);
+int bootutil_verify_sig_batch(struct bootutil_sig_batch *batch);
+#endif
+
 int boot_magic_compatible_check(uint8_t tbl_val, uint8_t val);
+bool boot_buf_is_erased(const struct flash_area *fap, const void *buf,
+                        size_t len);
 uint32_t boot_status_sz(uint32_t min_write_sz);
 uint32_t boot_trailer_sz(uint32_t min_write_sz);
 int boot_status_entries(int image_index, const struct flash_area *fap);
 uint32_t boot_status_off(const struct flash_area *fap);
+int boot_scan_status(struct boot_loader_state *state,
+                     const struct flash_area *fap, int max_entries,
+                     struct boot_status_scan *scan);
 uint32_t boot_swap_info_off(const struct flash_area *fap);
+#ifdef MCUBOOT_VALIDATED_RECORD
+uint32_t boot_validated_record_off(const struct flash_area *fap);
+int boot_validated_record_check(uint8_t image_index, struct image_header *hdr,
+                                const struct flash_area *fap);
+int boot_validated_record_write(uint8_t image_index, struct image_header *hdr,
+                                const struct flash_area *fap);
+#endif
+void boot_trailer_cache_enable(bool enable);
+void boot_trailer_cache_invalidate(const struct flash_area *fap);
 int boot_read_swap_state(const struct flash_area *fap,
                          struct boot_swap_state *state);
 int boot_read_swap_state_by_id(int flash_area_id,
@@ -280,6 +505,33 @@ int boot_copy_region(struct boot_loader_state *state,
                      const struct flash_area *fap_dst,
                      uint32_t off_src, uint32_t off_dst, uint32_t sz);
 int boot_erase_region(const struct flash_area *fap, uint32_t off, uint32_t sz);
+#ifdef MCUBOOT_HASH_ON_COPY
+void boot_copy_hash_start(struct boot_loader_state *state);
+#endif
+int boot_erase_sectors(const struct boot_loader_state *state,
+                       const struct flash_area *fap, size_t slot,
+                       size_t first_sector, size_t last_sector);
+#ifdef MCUBOOT_SWAP_SKIP_IDENTICAL
+bool boot_region_identical(struct boot_loader_state *state,
+                           const struct flash_area *fap_a, uint32_t off_a,
+                           const struct flash_area *fap_b, uint32_t off_b,
+                           uint32_t sz);
+#else
+static inline bool
+boot_region_identical(struct boot_loader_state *state,
+                      const struct flash_area *fap_a, uint32_t off_a,
+                      const struct flash_area *fap_b, uint32_t off_b,
+                      uint32_t sz)
+{
+    (void)state;
+    (void)fap_a;
+    (void)off_a;
+    (void)fap_b;
+    (void)off_b;
+    (void)sz;
+    return false;
+}
+#endif
 bool boot_status_is_reset(const struct boot_status *bs);
 
 #ifdef MCUBOOT_ENC_IMAGES
@@ -341,7 +593,9 @@ static inline bool boot_u16_safe_add(uint16_t *dest, uint16_t a, uint16_t b)
 #define BOOT_IMG(state, slot) ((state)->imgs[BOOT_CURR_IMG(state)][(slot)])
 #define BOOT_IMG_AREA(state, slot) (BOOT_IMG(state, slot).area)
 #define BOOT_WRITE_SZ(state) ((state)->write_sz)
+#define BOOT_BUF(state, n) ((state)->bufs[(n)].bytes)
 #define BOOT_SWAP_TYPE(state) ((state)->swap_type[BOOT_CURR_IMG(state)])
+#define BOOT_COPY_HASH(state) ((state)->copy_hash[BOOT_CURR_IMG(state)])
 #define BOOT_TLV_OFF(hdr) ((hdr)->ih_hdr_size + (hdr)->ih_img_size)
 
 #define BOOT_IS_UPGRADE(swap_type)             \
@@ -370,7 +624,69 @@ boot_img_slot_off(struct boot_loader_state *state, size_t slot)
     return BOOT_IMG(state, slot).area->fa_off;
 }
 
-#ifndef MCUBOOT_USE_FLASH_AREA_GET_SECTORS
+#if defined(MCUBOOT_UNIFORM_SECTOR_SIZE)
+
+static inline size_t
+boot_img_sector_size(const struct boot_loader_state *state,
+                     size_t slot, size_t sector)
+{
+    (void)state;
+    (void)slot;
+    (void)sector;
+    return MCUBOOT_UNIFORM_SECTOR_SIZE;
+}
+
+static inline uint32_t
+boot_img_sector_off(const struct boot_loader_state *state, size_t slot,
+                    size_t sector)
+{
+    (void)state;
+    (void)slot;
+    return (uint32_t)sector * MCUBOOT_UNIFORM_SECTOR_SIZE;
+}
+
+#elif defined(MCUBOOT_MAX_SECTOR_RUNS)
+
+static inline size_t
+boot_img_sector_size(const struct boot_loader_state *state,
+                     size_t slot, size_t sector)
+{
+    const struct boot_sector_map *map;
+    size_t i;
+
+    map = &BOOT_IMG(state, slot).map;
+    for (i = 0; i < map->num_runs; i++) {
+        if (sector < map->runs[i].count) {
+            return map->runs[i].size;
+        }
+        sector -= map->runs[i].count;
+    }
+
+    return 0;
+}
+
+static inline uint32_t
+boot_img_sector_off(const struct boot_loader_state *state, size_t slot,
+                    size_t sector)
+{
+    const struct boot_sector_map *map;
+    uint32_t off;
+    size_t i;
+
+    map = &BOOT_IMG(state, slot).map;
+    off = 0;
+    for (i = 0; i < map->num_runs; i++) {
+        if (sector < map->runs[i].count) {
+            break;
+        }
+        off += map->runs[i].count * map->runs[i].size;
+        sector -= map->runs[i].count;
+    }
+
+    return off + sector * (i < map->num_runs ? map->runs[i].size : 0);
+}
+
+#elif !defined(MCUBOOT_USE_FLASH_AREA_GET_SECTORS)
 
 static inline size_t
 boot_img_sector_size(const struct boot_loader_state *state,
@@ -408,7 +724,92 @@ boot_img_sector_off(const struct boot_loader_state *state, size_t slot,
            BOOT_IMG(state, slot).sectors[0].fs_off;
 }
 
-#endif  /* !defined(MCUBOOT_USE_FLASH_AREA_GET_SECTORS) */
+#endif  /* defined(MCUBOOT_UNIFORM_SECTOR_SIZE) */
+
+/*
+ * Iterator over the sectors of an image slot, for code walking them in
+ * order: with run-length sector maps, stepping to a neighbouring sector is
+ * cheaper than looking it up by index.  It must start on an existing sector
+ * and may be stepped one past the last sector, its size then stays the one
+ * of the last sector.
+ */
+struct boot_sector_iter {
+    size_t sector;          /* Index of the current sector. */
+    uint32_t off;           /* Its offset from the beginning of the slot. */
+    uint32_t size;          /* Its size. */
+    size_t num_sectors;
+#if defined(MCUBOOT_MAX_SECTOR_RUNS)
+    const struct boot_sector_map *map;
+    uint8_t run;
+    uint16_t in_run;
+#else
+    const struct boot_loader_state *state;
+    size_t slot;
+#endif
+};
+
+static inline void
+boot_sector_iter_init(struct boot_sector_iter *it,
+                      const struct boot_loader_state *state, size_t slot,
+                      size_t sector)
+{
+    it->sector = sector;
+    it->num_sectors = boot_img_num_sectors(state, slot);
+    it->off = boot_img_sector_off(state, slot, sector);
+    it->size = boot_img_sector_size(state, slot, sector);
+#if defined(MCUBOOT_MAX_SECTOR_RUNS)
+    it->map = &BOOT_IMG(state, slot).map;
+    it->run = 0;
+    it->in_run = sector;
+    while (it->run + 1 < it->map->num_runs &&
+           it->in_run >= it->map->runs[it->run].count) {
+        it->in_run -= it->map->runs[it->run].count;
+        it->run++;
+    }
+#else
+    it->state = state;
+    it->slot = slot;
+#endif
+}
+
+static inline void
+boot_sector_iter_next(struct boot_sector_iter *it)
+{
+    it->off += it->size;
+    it->sector++;
+    if (it->sector >= it->num_sectors) {
+        return;
+    }
+#if defined(MCUBOOT_MAX_SECTOR_RUNS)
+    it->in_run++;
+    if (it->in_run == it->map->runs[it->run].count) {
+        it->run++;
+        it->in_run = 0;
+        it->size = it->map->runs[it->run].size;
+    }
+#else
+    it->size = boot_img_sector_size(it->state, it->slot, it->sector);
+#endif
+}
+
+static inline void
+boot_sector_iter_prev(struct boot_sector_iter *it)
+{
+    it->sector--;
+#if defined(MCUBOOT_MAX_SECTOR_RUNS)
+    if (it->sector + 1 < it->num_sectors) {
+        if (it->in_run == 0) {
+            it->run--;
+            it->in_run = it->map->runs[it->run].count;
+        }
+        it->in_run--;
+    }
+    it->size = it->map->runs[it->run].size;
+#else
+    it->size = boot_img_sector_size(it->state, it->slot, it->sector);
+#endif
+    it->off -= it->size;
+}
 
 #ifdef __cplusplus
 }
@@ -54,12 +54,33 @@ uint32_t bootutil_get_caps(void)
 #if defined(MCUBOOT_ENCRYPT_EC256)
     res |= BOOTUTIL_CAP_ENC_EC256;
 #endif
+#if defined(MCUBOOT_ENCRYPT_X25519)
+    res |= BOOTUTIL_CAP_ENC_X25519;
+#endif
+#if defined(MCUBOOT_AES_256)
+    res |= BOOTUTIL_CAP_AES256;
+#endif
 #if defined(MCUBOOT_VALIDATE_PRIMARY_SLOT)
     res |= BOOTUTIL_CAP_VALIDATE_PRIMARY_SLOT;
 #endif
 #if defined(MCUBOOT_DOWNGRADE_PREVENTION)
     res |= BOOTUTIL_CAP_DOWNGRADE_PREVENTION;
 #endif
+#if defined(MCUBOOT_HASH_CHUNKS)
+    res |= BOOTUTIL_CAP_HASH_CHUNKS;
+#endif
+#if defined(MCUBOOT_SHA384)
+    res |= BOOTUTIL_CAP_SHA384;
+#endif
+#if defined(MCUBOOT_SHA512)
+    res |= BOOTUTIL_CAP_SHA512;
+#endif
+#if defined(MCUBOOT_VALIDATED_RECORD)
+    res |= BOOTUTIL_CAP_VALIDATED_RECORD;
+#endif
+#if defined(MCUBOOT_UNIFORM_SECTOR_SIZE)
+    res |= BOOTUTIL_CAP_UNIFORM_SECTOR_SIZE;
+#endif
 
     return res;
 }
@@ -44,10 +44,23 @@
 #endif
 
 #if defined(MCUBOOT_ENCRYPT_EC256)
-#include "tinycrypt/utils.h"
-#include "tinycrypt/constants.h"
 #include "tinycrypt/ecc.h"
 #include "tinycrypt/ecc_dh.h"
+#define SHARED_KEY_LEN NUM_ECC_BYTES
+#define PRIV_KEY_LEN   NUM_ECC_BYTES
+#endif
+
+#if defined(MCUBOOT_ENCRYPT_X25519)
+#define SHARED_KEY_LEN 32
+#define PRIV_KEY_LEN   32
+
+extern int X25519(uint8_t out_shared_key[32], const uint8_t private_key[32],
+                  const uint8_t peer_public_value[32]);
+#endif
+
+#if defined(MCUBOOT_ENCRYPT_EC256) || defined(MCUBOOT_ENCRYPT_X25519)
+#include "tinycrypt/utils.h"
+#include "tinycrypt/constants.h"
 #include "tinycrypt/ctr_mode.h"
 #include "tinycrypt/hmac.h"
 #include "mbedtls/oid.h"
@@ -275,7 +288,67 @@ parse_ec256_enckey(uint8_t **p, uint8_t *end, uint8_t *pk)
 
     return 0;
 }
+#endif /* MCUBOOT_ENCRYPT_EC256 */
+
+#if defined(MCUBOOT_ENCRYPT_X25519)
+static const uint8_t x25519_pubkey_oid[] = MBEDTLS_OID_ISO_IDENTIFIED_ORG "\x65\x6e";
+
+/*
+ * Parses the output of `imgtool keygen`, which produces a PKCS#8 X25519
+ * private key. See RFC5208 and RFC8410.
+ */
+static int
+parse_x25519_enckey(uint8_t **p, uint8_t *end, uint8_t *pk)
+{
+    size_t len;
+    int version;
+    mbedtls_asn1_buf alg;
+    mbedtls_asn1_buf param;
+
+    if (mbedtls_asn1_get_tag(p, end, &len,
+                MBEDTLS_ASN1_CONSTRUCTED | MBEDTLS_ASN1_SEQUENCE) != 0) {
+        return -1;
+    }
+
+    if (*p + len != end) {
+        return -2;
+    }
+
+    version = 0;
+    if (mbedtls_asn1_get_int(p, end, &version) || version != 0) {
+        return -3;
+    }
+
+    if (mbedtls_asn1_get_alg(p, end, &alg, &param) != 0) {
+        return -4;
+    }
+
+    if (alg.len != sizeof(x25519_pubkey_oid) - 1 ||
+        memcmp(alg.p, x25519_pubkey_oid, sizeof(x25519_pubkey_oid) - 1)) {
+        return -5;
+    }
+
+    if (mbedtls_asn1_get_tag(p, end, &len, MBEDTLS_ASN1_OCTET_STRING) != 0) {
+        return -6;
+    }
+
+    /* RFC8410 - CurvePrivateKey */
+
+    if (mbedtls_asn1_get_tag(p, end, &len, MBEDTLS_ASN1_OCTET_STRING) != 0) {
+        return -7;
+    }
+
+    if (len != PRIV_KEY_LEN) {
+        return -8;
+    }
+
+    memcpy(pk, *p, PRIV_KEY_LEN);
+
+    return 0;
+}
+#endif /* MCUBOOT_ENCRYPT_X25519 */
 
+#if defined(MCUBOOT_ENCRYPT_EC256) || defined(MCUBOOT_ENCRYPT_X25519)
 /*
  * HKDF as described by RFC5869.
  *
@@ -388,23 +461,13 @@ int
 boot_enc_set_key(struct enc_key_data *enc_state, uint8_t slot,
         const struct boot_status *bs)
 {
-    int rc;
-
-#if defined(MCUBOOT_USE_MBED_TLS)
-    mbedtls_aes_init(&enc_state[slot].aes);
-    rc = mbedtls_aes_setkey_enc(&enc_state[slot].aes, bs->enckey[slot],
-            BOOT_ENC_KEY_SIZE_BITS);
-    if (rc) {
-        mbedtls_aes_free(&enc_state[slot].aes);
+    bootutil_aes_ctr_init(&enc_state[slot].aes_ctr);
+    if (bootutil_aes_ctr_set_key(&enc_state[slot].aes_ctr, bs->enckey[slot])) {
+        bootutil_aes_ctr_drop(&enc_state[slot].aes_ctr);
         return -1;
     }
-#else
-    (void)rc;
-
-    /* set_encrypt and set_decrypt do the same thing in tinycrypt */
-    tc_aes128_set_encrypt_key(&enc_state[slot].aes, bs->enckey[slot]);
-#endif
 
+    memcpy(enc_state[slot].key, bs->enckey[slot], BOOT_ENC_KEY_SIZE);
     enc_state[slot].valid = 1;
 
     return 0;
@@ -423,13 +486,20 @@ boot_enc_set_key(struct enc_key_data *enc_state, uint8_t slot,
 #    define EC_CIPHERKEY_INDEX  (65 + 32)
 _Static_assert(EC_CIPHERKEY_INDEX + 16 == EXPECTED_ENC_LEN,
         "Please fix ECIES-P256 component indexes");
+#elif defined(MCUBOOT_ENCRYPT_X25519)
+#    define EXPECTED_ENC_TLV    IMAGE_TLV_ENC_X25519
+#    define EC_PUBK_INDEX       (0)
+#    define EC_TAG_INDEX        (32)
+#    define EC_CIPHERKEY_INDEX  (32 + 32)
+_Static_assert(EC_CIPHERKEY_INDEX + 16 == EXPECTED_ENC_LEN,
+        "Please fix ECIES-X25519 component indexes");
 #endif
 
 /*
  * Decrypt an encryption key TLV.
  *
  * @param buf An encryption TLV read from flash (build time fixed length)
- * @param enckey An AES-128 key sized buffer to store to plain key.
+ * @param enckey A BOOT_ENC_KEY_SIZE buffer to store to plain key.
  */
 int
 boot_enc_decrypt(const uint8_t *buf, uint8_t *enckey)
@@ -440,15 +510,15 @@ boot_enc_decrypt(const uint8_t *buf, uint8_t *enckey)
     uint8_t *cpend;
     size_t olen;
 #endif
-#if defined(MCUBOOT_ENCRYPT_EC256)
+#if defined(MCUBOOT_ENCRYPT_EC256) || defined(MCUBOOT_ENCRYPT_X25519)
     struct tc_hmac_state_struct hmac;
     struct tc_aes_key_sched_struct aes;
     uint8_t tag[TC_SHA256_DIGEST_SIZE];
-    uint8_t shared[NUM_ECC_BYTES];
+    uint8_t shared[SHARED_KEY_LEN];
     uint8_t derived_key[TC_AES_KEY_SIZE + TC_SHA256_DIGEST_SIZE];
     uint8_t *cp;
     uint8_t *cpend;
-    uint8_t pk[NUM_ECC_BYTES];
+    uint8_t pk[PRIV_KEY_LEN];
     uint8_t counter[TC_AES_BLOCK_SIZE];
     uint16_t len;
 #endif
@@ -471,16 +541,23 @@ boot_enc_decrypt(const uint8_t *buf, uint8_t *enckey)
             NULL, 0, &olen, buf, enckey, BOOT_ENC_KEY_SIZE);
     mbedtls_rsa_free(&rsa);
 
+    /* A shorter key, encrypted for another AES key size, is not usable. */
+    if (rc == 0 && olen != BOOT_ENC_KEY_SIZE) {
+        rc = -1;
+    }
+
 #elif defined(MCUBOOT_ENCRYPT_KW)
 
-    assert(*bootutil_enc_key.len == 16);
+    /* The key-encryption key has the size of the image keys. */
+    assert(*bootutil_enc_key.len == BOOT_ENC_KEY_SIZE);
     rc = key_unwrap(buf, enckey);
 
-#elif defined(MCUBOOT_ENCRYPT_EC256)
+#elif defined(MCUBOOT_ENCRYPT_EC256) || defined(MCUBOOT_ENCRYPT_X25519)
 
     cp = (uint8_t *)bootutil_enc_key.key;
     cpend = cp + *bootutil_enc_key.len;
 
+#if defined(MCUBOOT_ENCRYPT_EC256)
     /*
      * Load the stored EC256 decryption private key
      */
@@ -507,13 +584,32 @@ boot_enc_decrypt(const uint8_t *buf, uint8_t *enckey)
     if (rc != TC_CRYPTO_SUCCESS) {
         return -1;
     }
+#else
+    /*
+     * Load the stored X25519 decryption private key
+     */
+
+    rc = parse_x25519_enckey(&cp, cpend, pk);
+    if (rc) {
+        return rc;
+    }
+
+    /*
+     * First "element" in the TLV is the ephemeral public key; the result is
+     * all zeros, and rejected, for points of small order.
+     */
+    rc = X25519(shared, pk, &buf[EC_PUBK_INDEX]);
+    if (!rc) {
+        return -1;
+    }
+#endif
 
     /*
      * Expand shared secret to create keys for AES-128-CTR + HMAC-SHA256
      */
 
     len = TC_AES_KEY_SIZE + TC_SHA256_DIGEST_SIZE;
-    rc = hkdf(shared, NUM_ECC_BYTES, (uint8_t *)"MCUBoot_ECIES_v1", 16,
+    rc = hkdf(shared, SHARED_KEY_LEN, (uint8_t *)"MCUBoot_ECIES_v1", 16,
             derived_key, &len);
     if (rc != 0 || len != (TC_AES_KEY_SIZE + TC_SHA256_DIGEST_SIZE)) {
         return -1;
@@ -596,11 +692,6 @@ boot_enc_load(struct enc_key_data *enc_state, int image_index,
     }
     slot = rc;
 
-    /* Already loaded... */
-    if (enc_state[slot].valid) {
-        return 1;
-    }
-
     rc = bootutil_tlv_iter_begin(&it, hdr, fap, EXPECTED_ENC_TLV, false);
     if (rc) {
         return -1;
@@ -625,6 +716,15 @@ boot_enc_load(struct enc_key_data *enc_state, int image_index,
         return -1;
     }
 
+    /*
+     * Already loaded, as keys are kept for the whole boot.  The swap status
+     * still gets the TLV read above, or the plain key.
+     */
+    if (enc_state[slot].valid) {
+        memcpy(bs->enckey[slot], enc_state[slot].key, BOOT_ENC_KEY_SIZE);
+        return 1;
+    }
+
     return boot_enc_decrypt(buf, bs->enckey[slot]);
 }
 
@@ -644,18 +744,26 @@ boot_enc_valid(struct enc_key_data *enc_state, int image_index,
     return enc_state[rc].valid;
 }
 
+/*
+ * Encrypts or decrypts `sz` bytes of `buf` in AES-CTR mode, `off` being the
+ * offset of the data within the payload and `blk_off` its offset within the
+ * 16 bytes block it starts in.
+ *
+ * The counter block is the big endian index of that block in the payload,
+ * incremented as a whole 128-bit number, as CTR engines do, so any length of
+ * data is handled from this single counter value, whatever the key size.
+ */
 void
 boot_encrypt(struct enc_key_data *enc_state, int image_index,
         const struct flash_area *fap, uint32_t off, uint32_t sz,
         uint32_t blk_off, uint8_t *buf)
 {
     struct enc_key_data *enc;
-    uint32_t i, j;
-    uint8_t u8;
     uint8_t nonce[16];
-    uint8_t blk[16];
     int rc;
 
+    assert(blk_off < 16);
+
     memset(nonce, 0, 12);
     off >>= 4;
     nonce[12] = (uint8_t)(off >> 24);
@@ -671,25 +779,7 @@ boot_encrypt(struct enc_key_data *enc_state, int image_index,
 
     enc = &enc_state[rc];
     assert(enc->valid == 1);
-    for (i = 0; i < sz; i++) {
-        if (i == 0 || blk_off == 0) {
-#if defined(MCUBOOT_USE_MBED_TLS)
-            mbedtls_aes_crypt_ecb(&enc->aes, MBEDTLS_AES_ENCRYPT, nonce, blk);
-#else
-            tc_aes_encrypt(blk, nonce, &enc->aes);
-#endif
-
-            for (j = 16; j > 0; --j) {
-                if (++nonce[j - 1] != 0) {
-                    break;
-                }
-            }
-        }
-
-        u8 = *buf;
-        *buf++ = u8 ^ blk[blk_off];
-        blk_off = (blk_off + 1) & 0x0f;
-    }
+    bootutil_aes_ctr_encrypt(&enc->aes_ctr, nonce, blk_off, buf, sz);
 }
 
 /**
@@ -698,6 +788,13 @@ boot_encrypt(struct enc_key_data *enc_state, int image_index,
 void
 boot_enc_zeroize(struct enc_key_data *enc_state)
 {
+    uint8_t slot;
+
+    for (slot = 0; slot < BOOT_NUM_SLOTS; slot++) {
+        if (enc_state[slot].valid) {
+            bootutil_aes_ctr_drop(&enc_state[slot].aes_ctr);
+        }
+    }
     memset(enc_state, 0, sizeof(struct enc_key_data) * BOOT_NUM_SLOTS);
 }
 
@@ -169,9 +169,10 @@ bootutil_verify_sig(uint8_t *hash, uint32_t hlen, uint8_t *sig, size_t slen,
     }
 
     /*
-     * This is simplified, as the hash length is also 32 bytes.
+     * Longer image hashes (SHA384, SHA512) are truncated to the size of
+     * the curve order, as in FIPS 186-4.
      */
-    if (hlen != NUM_ECC_BYTES) {
+    if (hlen < NUM_ECC_BYTES) {
         return -1;
     }
 
@@ -211,14 +212,15 @@ bootutil_verify_sig(uint8_t *hash,
     }
 
     /*
-     * This is simplified, as the hash length is also 32 bytes.
+     * Longer image hashes (SHA384, SHA512) are truncated to the size of
+     * the curve order, as in FIPS 186-4.
      */
-    if (hlen != NUM_ECC_BYTES) {
+    if (hlen < NUM_ECC_BYTES) {
         return -1;
     }
 
     /* Initialize and verify in one go */
-    rc = cc310_ecdsa_verify_secp256r1(hash, pubkey, signature, hlen);
+    rc = cc310_ecdsa_verify_secp256r1(hash, pubkey, signature, NUM_ECC_BYTES);
 
     if (rc != 0) {
         return -2;
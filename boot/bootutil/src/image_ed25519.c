@@ -35,6 +35,13 @@ static const uint8_t ed25519_pubkey_oid[] = MBEDTLS_OID_ISO_IDENTIFIED_ORG "\x65
 extern int ED25519_verify(const uint8_t *message, size_t message_len,
                           const uint8_t signature[64],
                           const uint8_t public_key[32]);
+#ifdef MCUBOOT_BATCH_VERIFY
+extern int ED25519_verify_batch(size_t count,
+                                const uint8_t *const *messages,
+                                size_t message_len,
+                                const uint8_t *const *signatures,
+                                const uint8_t *const *public_keys);
+#endif
 
 /*
  * Parse the public key used for signing.
@@ -83,7 +90,7 @@ bootutil_verify_sig(uint8_t *hash, uint32_t hlen, uint8_t *sig, size_t slen,
     uint8_t *pubkey;
     uint8_t *end;
 
-    if (hlen != 32 || slen != 64) {
+    if (hlen != BOOTUTIL_IMG_HASH_SIZE || slen != 64) {
         return -1;
     }
 
@@ -95,7 +102,7 @@ bootutil_verify_sig(uint8_t *hash, uint32_t hlen, uint8_t *sig, size_t slen,
         return -1;
     }
 
-    rc = ED25519_verify(hash, 32, sig, pubkey);
+    rc = ED25519_verify(hash, hlen, sig, pubkey);
     if (rc == 0) {
         return -2;
     }
@@ -103,4 +110,49 @@ bootutil_verify_sig(uint8_t *hash, uint32_t hlen, uint8_t *sig, size_t slen,
     return 0;
 }
 
+#ifdef MCUBOOT_BATCH_VERIFY
+/*
+ * Verify all of the signatures in the batch at once.  Returns 0 only if
+ * every signature is valid; use bootutil_verify_sig() to find out which
+ * one is not.
+ */
+int
+bootutil_verify_sig_batch(struct bootutil_sig_batch *batch)
+{
+    const uint8_t *hashes[BOOT_IMAGE_NUMBER];
+    const uint8_t *sigs[BOOT_IMAGE_NUMBER];
+    const uint8_t *pubkeys[BOOT_IMAGE_NUMBER];
+    uint8_t *pubkey;
+    uint8_t *end;
+    int i;
+    int rc;
+
+    if (batch->count == 0) {
+        return 0;
+    }
+
+    for (i = 0; i < batch->count; i++) {
+        pubkey = (uint8_t *)bootutil_keys[batch->sigs[i].key_id].key;
+        end = pubkey + *bootutil_keys[batch->sigs[i].key_id].len;
+
+        rc = bootutil_import_key(&pubkey, end);
+        if (rc) {
+            return -1;
+        }
+
+        hashes[i] = batch->sigs[i].hash;
+        sigs[i] = batch->sigs[i].sig;
+        pubkeys[i] = pubkey;
+    }
+
+    rc = ED25519_verify_batch(batch->count, hashes, BOOTUTIL_IMG_HASH_SIZE,
+                              sigs, pubkeys);
+    if (rc == 0) {
+        return -2;
+    }
+
+    return 0;
+}
+#endif /* MCUBOOT_BATCH_VERIFY */
+
 #endif /* MCUBOOT_SIGN_ED25519 */
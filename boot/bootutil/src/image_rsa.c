@@ -31,6 +31,10 @@
 
 #include "bootutil_priv.h"
 
+#if BOOTUTIL_IMG_HASH_SIZE != 32
+#error "RSA-PSS signatures are only supported over SHA256 image hashes"
+#endif
+
 /*
  * Constants for this particular constrained implementation of
  * RSA-PSS.  In particular, we support RSA 2048, with a SHA256 hash,
@@ -59,6 +63,9 @@
 /* Where the salt starts. */
 #define PSS_MASK_SALT_POS   (PSS_MASK_ONE_POS + 1)
 
+/* The size of the modulus, in 32-bit words. */
+#define RSA_WORDS (MCUBOOT_SIGN_RSA_LEN / 32)
+
 static const uint8_t pss_zeros[8] = {0};
 
 /*
@@ -144,29 +151,124 @@ pss_mgf1(uint8_t *mask, const uint8_t *hash)
 }
 
 /*
- * Validate an RSA signature, using RSA-PSS, as described in PKCS #1
- * v2.2, section 9.1.2, with many parameters required to have fixed
- * values.
+ * Montgomery multiplication: r = a * b / R mod N, for a and b less than N.
+ * r may be the same as a or b.
+ */
+static void
+bootutil_rsa_mont_mul(uint32_t *r, const uint32_t *a, const uint32_t *b,
+                      const struct bootutil_rsa_key *key)
+{
+    uint32_t t[RSA_WORDS + 2];
+    uint64_t acc;
+    uint32_t m;
+    uint32_t borrow;
+    int i;
+    int j;
+
+    memset(t, 0, sizeof(t));
+
+    for (i = 0; i < RSA_WORDS; i++) {
+        /* t += a * b[i] */
+        acc = 0;
+        for (j = 0; j < RSA_WORDS; j++) {
+            acc += (uint64_t)a[j] * b[i] + t[j];
+            t[j] = (uint32_t)acc;
+            acc >>= 32;
+        }
+        acc += t[RSA_WORDS];
+        t[RSA_WORDS] = (uint32_t)acc;
+        t[RSA_WORDS + 1] = (uint32_t)(acc >> 32);
+
+        /* t = (t + m * N) / 2^32, where m makes the division exact. */
+        m = t[0] * key->n0inv;
+        acc = (uint64_t)m * key->n[0] + t[0];
+        acc >>= 32;
+        for (j = 1; j < RSA_WORDS; j++) {
+            acc += (uint64_t)m * key->n[j] + t[j];
+            t[j - 1] = (uint32_t)acc;
+            acc >>= 32;
+        }
+        acc += t[RSA_WORDS];
+        t[RSA_WORDS - 1] = (uint32_t)acc;
+        t[RSA_WORDS] = t[RSA_WORDS + 1] + (uint32_t)(acc >> 32);
+    }
+
+    /* t < 2N, subtract N once if needed. */
+    borrow = 0;
+    for (j = 0; j < RSA_WORDS; j++) {
+        acc = (uint64_t)t[j] - key->n[j] - borrow;
+        r[j] = (uint32_t)acc;
+        borrow = (uint32_t)(acc >> 32) & 1;
+    }
+    if (t[RSA_WORDS] < borrow) {
+        memcpy(r, t, RSA_WORDS * sizeof(uint32_t));
+    }
+}
+
+/*
+ * Compute em = sig^65537 mod N, with the precomputed Montgomery constants
+ * of the key instead of the mbed TLS bignum code.
  */
 static int
-bootutil_cmp_rsasig(mbedtls_rsa_context *ctx, uint8_t *hash, uint32_t hlen,
-  uint8_t *sig)
+bootutil_rsa_public(const struct bootutil_rsa_key *key, const uint8_t *sig,
+                    uint8_t *em)
 {
-    bootutil_sha256_context shactx;
-    uint8_t em[MBEDTLS_MPI_MAX_SIZE];
-    uint8_t db_mask[PSS_MASK_LEN];
-    uint8_t h2[PSS_HLEN];
+    uint32_t s[RSA_WORDS];
+    uint32_t x[RSA_WORDS];
+    int less;
     int i;
 
-    if (ctx->len != PSS_EMLEN || PSS_EMLEN > MBEDTLS_MPI_MAX_SIZE) {
+    if (key->words != RSA_WORDS) {
         return -1;
     }
 
-    if (hlen != PSS_HLEN) {
+    for (i = 0; i < RSA_WORDS; i++) {
+        const uint8_t *p = &sig[PSS_EMLEN - 4 * (i + 1)];
+        s[i] = ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+               ((uint32_t)p[2] << 8) | p[3];
+    }
+
+    /* The signature must be less than N. */
+    less = 0;
+    for (i = 0; i < RSA_WORDS; i++) {
+        less = s[i] < key->n[i] || (s[i] == key->n[i] && less);
+    }
+    if (!less) {
         return -1;
     }
 
-    if (mbedtls_rsa_public(ctx, sig, em)) {
+    /* x = s * R, squared 16 times, then multiplied by s out of it. */
+    bootutil_rsa_mont_mul(x, s, key->rr, key);
+    for (i = 0; i < 16; i++) {
+        bootutil_rsa_mont_mul(x, x, x, key);
+    }
+    bootutil_rsa_mont_mul(x, x, s, key);
+
+    for (i = 0; i < RSA_WORDS; i++) {
+        uint8_t *p = &em[PSS_EMLEN - 4 * (i + 1)];
+        p[0] = (uint8_t)(x[i] >> 24);
+        p[1] = (uint8_t)(x[i] >> 16);
+        p[2] = (uint8_t)(x[i] >> 8);
+        p[3] = (uint8_t)x[i];
+    }
+
+    return 0;
+}
+
+/*
+ * Validate an RSA signature, using RSA-PSS, as described in PKCS #1
+ * v2.2, section 9.1.2, with many parameters required to have fixed
+ * values.  em is the signature after the public key operation.
+ */
+static int
+bootutil_cmp_pss(uint8_t *hash, uint32_t hlen, const uint8_t *em)
+{
+    bootutil_sha256_context shactx;
+    uint8_t db_mask[PSS_MASK_LEN];
+    uint8_t h2[PSS_HLEN];
+    int i;
+
+    if (hlen != PSS_HLEN) {
         return -1;
     }
 
@@ -263,6 +365,23 @@ bootutil_cmp_rsasig(mbedtls_rsa_context *ctx, uint8_t *hash, uint32_t hlen,
     return 0;
 }
 
+static int
+bootutil_cmp_rsasig(mbedtls_rsa_context *ctx, uint8_t *hash, uint32_t hlen,
+  uint8_t *sig)
+{
+    uint8_t em[MBEDTLS_MPI_MAX_SIZE];
+
+    if (ctx->len != PSS_EMLEN || PSS_EMLEN > MBEDTLS_MPI_MAX_SIZE) {
+        return -1;
+    }
+
+    if (mbedtls_rsa_public(ctx, sig, em)) {
+        return -1;
+    }
+
+    return bootutil_cmp_pss(hash, hlen, em);
+}
+
 int
 bootutil_verify_sig(uint8_t *hash, uint32_t hlen, uint8_t *sig, size_t slen,
   uint8_t key_id)
@@ -272,6 +391,17 @@ bootutil_verify_sig(uint8_t *hash, uint32_t hlen, uint8_t *sig, size_t slen,
     uint8_t *cp;
     uint8_t *end;
 
+    if (bootutil_keys[key_id].rsa != NULL &&
+        bootutil_keys[key_id].rsa->words != 0) {
+        uint8_t em[PSS_EMLEN];
+
+        if (slen != PSS_EMLEN ||
+            bootutil_rsa_public(bootutil_keys[key_id].rsa, sig, em)) {
+            return -1;
+        }
+        return bootutil_cmp_pss(hash, hlen, em);
+    }
+
     mbedtls_rsa_init(&ctx, 0, 0);
 
     cp = (uint8_t *)bootutil_keys[key_id].key;
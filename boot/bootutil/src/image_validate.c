@@ -48,16 +48,127 @@
 
 #include "bootutil_priv.h"
 
+#ifdef MCUBOOT_SIG_VERIFY_TIMING
+#include "bootutil/bootutil_log.h"
+
+MCUBOOT_LOG_MODULE_DECLARE(mcuboot);
+#endif
+
+#if defined(MCUBOOT_HASH_CHUNKS) && BOOTUTIL_IMG_HASH_SIZE != 32
+#error "MCUBOOT_HASH_CHUNKS needs SHA256 image hashes"
+#endif
+
+#ifdef MCUBOOT_HASH_CHUNKS
 /*
- * Compute SHA256 over the image.
+ * For images with IMAGE_F_HASH_CHUNKS, the hashed part of the image is split
+ * in chunks, the last one possibly shorter.  The unprotected
+ * IMAGE_TLV_SHA256_CHUNKS TLV holds the chunk size as a 32-bit value followed
+ * by the SHA256 of each chunk, and the image hash, the one signed, is the
+ * SHA256 of that TLV.  A bad chunk can then be reported as soon as it has
+ * been read.
+ *
+ * Computes the image hash from the list, and returns the chunk size and the
+ * offset of the first chunk digest.
  */
 static int
+bootutil_img_chunks_root(struct image_header *hdr, const struct flash_area *fap,
+                         uint8_t *tmp_buf, uint32_t tmp_buf_sz,
+                         uint8_t *hash_result, uint8_t *seed, int seed_len,
+                         uint32_t *chunk_sz, uint32_t *digests_off)
+{
+    bootutil_sha256_context sha256_ctx;
+    struct image_tlv_iter it;
+    uint32_t num_chunks;
+    uint32_t size;
+    uint32_t blk_sz;
+    uint32_t off;
+    uint16_t len;
+    int rc;
+
+    rc = bootutil_tlv_iter_begin(&it, hdr, fap, IMAGE_TLV_SHA256_CHUNKS, false);
+    if (rc) {
+        return -1;
+    }
+    rc = bootutil_tlv_iter_next(&it, &off, &len, NULL);
+    if (rc) {
+        return -1;
+    }
+
+    rc = flash_area_read(fap, off, chunk_sz, sizeof *chunk_sz);
+    if (rc) {
+        return rc;
+    }
+
+    size = BOOT_TLV_OFF(hdr) + hdr->ih_protect_tlv_size;
+    if (*chunk_sz == 0) {
+        return -1;
+    }
+    num_chunks = (size - 1) / *chunk_sz + 1;
+    if (num_chunks > (UINT16_MAX - sizeof *chunk_sz) / 32 ||
+        len != sizeof *chunk_sz + num_chunks * 32) {
+        return -1;
+    }
+    *digests_off = off + sizeof *chunk_sz;
+
+    bootutil_sha256_init(&sha256_ctx);
+    if (seed && (seed_len > 0)) {
+        bootutil_sha256_update(&sha256_ctx, seed, seed_len);
+    }
+    for (size = len; size > 0; size -= blk_sz, off += blk_sz) {
+        blk_sz = size;
+        if (blk_sz > tmp_buf_sz) {
+            blk_sz = tmp_buf_sz;
+        }
+        rc = flash_area_read(fap, off, tmp_buf, blk_sz);
+        if (rc) {
+            return rc;
+        }
+        bootutil_sha256_update(&sha256_ctx, tmp_buf, blk_sz);
+    }
+    bootutil_sha256_finish(&sha256_ctx, hash_result);
+
+    return 0;
+}
+
+/*
+ * Compares the digest of a chunk with the one in the list.
+ */
+static int
+bootutil_img_check_chunk(const struct flash_area *fap, uint32_t digest_off,
+                         bootutil_sha256_context *sha256_ctx)
+{
+    uint8_t expected[32];
+    uint8_t digest[32];
+    int rc;
+
+    bootutil_sha256_finish(sha256_ctx, digest);
+
+    rc = flash_area_read(fap, digest_off, expected, sizeof expected);
+    if (rc) {
+        return rc;
+    }
+    if (memcmp(digest, expected, sizeof digest)) {
+        return -1;
+    }
+
+    return 0;
+}
+#endif /* MCUBOOT_HASH_CHUNKS */
+
+/*
+ * Compute the image hash over the image.
+ */
+#ifndef MCUBOOT_BATCH_VERIFY
+static
+#endif
+int
 bootutil_img_hash(struct enc_key_data *enc_state, int image_index,
                   struct image_header *hdr, const struct flash_area *fap,
                   uint8_t *tmp_buf, uint32_t tmp_buf_sz, uint8_t *hash_result,
                   uint8_t *seed, int seed_len)
 {
-    bootutil_sha256_context sha256_ctx;
+    bootutil_img_hash_context hash_ctx;
+    const uint8_t *blk;
     uint32_t blk_sz;
     uint32_t size;
     uint16_t hdr_size;
@@ -65,6 +176,14 @@ bootutil_img_hash(struct enc_key_data *enc_state, int image_index,
     int rc;
     uint32_t blk_off;
     uint32_t tlv_off;
+#ifdef MCUBOOT_USE_FLASH_MAPPED
+    const uint8_t *mapped;
+#endif
+#ifdef MCUBOOT_HASH_CHUNKS
+    uint32_t chunk_sz;
+    uint32_t chunk_end;
+    uint32_t digest_off;
+#endif
 
 #if (BOOT_IMAGE_NUMBER == 1) || !defined(MCUBOOT_ENC_IMAGES)
     (void)enc_state;
@@ -82,12 +201,44 @@ bootutil_img_hash(struct enc_key_data *enc_state, int image_index,
     }
 #endif
 
-    bootutil_sha256_init(&sha256_ctx);
+#ifdef MCUBOOT_HASH_CHUNKS
+    chunk_sz = 0;
+    chunk_end = 0;
+    digest_off = 0;
+    if (hdr->ih_flags & IMAGE_F_HASH_CHUNKS) {
+        rc = bootutil_img_chunks_root(hdr, fap, tmp_buf, tmp_buf_sz,
+                                      hash_result, seed, seed_len,
+                                      &chunk_sz, &digest_off);
+        if (rc) {
+            return rc;
+        }
+        chunk_end = chunk_sz;
+        /* From now on, each chunk is hashed separately. */
+        seed_len = 0;
+    }
+#endif
+
+#ifdef MCUBOOT_USE_FLASH_MAPPED
+    /* Hash straight from memory-mapped flash, unless the payload has to be
+     * decrypted first. */
+    mapped = flash_area_get_mapped(fap);
+#ifdef MCUBOOT_ENC_IMAGES
+    if (MUST_DECRYPT(fap, image_index, hdr)) {
+        mapped = NULL;
+    }
+#endif
+    if (mapped != NULL) {
+        /* No buffer involved, only chunk boundaries split the data. */
+        tmp_buf_sz = UINT32_MAX;
+    }
+#endif
+
+    bootutil_img_hash_init(&hash_ctx);
 
     /* in some cases (split image) the hash is seeded with data from
      * the loader image */
     if (seed && (seed_len > 0)) {
-        bootutil_sha256_update(&sha256_ctx, seed, seed_len);
+        bootutil_img_hash_update(&hash_ctx, seed, seed_len);
     }
 
     /* Hash is computed over image header and image itself. */
@@ -98,11 +249,23 @@ bootutil_img_hash(struct enc_key_data *enc_state, int image_index,
     /* If protected TLVs are present they are also hashed. */
     size += hdr->ih_protect_tlv_size;
 
+#ifdef MCUBOOT_USE_FLASH_MAPPED
+    /* Reads through the mapping are not bounds checked by the flash map. */
+    if (mapped != NULL && (size < tlv_off || size > fap->fa_size)) {
+        return -1;
+    }
+#endif
+
     for (off = 0; off < size; off += blk_sz) {
         blk_sz = size - off;
         if (blk_sz > tmp_buf_sz) {
             blk_sz = tmp_buf_sz;
         }
+#ifdef MCUBOOT_HASH_CHUNKS
+        if (chunk_sz != 0 && blk_sz > chunk_end - off) {
+            blk_sz = chunk_end - off;
+        }
+#endif
 #ifdef MCUBOOT_ENC_IMAGES
         /* The only data that is encrypted in an image is the payload;
          * both header and TLVs (when protected) are not.
@@ -116,23 +279,51 @@ bootutil_img_hash(struct enc_key_data *enc_state, int image_index,
             blk_sz = tlv_off - off;
         }
 #endif
-        rc = flash_area_read(fap, off, tmp_buf, blk_sz);
-        if (rc) {
-            return rc;
-        }
+#ifdef MCUBOOT_USE_FLASH_MAPPED
+        if (mapped != NULL) {
+            blk = mapped + off;
+        } else
+#endif
+        {
+            rc = flash_area_read(fap, off, tmp_buf, blk_sz);
+            if (rc) {
+                return rc;
+            }
 #ifdef MCUBOOT_ENC_IMAGES
-        if (MUST_DECRYPT(fap, image_index, hdr)) {
-            /* Only payload is encrypted (area between header and TLVs) */
-            if (off >= hdr_size && off < tlv_off) {
-                blk_off = (off - hdr_size) & 0xf;
-                boot_encrypt(enc_state, image_index, fap, off - hdr_size,
-                        blk_sz, blk_off, tmp_buf);
+            if (MUST_DECRYPT(fap, image_index, hdr)) {
+                /* Only payload is encrypted (area between header and TLVs) */
+                if (off >= hdr_size && off < tlv_off) {
+                    blk_off = (off - hdr_size) & 0xf;
+                    boot_encrypt(enc_state, image_index, fap, off - hdr_size,
+                            blk_sz, blk_off, tmp_buf);
+                }
             }
+#endif
+            blk = tmp_buf;
+        }
+        bootutil_img_hash_update(&hash_ctx, blk, blk_sz);
+#ifdef MCUBOOT_HASH_CHUNKS
+        if (chunk_sz != 0 && (off + blk_sz == chunk_end ||
+                              off + blk_sz == size)) {
+            /* Reject the image on the first chunk that doesn't match. */
+            rc = bootutil_img_check_chunk(fap, digest_off, &hash_ctx);
+            if (rc) {
+                return -1;
+            }
+            digest_off += 32;
+            chunk_end += chunk_sz;
+            bootutil_img_hash_init(&hash_ctx);
         }
 #endif
-        bootutil_sha256_update(&sha256_ctx, tmp_buf, blk_sz);
     }
-    bootutil_sha256_finish(&sha256_ctx, hash_result);
+
+#ifdef MCUBOOT_HASH_CHUNKS
+    if (chunk_sz != 0) {
+        /* hash_result already holds the hash of the list. */
+        return 0;
+    }
+#endif
+    bootutil_img_hash_finish(&hash_ctx, hash_result);
 
     return 0;
 }
@@ -173,16 +364,33 @@ bootutil_img_hash(struct enc_key_data *enc_state, int image_index,
 #    define SIG_BUF_SIZE 64
 #    define EXPECTED_SIG_LEN(x) ((x) == SIG_BUF_SIZE)
 #else
-#    define SIG_BUF_SIZE 32 /* no signing, sha256 digest only */
+#    define SIG_BUF_SIZE BOOTUTIL_IMG_HASH_SIZE /* no signing, digest only */
 #endif
 
 #ifdef EXPECTED_SIG_TLV
+/*
+ * Compares two buffers in a time that doesn't depend on their contents.
+ * Returns 0 if they are equal.
+ */
+static int
+bootutil_consttime_memcmp(const uint8_t *a, const uint8_t *b, size_t len)
+{
+    uint8_t diff = 0;
+    size_t i;
+
+    for (i = 0; i < len; i++) {
+        diff |= a[i] ^ b[i];
+    }
+    return diff;
+}
+
 static int
 bootutil_find_key(uint8_t *keyhash, uint8_t keyhash_len)
 {
     bootutil_sha256_context sha256_ctx;
     int i;
     const struct bootutil_key *key;
+    const uint8_t *key_hash;
     uint8_t hash[32];
 
     if (keyhash_len > 32) {
@@ -191,10 +399,15 @@ bootutil_find_key(uint8_t *keyhash, uint8_t keyhash_len)
 
     for (i = 0; i < bootutil_key_cnt; i++) {
         key = &bootutil_keys[i];
-        bootutil_sha256_init(&sha256_ctx);
-        bootutil_sha256_update(&sha256_ctx, key->key, *key->len);
-        bootutil_sha256_finish(&sha256_ctx, hash);
-        if (!memcmp(hash, keyhash, keyhash_len)) {
+        key_hash = key->hash;
+        if (key_hash == NULL) {
+            /* Key table without precomputed hashes. */
+            bootutil_sha256_init(&sha256_ctx);
+            bootutil_sha256_update(&sha256_ctx, key->key, *key->len);
+            bootutil_sha256_finish(&sha256_ctx, hash);
+            key_hash = hash;
+        }
+        if (!bootutil_consttime_memcmp(key_hash, keyhash, keyhash_len)) {
             return i;
         }
     }
@@ -273,18 +486,50 @@ bootutil_img_validate(struct enc_key_data *enc_state, int image_index,
                       struct image_header *hdr, const struct flash_area *fap,
                       uint8_t *tmp_buf, uint32_t tmp_buf_sz, uint8_t *seed,
                       int seed_len, uint8_t *out_hash)
+{
+    uint8_t hash[BOOTUTIL_IMG_HASH_SIZE];
+    int rc;
+
+    rc = bootutil_img_hash(enc_state, image_index, hdr, fap, tmp_buf,
+            tmp_buf_sz, hash, seed, seed_len);
+    if (rc) {
+        return rc;
+    }
+
+    if (out_hash) {
+        memcpy(out_hash, hash, BOOTUTIL_IMG_HASH_SIZE);
+    }
+
+    return bootutil_img_validate_hash(image_index, hdr, fap, hash);
+}
+
+#ifndef MCUBOOT_BATCH_VERIFY
+struct bootutil_sig_batch;
+#endif
+
+static int
+img_validate_hash(int image_index, struct image_header *hdr,
+                  const struct flash_area *fap, uint8_t *hash,
+                  struct bootutil_sig_batch *batch)
 {
     uint32_t off;
     uint16_t len;
     uint16_t type;
-    int sha256_valid = 0;
+    int hash_valid = 0;
 #ifdef EXPECTED_SIG_TLV
     int valid_signature = 0;
     int key_id = -1;
+#ifdef MCUBOOT_SIG_VERIFY_TIMING
+    uint32_t cycles;
+#endif
+#endif
+#ifdef MCUBOOT_BATCH_VERIFY
+    int deferred = 0;
+#else
+    (void)batch;
 #endif
     struct image_tlv_iter it;
     uint8_t buf[SIG_BUF_SIZE];
-    uint8_t hash[32];
     int rc;
 #ifdef MCUBOOT_HW_ROLLBACK_PROT
     uint32_t security_cnt = UINT32_MAX;
@@ -292,15 +537,9 @@ bootutil_img_validate(struct enc_key_data *enc_state, int image_index,
     int32_t security_counter_valid = 0;
 #endif
 
-    rc = bootutil_img_hash(enc_state, image_index, hdr, fap, tmp_buf,
-            tmp_buf_sz, hash, seed, seed_len);
-    if (rc) {
-        return rc;
-    }
-
-    if (out_hash) {
-        memcpy(out_hash, hash, 32);
-    }
+#ifndef MCUBOOT_HW_ROLLBACK_PROT
+    (void)image_index;
+#endif
 
     rc = bootutil_tlv_iter_begin(&it, hdr, fap, IMAGE_TLV_ANY, false);
     if (rc) {
@@ -319,23 +558,22 @@ bootutil_img_validate(struct enc_key_data *enc_state, int image_index,
             break;
         }
 
-        if (type == IMAGE_TLV_SHA256) {
+        if (type == BOOTUTIL_IMG_HASH_TLV) {
             /*
-             * Verify the SHA256 image hash.  This must always be
-             * present.
+             * Verify the image hash.  This must always be present.
              */
-            if (len != sizeof(hash)) {
+            if (len != BOOTUTIL_IMG_HASH_SIZE) {
                 return -1;
             }
-            rc = flash_area_read(fap, off, buf, sizeof hash);
+            rc = flash_area_read(fap, off, buf, BOOTUTIL_IMG_HASH_SIZE);
             if (rc) {
                 return rc;
             }
-            if (memcmp(hash, buf, sizeof(hash))) {
+            if (memcmp(hash, buf, BOOTUTIL_IMG_HASH_SIZE)) {
                 return -1;
             }
 
-            sha256_valid = 1;
+            hash_valid = 1;
 #ifdef EXPECTED_SIG_TLV
         } else if (type == IMAGE_TLV_KEYHASH) {
             /*
@@ -366,7 +604,39 @@ bootutil_img_validate(struct enc_key_data *enc_state, int image_index,
             if (rc) {
                 return -1;
             }
-            rc = bootutil_verify_sig(hash, sizeof(hash), buf, len, key_id);
+#ifdef MCUBOOT_BATCH_VERIFY
+            if (batch != NULL && !valid_signature &&
+                batch->count < BOOT_IMAGE_NUMBER) {
+                memcpy(batch->sigs[batch->count].hash, hash,
+                       BOOTUTIL_IMG_HASH_SIZE);
+                memcpy(batch->sigs[batch->count].sig, buf, len);
+                batch->sigs[batch->count].key_id = (uint8_t)key_id;
+                batch->sigs[batch->count].image_index = (uint8_t)image_index;
+                batch->count++;
+                deferred = 1;
+                valid_signature = 1;
+                key_id = -1;
+                continue;
+            }
+            if (deferred) {
+                /*
+                 * Only one signature per image is batched; the others are
+                 * checked if the batch is rejected.
+                 */
+                key_id = -1;
+                continue;
+            }
+#endif
+#ifdef MCUBOOT_SIG_VERIFY_TIMING
+            cycles = MCUBOOT_CYCLE_COUNT();
+#endif
+            rc = bootutil_verify_sig(hash, BOOTUTIL_IMG_HASH_SIZE, buf, len,
+                                     key_id);
+#ifdef MCUBOOT_SIG_VERIFY_TIMING
+            cycles = MCUBOOT_CYCLE_COUNT() - cycles;
+            BOOT_LOG_INF("Image %u: signature checked in %lu cycles",
+                         image_index, (unsigned long)cycles);
+#endif
             if (rc == 0) {
                 valid_signature = 1;
             }
@@ -407,7 +677,7 @@ bootutil_img_validate(struct enc_key_data *enc_state, int image_index,
         }
     }
 
-    if (!sha256_valid) {
+    if (!hash_valid) {
         return -1;
 #ifdef EXPECTED_SIG_TLV
     } else if (!valid_signature) {
@@ -421,3 +691,30 @@ bootutil_img_validate(struct enc_key_data *enc_state, int image_index,
 
     return 0;
 }
+
+#ifdef MCUBOOT_BATCH_VERIFY
+/*
+ * Like bootutil_img_validate_hash(), except that the first image signature
+ * made with a known key is added to `batch` instead of being verified.  The
+ * image is only valid once bootutil_verify_sig_batch() accepts the batch.
+ */
+int
+bootutil_img_validate_hash_batch(int image_index, struct image_header *hdr,
+                                 const struct flash_area *fap, uint8_t *hash,
+                                 struct bootutil_sig_batch *batch)
+{
+    return img_validate_hash(image_index, hdr, fap, hash, batch);
+}
+#endif
+
+/*
+ * Verify the integrity of an image whose hash has already been computed:
+ * the hash is checked against the image's TLVs and its signature verified.
+ * Return non-zero if image does not validate.
+ */
+int
+bootutil_img_validate_hash(int image_index, struct image_header *hdr,
+                           const struct flash_area *fap, uint8_t *hash)
+{
+    return img_validate_hash(image_index, hdr, fap, hash, NULL);
+}
@@ -183,7 +183,159 @@ boot_write_sz(struct boot_loader_state *state)
     return elem_sz;
 }
 
-#ifndef MCUBOOT_USE_FLASH_AREA_GET_SECTORS
+#if defined(MCUBOOT_UNIFORM_SECTOR_SIZE)
+#if defined(MCUBOOT_HAVE_ASSERT_H) && defined(MCUBOOT_USE_FLASH_AREA_GET_SECTORS)
+/* Areas whose sectors were checked, as a mask of flash area ids. */
+#ifdef __BOOTSIM__
+/* The simulator runs one boot loader per thread. */
+static __thread uint32_t boot_uniform_checked;
+#else
+static uint32_t boot_uniform_checked;
+#endif
+
+/*
+ * Checks, once per area, that the flash driver reports the sectors the
+ * layout was built for, so that a wrong MCUBOOT_UNIFORM_SECTOR_SIZE is caught
+ * in debug builds instead of erasing the wrong ranges.
+ */
+static int
+boot_check_uniform_sectors(int flash_area, const struct flash_area *fap)
+{
+    TARGET_STATIC struct flash_sector sectors[BOOT_MAX_IMG_SECTORS];
+    uint32_t num_sectors;
+    uint32_t i;
+    int rc;
+
+    if (flash_area >= 0 && flash_area < 32 &&
+        (boot_uniform_checked & (1u << flash_area)) != 0) {
+        return 0;
+    }
+
+    num_sectors = BOOT_MAX_IMG_SECTORS;
+    rc = flash_area_get_sectors(flash_area, &num_sectors, sectors);
+    if (rc != 0) {
+        return BOOT_EFLASH;
+    }
+
+    rc = (num_sectors == fap->fa_size / MCUBOOT_UNIFORM_SECTOR_SIZE) ? 0 : -1;
+    for (i = 0; rc == 0 && i < num_sectors; i++) {
+        if (sectors[i].fs_size != MCUBOOT_UNIFORM_SECTOR_SIZE) {
+            rc = -1;
+        }
+    }
+    if (rc != 0) {
+        BOOT_LOG_ERR("Flash area %d isn't made of %d byte sectors",
+                     flash_area, MCUBOOT_UNIFORM_SECTOR_SIZE);
+        assert(0);
+        return BOOT_EFLASH;
+    }
+
+    if (flash_area >= 0 && flash_area < 32) {
+        boot_uniform_checked |= 1u << flash_area;
+    }
+    return 0;
+}
+#endif
+
+static int
+boot_initialize_area(struct boot_loader_state *state, int flash_area)
+{
+    const struct flash_area *fap;
+    size_t *out_num_sectors;
+
+    if (flash_area == FLASH_AREA_IMAGE_PRIMARY(BOOT_CURR_IMG(state))) {
+        fap = BOOT_IMG_AREA(state, BOOT_PRIMARY_SLOT);
+        out_num_sectors = &BOOT_IMG(state, BOOT_PRIMARY_SLOT).num_sectors;
+    } else if (flash_area == FLASH_AREA_IMAGE_SECONDARY(BOOT_CURR_IMG(state))) {
+        fap = BOOT_IMG_AREA(state, BOOT_SECONDARY_SLOT);
+        out_num_sectors = &BOOT_IMG(state, BOOT_SECONDARY_SLOT).num_sectors;
+#if MCUBOOT_SWAP_USING_SCRATCH
+    } else if (flash_area == FLASH_AREA_IMAGE_SCRATCH) {
+        fap = BOOT_SCRATCH_AREA(state);
+        out_num_sectors = &state->scratch.num_sectors;
+#endif
+    } else {
+        return BOOT_EFLASH;
+    }
+
+    /* The layout is fixed at build time, only check that it fits the area. */
+    if (fap->fa_size % MCUBOOT_UNIFORM_SECTOR_SIZE != 0 ||
+        fap->fa_size / MCUBOOT_UNIFORM_SECTOR_SIZE > BOOT_MAX_IMG_SECTORS) {
+        BOOT_LOG_ERR("Flash area %d doesn't match the sector size %d",
+                     flash_area, MCUBOOT_UNIFORM_SECTOR_SIZE);
+        return BOOT_EFLASH;
+    }
+#if defined(MCUBOOT_HAVE_ASSERT_H) && defined(MCUBOOT_USE_FLASH_AREA_GET_SECTORS)
+    if (boot_check_uniform_sectors(flash_area, fap) != 0) {
+        return BOOT_EFLASH;
+    }
+#endif
+    *out_num_sectors = fap->fa_size / MCUBOOT_UNIFORM_SECTOR_SIZE;
+    return 0;
+}
+#elif defined(MCUBOOT_MAX_SECTOR_RUNS)
+static int
+boot_initialize_area(struct boot_loader_state *state, int flash_area)
+{
+    /* Only one area is read at a time, so a single array is enough. */
+    TARGET_STATIC struct flash_sector sectors[BOOT_MAX_IMG_SECTORS];
+    struct boot_sector_map *map;
+    struct boot_sector_run *run;
+    size_t *out_num_sectors;
+    uint32_t num_sectors;
+    uint32_t i;
+    int rc;
+
+    if (flash_area == FLASH_AREA_IMAGE_PRIMARY(BOOT_CURR_IMG(state))) {
+        map = &BOOT_IMG(state, BOOT_PRIMARY_SLOT).map;
+        out_num_sectors = &BOOT_IMG(state, BOOT_PRIMARY_SLOT).num_sectors;
+    } else if (flash_area == FLASH_AREA_IMAGE_SECONDARY(BOOT_CURR_IMG(state))) {
+        map = &BOOT_IMG(state, BOOT_SECONDARY_SLOT).map;
+        out_num_sectors = &BOOT_IMG(state, BOOT_SECONDARY_SLOT).num_sectors;
+#if MCUBOOT_SWAP_USING_SCRATCH
+    } else if (flash_area == FLASH_AREA_IMAGE_SCRATCH) {
+        map = &state->scratch.map;
+        out_num_sectors = &state->scratch.num_sectors;
+#endif
+    } else {
+        return BOOT_EFLASH;
+    }
+
+    num_sectors = BOOT_MAX_IMG_SECTORS;
+    rc = flash_area_get_sectors(flash_area, &num_sectors, sectors);
+    if (rc != 0) {
+        return rc;
+    }
+
+    map->num_runs = 0;
+    run = NULL;
+    for (i = 0; i < num_sectors; i++) {
+        if (i > 0 && sectors[i].fs_off !=
+                     sectors[i - 1].fs_off + sectors[i - 1].fs_size) {
+            BOOT_LOG_ERR("Flash area %d has non contiguous sectors",
+                         flash_area);
+            return BOOT_EFLASH;
+        }
+
+        if (run != NULL && run->size == sectors[i].fs_size) {
+            run->count++;
+            continue;
+        }
+
+        if (map->num_runs == BOOT_MAX_SECTOR_RUNS) {
+            BOOT_LOG_ERR("Flash area %d has more than %d sector runs",
+                         flash_area, BOOT_MAX_SECTOR_RUNS);
+            return BOOT_EFLASH;
+        }
+        run = &map->runs[map->num_runs++];
+        run->size = sectors[i].fs_size;
+        run->count = 1;
+    }
+
+    *out_num_sectors = num_sectors;
+    return 0;
+}
+#elif !defined(MCUBOOT_USE_FLASH_AREA_GET_SECTORS)
 static int
 boot_initialize_area(struct boot_loader_state *state, int flash_area)
 {
@@ -246,7 +398,7 @@ boot_initialize_area(struct boot_loader_state *state, int flash_area)
     *out_num_sectors = num_sectors;
     return 0;
 }
-#endif  /* !defined(MCUBOOT_USE_FLASH_AREA_GET_SECTORS) */
+#endif  /* defined(MCUBOOT_UNIFORM_SECTOR_SIZE) */
 
 /**
  * Determines the sector layout of both image slots and the scratch area.
@@ -295,6 +447,9 @@ boot_status_reset(struct boot_status *bs)
 #endif /* MCUBOOT_ENC_IMAGES */
 
     bs->use_scratch = 0;
+#ifdef MCUBOOT_SWAP_SKIP_IDENTICAL
+    bs->skipped = 0;
+#endif
     bs->swap_size = 0;
     bs->source = 0;
 
@@ -361,6 +516,11 @@ boot_write_status(const struct boot_loader_state *state, struct boot_status *bs)
     erased_val = flash_area_erased_val(fap);
     memset(buf, erased_val, BOOT_MAX_ALIGN);
     buf[0] = bs->state;
+#ifdef MCUBOOT_SWAP_SKIP_IDENTICAL
+    if (bs->skipped) {
+        buf[0] |= BOOT_STATUS_SKIPPED;
+    }
+#endif
 
     rc = flash_area_write(fap, off, buf, align);
     if (rc != 0) {
@@ -382,7 +542,6 @@ static int
 boot_image_check(struct boot_loader_state *state, struct image_header *hdr,
                  const struct flash_area *fap, struct boot_status *bs)
 {
-    TARGET_STATIC uint8_t tmpbuf[BOOT_TMPBUF_SZ];
     uint8_t image_index;
     int rc;
 
@@ -407,8 +566,46 @@ boot_image_check(struct boot_loader_state *state, struct image_header *hdr,
     }
 #endif
 
-    if (bootutil_img_validate(BOOT_CURR_ENC(state), image_index, hdr, fap, tmpbuf,
-                              BOOT_TMPBUF_SZ, NULL, 0, NULL)) {
+#ifdef MCUBOOT_HASH_ON_COPY
+    if (fap->fa_id == FLASH_AREA_IMAGE_PRIMARY(image_index) &&
+        BOOT_COPY_HASH(state).state == BOOT_COPY_HASH_DONE &&
+        BOOT_COPY_HASH(state).size == BOOT_TLV_OFF(hdr) +
+                                      hdr->ih_protect_tlv_size) {
+        /* The image was hashed while being copied into this slot. */
+#ifdef MCUBOOT_BATCH_VERIFY
+        if (state->sig_batch != NULL) {
+            rc = bootutil_img_validate_hash_batch(image_index, hdr, fap,
+                                                  BOOT_COPY_HASH(state).hash,
+                                                  state->sig_batch);
+        } else
+#endif
+        {
+            rc = bootutil_img_validate_hash(image_index, hdr, fap,
+                                            BOOT_COPY_HASH(state).hash);
+        }
+        if (rc) {
+            return BOOT_EBADIMAGE;
+        }
+        return 0;
+    }
+#endif
+
+#ifdef MCUBOOT_BATCH_VERIFY
+    if (state->sig_batch != NULL) {
+        uint8_t hash[BOOTUTIL_IMG_HASH_SIZE];
+
+        if (bootutil_img_hash(BOOT_CURR_ENC(state), image_index, hdr, fap,
+                              BOOT_BUF(state, 0), BOOT_BUF_SZ, hash, NULL, 0) ||
+            bootutil_img_validate_hash_batch(image_index, hdr, fap, hash,
+                                             state->sig_batch)) {
+            return BOOT_EBADIMAGE;
+        }
+        return 0;
+    }
+#endif
+
+    if (bootutil_img_validate(BOOT_CURR_ENC(state), image_index, hdr, fap,
+                              BOOT_BUF(state, 0), BOOT_BUF_SZ, NULL, 0, NULL)) {
         return BOOT_EBADIMAGE;
     }
 
@@ -416,28 +613,23 @@ boot_image_check(struct boot_loader_state *state, struct image_header *hdr,
 }
 
 static int
-split_image_check(struct image_header *app_hdr,
+split_image_check(struct boot_loader_state *state,
+                  struct image_header *app_hdr,
                   const struct flash_area *app_fap,
                   struct image_header *loader_hdr,
                   const struct flash_area *loader_fap)
 {
-    static void *tmpbuf;
-    uint8_t loader_hash[32];
-
-    if (!tmpbuf) {
-        tmpbuf = malloc(BOOT_TMPBUF_SZ);
-        if (!tmpbuf) {
-            return BOOT_ENOMEM;
-        }
-    }
+    uint8_t loader_hash[BOOTUTIL_IMG_HASH_SIZE];
 
-    if (bootutil_img_validate(NULL, 0, loader_hdr, loader_fap, tmpbuf,
-                              BOOT_TMPBUF_SZ, NULL, 0, loader_hash)) {
+    if (bootutil_img_validate(NULL, 0, loader_hdr, loader_fap,
+                              BOOT_BUF(state, 0), BOOT_BUF_SZ, NULL, 0,
+                              loader_hash)) {
         return BOOT_EBADIMAGE;
     }
 
-    if (bootutil_img_validate(NULL, 0, app_hdr, app_fap, tmpbuf,
-                              BOOT_TMPBUF_SZ, loader_hash, 32, NULL)) {
+    if (bootutil_img_validate(NULL, 0, app_hdr, app_fap, BOOT_BUF(state, 0),
+                              BOOT_BUF_SZ, loader_hash, sizeof loader_hash,
+                              NULL)) {
         return BOOT_EBADIMAGE;
     }
 
@@ -548,6 +740,109 @@ boot_is_version_sufficient(struct image_version *req,
 }
 #endif
 
+#ifdef MCUBOOT_VALIDATED_RECORD
+/**
+ * Erases the validated record of the image in the primary slot, left there
+ * by another image or with another key, so that a new one can be written.
+ *
+ * The record can only be erased with the trailer sectors holding it.  That
+ * is only done when the trailer holds nothing else that matters: when the
+ * image is not waiting to be confirmed or reverted, and when no part of it
+ * shares these sectors.  The trailer flags are written back afterwards; if
+ * power is lost before, the erased trailer boots the same confirmed image.
+ *
+ * @return                      0 on success; nonzero if the record is kept.
+ */
+static int
+boot_validated_record_erase(struct boot_loader_state *state,
+                            const struct flash_area *fap)
+{
+    struct boot_swap_state swap_state;
+    struct image_tlv_iter it;
+    size_t first_sector;
+    size_t last_sector;
+    uint32_t off;
+    int rc;
+
+    rc = boot_read_swap_state(fap, &swap_state);
+    if (rc != 0) {
+        return rc;
+    }
+
+    if (swap_state.magic == BOOT_MAGIC_BAD ||
+        (swap_state.magic == BOOT_MAGIC_GOOD &&
+         swap_state.image_ok != BOOT_FLAG_SET)) {
+        return -1;
+    }
+
+    rc = bootutil_tlv_iter_begin(&it, boot_img_hdr(state, BOOT_PRIMARY_SLOT),
+                                 fap, IMAGE_TLV_ANY, false);
+    if (rc != 0) {
+        return -1;
+    }
+
+    off = boot_validated_record_off(fap);
+    last_sector = boot_img_num_sectors(state, BOOT_PRIMARY_SLOT) - 1;
+    first_sector = last_sector;
+    while (first_sector > 0 &&
+           boot_img_sector_off(state, BOOT_PRIMARY_SLOT, first_sector) > off) {
+        first_sector--;
+    }
+    if (boot_img_sector_off(state, BOOT_PRIMARY_SLOT, first_sector) <
+        it.tlv_end) {
+        return -1;
+    }
+
+    BOOT_LOG_INF("Replacing the validated record of image %u",
+                 BOOT_CURR_IMG(state));
+    rc = boot_erase_sectors(state, fap, BOOT_PRIMARY_SLOT, first_sector,
+                            last_sector);
+    if (rc != 0) {
+        return rc;
+    }
+
+    if (swap_state.magic == BOOT_MAGIC_GOOD) {
+        if (swap_state.swap_type != BOOT_SWAP_TYPE_NONE) {
+            rc = boot_write_swap_info(fap, swap_state.swap_type,
+                                      swap_state.image_num);
+        }
+        if (rc == 0 && swap_state.copy_done == BOOT_FLAG_SET) {
+            rc = boot_write_copy_done(fap);
+        }
+        if (rc == 0) {
+            rc = boot_write_image_ok(fap);
+        }
+        if (rc == 0) {
+            rc = boot_write_magic(fap);
+        }
+    }
+
+    return rc;
+}
+
+/**
+ * Records that the image in the primary slot was fully validated, replacing
+ * a record that didn't match it.  If this fails, the image is just validated
+ * again next time.
+ *
+ * @param record                What boot_validated_record_check() returned
+ *                              for the image.
+ */
+static void
+boot_validated_record_update(struct boot_loader_state *state,
+                             const struct flash_area *fap, int record)
+{
+    if (record == 0 ||
+        (record < 0 && boot_validated_record_erase(state, fap) != 0)) {
+        return;
+    }
+
+    (void)boot_validated_record_write(BOOT_CURR_IMG(state),
+                                      boot_img_hdr(state, BOOT_PRIMARY_SLOT),
+                                      fap);
+}
+#endif /* MCUBOOT_VALIDATED_RECORD */
+
 /*
  * Check that there is a valid image in a slot
  *
@@ -564,6 +859,9 @@ boot_validate_slot(struct boot_loader_state *state, int slot,
     struct image_header *hdr;
     int area_id;
     int rc;
+#ifdef MCUBOOT_VALIDATED_RECORD
+    int record;
+#endif
 
     area_id = flash_area_id_from_multi_image_slot(BOOT_CURR_IMG(state), slot);
     rc = flash_area_open(area_id, &fap);
@@ -587,6 +885,7 @@ boot_validate_slot(struct boot_loader_state *state, int slot,
                 &boot_img_hdr(state, BOOT_SECONDARY_SLOT)->ih_ver);
         if (rc != 0 && boot_check_header_erased(state, BOOT_PRIMARY_SLOT)) {
             BOOT_LOG_ERR("insufficient version in secondary slot");
+            boot_trailer_cache_invalidate(fap);
             flash_area_erase(fap, 0, fap->fa_size);
             /* Image in the secondary slot does not satisfy version requirement.
              * Erase the image and continue booting from the primary slot.
@@ -597,8 +896,22 @@ boot_validate_slot(struct boot_loader_state *state, int slot,
     }
 #endif
 
+#ifdef MCUBOOT_VALIDATED_RECORD
+    /* Left at 0 unless there is a record to write. */
+    record = 0;
+    if (slot == BOOT_PRIMARY_SLOT && boot_is_header_valid(hdr, fap)) {
+        record = boot_validated_record_check(BOOT_CURR_IMG(state), hdr, fap);
+        if (record == 0) {
+            /* Validated on a previous boot, and unchanged since. */
+            rc = 0;
+            goto out;
+        }
+    }
+#endif
+
     if (!boot_is_header_valid(hdr, fap) || boot_image_check(state, hdr, fap, bs)) {
         if (slot != BOOT_PRIMARY_SLOT) {
+            boot_trailer_cache_invalidate(fap);
             flash_area_erase(fap, 0, fap->fa_size);
             /* Image in the secondary slot is invalid. Erase the image and
              * continue booting from the primary slot.
@@ -612,6 +925,16 @@ boot_validate_slot(struct boot_loader_state *state, int slot,
         goto out;
     }
 
+#ifdef MCUBOOT_VALIDATED_RECORD
+#ifdef MCUBOOT_BATCH_VERIFY
+    /* Not validated until the batch has been verified. */
+    if (state->sig_batch != NULL) {
+        record = 0;
+    }
+#endif
+    boot_validated_record_update(state, fap, record);
+#endif
+
     /* Image in the secondary slot is valid. */
     rc = 0;
 
@@ -620,6 +943,84 @@ out:
     return rc;
 }
 
+#if defined(MCUBOOT_VALIDATE_PRIMARY_SLOT) && defined(MCUBOOT_BATCH_VERIFY)
+/*
+ * Validate the images in the primary slots of all images, after reloading
+ * the headers of the ones that were just updated.  Each image is hashed and
+ * checked against its TLVs first, and then all of the signatures are
+ * verified together.  If the batch is rejected, the signatures are checked
+ * one at a time to find the bad image.
+ *
+ * @returns
+ *         0 if all of the images were successfully validated
+ *         BOOT_EBADIMAGE if one of the images is not valid
+ *         Another non-zero value if the headers could not be read
+ */
+static int
+boot_validate_primary_slots(struct boot_loader_state *state,
+                            struct boot_status *bs)
+{
+    struct bootutil_sig_batch batch;
+    const struct flash_area *fap;
+    int i;
+    int rc;
+
+    batch.count = 0;
+    state->sig_batch = &batch;
+
+    IMAGES_ITER(BOOT_CURR_IMG(state)) {
+        if (BOOT_SWAP_TYPE(state) != BOOT_SWAP_TYPE_NONE) {
+            /* The headers were swapped along with the images. */
+            rc = boot_read_image_headers(state, false, bs);
+            if (rc != 0) {
+                goto out;
+            }
+        }
+
+        rc = boot_validate_slot(state, BOOT_PRIMARY_SLOT, NULL);
+        if (rc != 0) {
+            rc = BOOT_EBADIMAGE;
+            goto out;
+        }
+    }
+
+    state->sig_batch = NULL;
+
+    rc = bootutil_verify_sig_batch(&batch);
+    if (rc != 0) {
+        for (i = 0; i < batch.count; i++) {
+            BOOT_CURR_IMG(state) = batch.sigs[i].image_index;
+            fap = BOOT_IMG_AREA(state, BOOT_PRIMARY_SLOT);
+            if (bootutil_img_validate_hash(BOOT_CURR_IMG(state),
+                                           boot_img_hdr(state,
+                                                        BOOT_PRIMARY_SLOT),
+                                           fap, batch.sigs[i].hash)) {
+                BOOT_LOG_ERR("Image %u in the primary slot is not valid!",
+                             BOOT_CURR_IMG(state));
+                rc = BOOT_EBADIMAGE;
+                goto out;
+            }
+        }
+        rc = 0;
+    }
+
+#ifdef MCUBOOT_VALIDATED_RECORD
+    IMAGES_ITER(BOOT_CURR_IMG(state)) {
+        fap = BOOT_IMG_AREA(state, BOOT_PRIMARY_SLOT);
+        boot_validated_record_update(state, fap,
+                boot_validated_record_check(BOOT_CURR_IMG(state),
+                                            boot_img_hdr(state,
+                                                         BOOT_PRIMARY_SLOT),
+                                            fap));
+    }
+#endif
+
+out:
+    state->sig_batch = NULL;
+    return rc;
+}
+#endif /* MCUBOOT_VALIDATE_PRIMARY_SLOT && MCUBOOT_BATCH_VERIFY */
+
 /**
  * Determines which swap operation to perform, if any.  If it is determined
  * that a swap operation is required, the image in the secondary slot is checked
@@ -709,12 +1110,313 @@ done:
 int
 boot_erase_region(const struct flash_area *fap, uint32_t off, uint32_t sz)
 {
+    boot_trailer_cache_invalidate(fap);
     return flash_area_erase(fap, off, sz);
 }
 
+/**
+ * Erases a range of sectors of an image slot, from the last one to the
+ * first one.
+ *
+ * With MCUBOOT_USE_FLASH_ERASE_SIZES, adjacent sectors which together form a
+ * block the flash device can erase natively (see flash_area_erase_sizes())
+ * are erased in a single operation, using the largest such block each time.
+ * Otherwise the sectors are erased one at a time.
+ *
+ * @param state                 Boot loader status information.
+ * @param fap                   The flash area of the slot.
+ * @param slot                  The slot the sectors belong to.
+ * @param first_sector          The index of the first sector to erase.
+ * @param last_sector           The index of the last sector to erase.
+ *
+ * @return                      0 on success; nonzero on failure.
+ */
+int
+boot_erase_sectors(const struct boot_loader_state *state,
+                   const struct flash_area *fap, size_t slot,
+                   size_t first_sector, size_t last_sector)
+{
+    struct boot_sector_iter it;
+    struct boot_sector_iter blk;
+    uint32_t erase_sizes;
+    uint32_t start;
+    uint32_t end;
+    uint32_t blk_sz;
+    uint32_t first_off;
+    int bit;
+    int rc;
+
+#ifdef MCUBOOT_USE_FLASH_ERASE_SIZES
+    erase_sizes = flash_area_erase_sizes(fap);
+#else
+    erase_sizes = 0;
+#endif
+
+    first_off = boot_img_sector_off(state, slot, first_sector);
+    boot_sector_iter_init(&it, state, slot, last_sector);
+    while (1) {
+        start = it.off;
+        end = it.off + it.size;
+
+        /* Look for the largest native block ending with this sector, made
+         * of whole sectors and aligned on its size within the device.
+         */
+        for (bit = 31; bit >= 0; bit--) {
+            blk_sz = (uint32_t)1 << bit;
+            if (!(erase_sizes & blk_sz) || blk_sz <= end - start) {
+                continue;
+            }
+            if (end - first_off < blk_sz ||
+                ((fap->fa_off + end) & (blk_sz - 1)) != 0) {
+                continue;
+            }
+
+            blk = it;
+            while (blk.off > end - blk_sz) {
+                boot_sector_iter_prev(&blk);
+            }
+            if (blk.off == end - blk_sz) {
+                it = blk;
+                start = blk.off;
+                break;
+            }
+        }
+
+        rc = boot_erase_region(fap, start, end - start);
+        if (rc != 0) {
+            return rc;
+        }
+
+        MCUBOOT_WATCHDOG_FEED();
+
+        if (it.sector == first_sector) {
+            break;
+        }
+        boot_sector_iter_prev(&it);
+    }
+
+    return 0;
+}
+
+#ifdef MCUBOOT_SWAP_SKIP_IDENTICAL
+/**
+ * Checks whether copying a region from one flash area to another would leave
+ * the destination unchanged, in which case the swap code can skip both the
+ * erase and the copy.  Regions of encrypted images never compare equal, as
+ * they are transformed while being copied.
+ *
+ * @param fap_a                 The first flash area.
+ * @param off_a                 The offset of the region in the first area.
+ * @param fap_b                 The second flash area.
+ * @param off_b                 The offset of the region in the second area.
+ * @param sz                    The size of the region.
+ *
+ * @return                      true if both regions hold the same data;
+ *                              false if they differ or cannot be read.
+ */
+bool
+boot_region_identical(struct boot_loader_state *state,
+                      const struct flash_area *fap_a, uint32_t off_a,
+                      const struct flash_area *fap_b, uint32_t off_b,
+                      uint32_t sz)
+{
+    uint8_t *buf_a;
+    uint8_t *buf_b;
+    uint32_t chunk_sz;
+    uint32_t off;
+
+#ifdef MCUBOOT_ENC_IMAGES
+    if (IS_ENCRYPTED(boot_img_hdr(state, BOOT_PRIMARY_SLOT)) ||
+        IS_ENCRYPTED(boot_img_hdr(state, BOOT_SECONDARY_SLOT))) {
+        return false;
+    }
+#endif
+
+    buf_a = BOOT_BUF(state, 0);
+    buf_b = buf_a + BOOT_BUF_SZ / 2;
+
+    for (off = 0; off < sz; off += chunk_sz) {
+        chunk_sz = sz - off;
+        if (chunk_sz > BOOT_BUF_SZ / 2) {
+            chunk_sz = BOOT_BUF_SZ / 2;
+        }
+
+        if (flash_area_read(fap_a, off_a + off, buf_a, chunk_sz) != 0 ||
+            flash_area_read(fap_b, off_b + off, buf_b, chunk_sz) != 0) {
+            return false;
+        }
+
+        if (memcmp(buf_a, buf_b, chunk_sz) != 0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+#endif /* MCUBOOT_SWAP_SKIP_IDENTICAL */
+
+/**
+ * Reads one chunk of a region being copied and, if needed, decrypts or
+ * encrypts it in place so that it is ready to be written to the destination.
+ *
+ * @param fap_src               The source flash area.
+ * @param fap_dst               The destination flash area.
+ * @param off_src               The offset of the region in the source flash
+ *                                  area.
+ * @param off_dst               The offset of the region in the destination
+ *                                  flash area.
+ * @param bytes_copied          The offset of this chunk within the region.
+ * @param chunk_sz              The number of bytes to read.
+ * @param buf                   The buffer receiving the chunk.
+ *
+ * @return                      0 on success; nonzero on failure.
+ */
+static int
+boot_copy_chunk_read(struct boot_loader_state *state,
+                     const struct flash_area *fap_src,
+                     const struct flash_area *fap_dst,
+                     uint32_t off_src, uint32_t off_dst,
+                     uint32_t bytes_copied, uint32_t chunk_sz, uint8_t *buf)
+{
+    int rc;
+#ifdef MCUBOOT_ENC_IMAGES
+    uint32_t off;
+    uint32_t end;
+    uint32_t tlv_off;
+    size_t blk_off;
+    struct image_header *hdr;
+    uint32_t idx;
+    uint32_t blk_sz;
+    uint8_t image_index;
+#endif
+
+#if !defined(MCUBOOT_ENC_IMAGES)
+    (void)state;
+    (void)fap_dst;
+    (void)off_dst;
+#endif
+
+    rc = flash_area_read(fap_src, off_src + bytes_copied, buf, chunk_sz);
+    if (rc != 0) {
+        return BOOT_EFLASH;
+    }
+
+#ifdef MCUBOOT_ENC_IMAGES
+    image_index = BOOT_CURR_IMG(state);
+    if ((fap_src->fa_id == FLASH_AREA_IMAGE_SECONDARY(image_index) ||
+        fap_dst->fa_id == FLASH_AREA_IMAGE_SECONDARY(image_index)) &&
+        !(fap_src->fa_id == FLASH_AREA_IMAGE_SECONDARY(image_index) &&
+          fap_dst->fa_id == FLASH_AREA_IMAGE_SECONDARY(image_index))) {
+        /* assume the secondary slot as src, needs decryption */
+        hdr = boot_img_hdr(state, BOOT_SECONDARY_SLOT);
+#if !defined(MCUBOOT_SWAP_USING_MOVE)
+        off = off_src;
+        if (fap_dst->fa_id == FLASH_AREA_IMAGE_SECONDARY(image_index)) {
+            /* might need encryption (metadata from the primary slot) */
+            hdr = boot_img_hdr(state, BOOT_PRIMARY_SLOT);
+            off = off_dst;
+        }
+#else
+        off = off_dst;
+        if (fap_dst->fa_id == FLASH_AREA_IMAGE_SECONDARY(image_index)) {
+            hdr = boot_img_hdr(state, BOOT_PRIMARY_SLOT);
+        }
+#endif
+        if (IS_ENCRYPTED(hdr)) {
+            /*
+             * Only the payload is encrypted.  With small buffers the header
+             * can span several chunks, and a chunk can hold both the end of
+             * the header and the start of the TLVs.
+             */
+            off += bytes_copied;
+            idx = 0;
+            if (off < hdr->ih_hdr_size) {
+                /* do not decrypt header */
+                idx = hdr->ih_hdr_size - off;
+            }
+            end = off + chunk_sz;
+            tlv_off = BOOT_TLV_OFF(hdr);
+            if (end > tlv_off) {
+                /* do not decrypt TLVs */
+                end = tlv_off;
+            }
+            if (off + idx < end) {
+                blk_sz = end - (off + idx);
+                blk_off = (off + idx - hdr->ih_hdr_size) & 0xf;
+                boot_encrypt(BOOT_CURR_ENC(state), image_index, fap_src,
+                        off + idx - hdr->ih_hdr_size, blk_sz, blk_off,
+                        &buf[idx]);
+            }
+        }
+    }
+#endif
+
+    return 0;
+}
+
+#ifdef MCUBOOT_HASH_ON_COPY
+/**
+ * Starts hashing the image of the secondary slot as boot_copy_region()
+ * writes it into the primary slot.  The upgrade must then write the primary
+ * slot in order from its beginning.
+ */
+void
+boot_copy_hash_start(struct boot_loader_state *state)
+{
+    struct boot_copy_hash *ch;
+    struct image_header *hdr;
+
+    ch = &BOOT_COPY_HASH(state);
+    hdr = boot_img_hdr(state, BOOT_SECONDARY_SLOT);
+
+    if (hdr->ih_flags & IMAGE_F_HASH_CHUNKS) {
+        /* The image hash is not the hash of the copied data. */
+        return;
+    }
+
+    bootutil_img_hash_init(&ch->hash_ctx);
+    ch->off = 0;
+    ch->size = BOOT_TLV_OFF(hdr) + hdr->ih_protect_tlv_size;
+    ch->state = BOOT_COPY_HASH_RUNNING;
+}
+
+static void
+boot_copy_hash_update(struct boot_loader_state *state,
+                      const struct flash_area *fap_dst, uint32_t off,
+                      const uint8_t *buf, uint32_t len)
+{
+    struct boot_copy_hash *ch;
+
+    if (fap_dst->fa_id != FLASH_AREA_IMAGE_PRIMARY(BOOT_CURR_IMG(state))) {
+        return;
+    }
+
+    ch = &BOOT_COPY_HASH(state);
+    if (ch->state == BOOT_COPY_HASH_RUNNING && off == ch->off) {
+        if (len > ch->size - ch->off) {
+            len = ch->size - ch->off;
+        }
+        bootutil_img_hash_update(&ch->hash_ctx, buf, len);
+        ch->off += len;
+        if (ch->off == ch->size) {
+            bootutil_img_hash_finish(&ch->hash_ctx, ch->hash);
+            ch->state = BOOT_COPY_HASH_DONE;
+        }
+    } else if (ch->state == BOOT_COPY_HASH_RUNNING || off < ch->size) {
+        /* Out of order, the slot will be hashed again. */
+        ch->state = BOOT_COPY_HASH_IDLE;
+    }
+}
+#endif
+
 /**
  * Copies the contents of one flash region to another.  You must erase the
- * destination region prior to calling this function.
+ * destination region prior to calling this function: chunks which only hold
+ * the erased value are not programmed at all.
+ *
+ * With MCUBOOT_USE_FLASH_ASYNC the copy runs as a two-buffer pipeline: while
+ * one chunk is being programmed through flash_area_write_submit(), the next
+ * one is read and decrypted into the other buffer.
  *
  * @param flash_area_id_src     The ID of the source flash area.
  * @param flash_area_id_dst     The ID of the destination flash area.
@@ -733,95 +1435,91 @@ boot_copy_region(struct boot_loader_state *state,
                  uint32_t off_src, uint32_t off_dst, uint32_t sz)
 {
     uint32_t bytes_copied;
-    int chunk_sz;
+    uint32_t chunk_sz;
+    uint8_t *buf;
+    uint8_t cur;
     int rc;
-#ifdef MCUBOOT_ENC_IMAGES
-    uint32_t off;
-    uint32_t tlv_off;
-    size_t blk_off;
-    struct image_header *hdr;
-    uint16_t idx;
-    uint32_t blk_sz;
-    uint8_t image_index;
+#ifdef MCUBOOT_USE_FLASH_ASYNC
+    bool pending;
+    int rc2;
 #endif
 
-    TARGET_STATIC uint8_t buf[1024];
-
-#if !defined(MCUBOOT_ENC_IMAGES)
-    (void)state;
+    cur = 0;
+    rc = 0;
+#ifdef MCUBOOT_USE_FLASH_ASYNC
+    pending = false;
 #endif
 
+    boot_trailer_cache_invalidate(fap_dst);
     bytes_copied = 0;
     while (bytes_copied < sz) {
-        if (sz - bytes_copied > sizeof buf) {
-            chunk_sz = sizeof buf;
+        if (sz - bytes_copied > BOOT_BUF_SZ) {
+            chunk_sz = BOOT_BUF_SZ;
         } else {
             chunk_sz = sz - bytes_copied;
         }
 
-        rc = flash_area_read(fap_src, off_src + bytes_copied, buf, chunk_sz);
+        buf = BOOT_BUF(state, cur);
+        rc = boot_copy_chunk_read(state, fap_src, fap_dst, off_src, off_dst,
+                                  bytes_copied, chunk_sz, buf);
         if (rc != 0) {
-            return BOOT_EFLASH;
+            break;
         }
 
-#ifdef MCUBOOT_ENC_IMAGES
-        image_index = BOOT_CURR_IMG(state);
-        if ((fap_src->fa_id == FLASH_AREA_IMAGE_SECONDARY(image_index) ||
-            fap_dst->fa_id == FLASH_AREA_IMAGE_SECONDARY(image_index)) &&
-            !(fap_src->fa_id == FLASH_AREA_IMAGE_SECONDARY(image_index) &&
-              fap_dst->fa_id == FLASH_AREA_IMAGE_SECONDARY(image_index))) {
-            /* assume the secondary slot as src, needs decryption */
-            hdr = boot_img_hdr(state, BOOT_SECONDARY_SLOT);
-#if !defined(MCUBOOT_SWAP_USING_MOVE)
-            off = off_src;
-            if (fap_dst->fa_id == FLASH_AREA_IMAGE_SECONDARY(image_index)) {
-                /* might need encryption (metadata from the primary slot) */
-                hdr = boot_img_hdr(state, BOOT_PRIMARY_SLOT);
-                off = off_dst;
-            }
-#else
-            off = off_dst;
-            if (fap_dst->fa_id == FLASH_AREA_IMAGE_SECONDARY(image_index)) {
-                hdr = boot_img_hdr(state, BOOT_PRIMARY_SLOT);
-            }
+#ifdef MCUBOOT_HASH_ON_COPY
+        boot_copy_hash_update(state, fap_dst, off_dst + bytes_copied, buf,
+                              chunk_sz);
 #endif
-            if (IS_ENCRYPTED(hdr)) {
-                blk_sz = chunk_sz;
-                idx = 0;
-                if (off + bytes_copied < hdr->ih_hdr_size) {
-                    /* do not decrypt header */
-                    blk_off = 0;
-                    blk_sz = chunk_sz - hdr->ih_hdr_size;
-                    idx = hdr->ih_hdr_size;
-                } else {
-                    blk_off = ((off + bytes_copied) - hdr->ih_hdr_size) & 0xf;
-                }
-                tlv_off = BOOT_TLV_OFF(hdr);
-                if (off + bytes_copied + chunk_sz > tlv_off) {
-                    /* do not decrypt TLVs */
-                    if (off + bytes_copied >= tlv_off) {
-                        blk_sz = 0;
-                    } else {
-                        blk_sz = tlv_off - (off + bytes_copied);
-                    }
-                }
-                boot_encrypt(BOOT_CURR_ENC(state), image_index, fap_src,
-                        (off + bytes_copied + idx) - hdr->ih_hdr_size, blk_sz,
-                        blk_off, &buf[idx]);
+
+        if (boot_buf_is_erased(fap_dst, buf, chunk_sz)) {
+            /* The destination already reads back as this data. */
+            bytes_copied += chunk_sz;
+            MCUBOOT_WATCHDOG_FEED();
+            continue;
+        }
+
+#ifdef MCUBOOT_USE_FLASH_ASYNC
+        if (pending) {
+            pending = false;
+            rc = flash_area_write_complete(fap_dst);
+            if (rc != 0) {
+                break;
             }
         }
-#endif
 
+        rc = flash_area_write_submit(fap_dst, off_dst + bytes_copied,
+                                     buf, chunk_sz);
+        if (rc != 0) {
+            break;
+        }
+        pending = true;
+        cur ^= 1;
+#else
         rc = flash_area_write(fap_dst, off_dst + bytes_copied, buf, chunk_sz);
         if (rc != 0) {
-            return BOOT_EFLASH;
+            break;
         }
+#endif
 
         bytes_copied += chunk_sz;
 
         MCUBOOT_WATCHDOG_FEED();
     }
 
+#ifdef MCUBOOT_USE_FLASH_ASYNC
+    /* Never leave a write in flight from a buffer that goes out of scope. */
+    if (pending) {
+        rc2 = flash_area_write_complete(fap_dst);
+        if (rc == 0) {
+            rc = rc2;
+        }
+    }
+#endif
+
+    if (rc != 0) {
+        return BOOT_EFLASH;
+    }
+
     return 0;
 }
 
@@ -842,11 +1540,10 @@ boot_copy_region(struct boot_loader_state *state,
 static int
 boot_copy_image(struct boot_loader_state *state, struct boot_status *bs)
 {
+    struct boot_sector_iter it;
     size_t sect_count;
-    size_t sect;
     int rc;
     size_t size;
-    size_t this_size;
     size_t last_sector;
     const struct flash_area *fap_primary_slot;
     const struct flash_area *fap_secondary_slot;
@@ -874,20 +1571,35 @@ boot_copy_image(struct boot_loader_state *state, struct boot_status *bs)
     assert (rc == 0);
 
     sect_count = boot_img_num_sectors(state, BOOT_PRIMARY_SLOT);
-    for (sect = 0, size = 0; sect < sect_count; sect++) {
-        this_size = boot_img_sector_size(state, BOOT_PRIMARY_SLOT, sect);
-        rc = boot_erase_region(fap_primary_slot, size, this_size);
-        assert(rc == 0);
-
-        size += this_size;
+    boot_sector_iter_init(&it, state, BOOT_PRIMARY_SLOT, 0);
+    for (size = 0; it.sector < sect_count; boot_sector_iter_next(&it)) {
+        size += it.size;
 
 #if defined(MCUBOOT_OVERWRITE_ONLY_FAST)
         if (size >= src_size) {
+            boot_sector_iter_next(&it);
             break;
         }
 #endif
     }
 
+    rc = boot_erase_sectors(state, fap_primary_slot, BOOT_PRIMARY_SLOT, 0,
+                            it.sector - 1);
+    assert(rc == 0);
+
+#if defined(MCUBOOT_VALIDATED_RECORD) && defined(MCUBOOT_OVERWRITE_ONLY_FAST)
+    /* The record of the image being replaced must not outlive it. */
+    while (it.sector < sect_count &&
+           it.off + it.size <= boot_validated_record_off(fap_primary_slot)) {
+        boot_sector_iter_next(&it);
+    }
+    if (it.sector < sect_count) {
+        rc = boot_erase_sectors(state, fap_primary_slot, BOOT_PRIMARY_SLOT,
+                                it.sector, sect_count - 1);
+        assert(rc == 0);
+    }
+#endif
+
 #ifdef MCUBOOT_ENC_IMAGES
     if (IS_ENCRYPTED(boot_img_hdr(state, BOOT_SECONDARY_SLOT))) {
         rc = boot_enc_load(BOOT_CURR_ENC(state), image_index,
@@ -905,6 +1617,9 @@ boot_copy_image(struct boot_loader_state *state, struct boot_status *bs)
 
     BOOT_LOG_INF("Copying the secondary slot to the primary slot: 0x%zx bytes",
                  size);
+#ifdef MCUBOOT_HASH_ON_COPY
+    boot_copy_hash_start(state);
+#endif
     rc = boot_copy_region(state, fap_secondary_slot, fap_primary_slot, 0, 0, size);
 
 #ifdef MCUBOOT_HW_ROLLBACK_PROT
@@ -1589,14 +2304,17 @@ context_boot_go(struct boot_loader_state *state, struct boot_rsp *rsp)
      * necessary because the gcc option "-fdata-sections" doesn't seem to have
      * any effect in older gcc versions (e.g., 4.8.4).
      */
+#ifdef BOOT_SECTOR_ARRAYS
     TARGET_STATIC boot_sector_t primary_slot_sectors[BOOT_IMAGE_NUMBER][BOOT_MAX_IMG_SECTORS];
     TARGET_STATIC boot_sector_t secondary_slot_sectors[BOOT_IMAGE_NUMBER][BOOT_MAX_IMG_SECTORS];
 #if MCUBOOT_SWAP_USING_SCRATCH
     TARGET_STATIC boot_sector_t scratch_sectors[BOOT_MAX_IMG_SECTORS];
+#endif
 #endif
 
     memset(state, 0, sizeof(struct boot_loader_state));
     has_upgrade = false;
+    boot_trailer_cache_enable(true);
 
 #if (BOOT_IMAGE_NUMBER == 1)
     (void)has_upgrade;
@@ -1607,23 +2325,16 @@ context_boot_go(struct boot_loader_state *state, struct boot_rsp *rsp)
      * completed.
      */
     IMAGES_ITER(BOOT_CURR_IMG(state)) {
-
-#if defined(MCUBOOT_ENC_IMAGES) && (BOOT_IMAGE_NUMBER > 1)
-        /* The keys used for encryption may no longer be valid (could belong to
-         * another images). Therefore, mark them as invalid to force their reload
-         * by boot_enc_load().
-         */
-        boot_enc_zeroize(BOOT_CURR_ENC(state));
-#endif
-
         image_index = BOOT_CURR_IMG(state);
 
+#ifdef BOOT_SECTOR_ARRAYS
         BOOT_IMG(state, BOOT_PRIMARY_SLOT).sectors =
             primary_slot_sectors[image_index];
         BOOT_IMG(state, BOOT_SECONDARY_SLOT).sectors =
             secondary_slot_sectors[image_index];
 #if MCUBOOT_SWAP_USING_SCRATCH
         state->scratch.sectors = scratch_sectors;
+#endif
 #endif
 
         /* Open primary and secondary image areas for the duration
@@ -1673,14 +2384,6 @@ context_boot_go(struct boot_loader_state *state, struct boot_rsp *rsp)
     IMAGES_ITER(BOOT_CURR_IMG(state)) {
 
 #if (BOOT_IMAGE_NUMBER > 1)
-#ifdef MCUBOOT_ENC_IMAGES
-        /* The keys used for encryption may no longer be valid (could belong to
-         * another images). Therefore, mark them as invalid to force their reload
-         * by boot_enc_load().
-         */
-        boot_enc_zeroize(BOOT_CURR_ENC(state));
-#endif /* MCUBOOT_ENC_IMAGES */
-
         /* Indicate that swap is not aborted */
         boot_status_reset(&bs);
 #endif /* (BOOT_IMAGE_NUMBER > 1) */
@@ -1726,11 +2429,22 @@ context_boot_go(struct boot_loader_state *state, struct boot_rsp *rsp)
         }
     }
 
+#if defined(MCUBOOT_VALIDATE_PRIMARY_SLOT) && defined(MCUBOOT_BATCH_VERIFY)
+    /* All required update operations have finished.  Re-validate every image
+     * in the primary slot before any of them is acted upon.
+     */
+    rc = boot_validate_primary_slots(state, &bs);
+    if (rc != 0) {
+        goto out;
+    }
+#endif
+
     /* Iterate over all the images. At this point all required update operations
      * have finished. By the end of the loop each image in the primary slot will
      * have been re-validated.
      */
     IMAGES_ITER(BOOT_CURR_IMG(state)) {
+#if !defined(MCUBOOT_VALIDATE_PRIMARY_SLOT) || !defined(MCUBOOT_BATCH_VERIFY)
         if (BOOT_SWAP_TYPE(state) != BOOT_SWAP_TYPE_NONE) {
             /* Attempt to read an image header from each slot. Ensure that image
              * headers in slots are aligned with headers in boot_data.
@@ -1765,6 +2479,7 @@ context_boot_go(struct boot_loader_state *state, struct boot_rsp *rsp)
             goto out;
         }
 #endif /* MCUBOOT_VALIDATE_PRIMARY_SLOT */
+#endif /* !MCUBOOT_VALIDATE_PRIMARY_SLOT || !MCUBOOT_BATCH_VERIFY */
 
 #ifdef MCUBOOT_HW_ROLLBACK_PROT
         /* Update the stored security counter with the active image's security
@@ -1827,6 +2542,12 @@ context_boot_go(struct boot_loader_state *state, struct boot_rsp *rsp)
 
 out:
     IMAGES_ITER(BOOT_CURR_IMG(state)) {
+#ifdef MCUBOOT_ENC_IMAGES
+        /* Each image keeps its own keys, so they are unwrapped at most once per
+         * boot.  Wipe them all before handing over to the application.
+         */
+        boot_enc_zeroize(BOOT_CURR_ENC(state));
+#endif
 #if MCUBOOT_SWAP_USING_SCRATCH
         flash_area_close(BOOT_SCRATCH_AREA(state));
 #endif
@@ -1834,6 +2555,7 @@ out:
             flash_area_close(BOOT_IMG_AREA(state, BOOT_NUM_SLOTS - 1 - slot));
         }
     }
+    boot_trailer_cache_enable(false);
     return rc;
 }
 
@@ -1854,18 +2576,22 @@ boot_go(struct boot_rsp *rsp)
 int
 split_go(int loader_slot, int split_slot, void **entry)
 {
+#ifdef BOOT_SECTOR_ARRAYS
     boot_sector_t *sectors;
+#endif
     uintptr_t entry_val;
     int loader_flash_id;
     int split_flash_id;
     int rc;
 
+#ifdef BOOT_SECTOR_ARRAYS
     sectors = malloc(BOOT_MAX_IMG_SECTORS * 2 * sizeof *sectors);
     if (sectors == NULL) {
         return SPLIT_GO_ERR;
     }
     BOOT_IMG(&boot_data, loader_slot).sectors = sectors + 0;
     BOOT_IMG(&boot_data, split_slot).sectors = sectors + BOOT_MAX_IMG_SECTORS;
+#endif
 
     loader_flash_id = flash_area_id_from_image_slot(loader_slot);
     rc = flash_area_open(loader_flash_id,
@@ -1892,7 +2618,8 @@ split_go(int loader_slot, int split_slot, void **entry)
      * bootable or non-bootable image.  Just validate that the image check
      * passes which is distinct from the normal check.
      */
-    rc = split_image_check(boot_img_hdr(&boot_data, split_slot),
+    rc = split_image_check(&boot_data,
+                           boot_img_hdr(&boot_data, split_slot),
                            BOOT_IMG_AREA(&boot_data, split_slot),
                            boot_img_hdr(&boot_data, loader_slot),
                            BOOT_IMG_AREA(&boot_data, loader_slot));
@@ -1909,6 +2636,8 @@ split_go(int loader_slot, int split_slot, void **entry)
 done:
     flash_area_close(BOOT_IMG_AREA(&boot_data, split_slot));
     flash_area_close(BOOT_IMG_AREA(&boot_data, loader_slot));
+#ifdef BOOT_SECTOR_ARRAYS
     free(sectors);
+#endif
     return rc;
 }
@@ -0,0 +1,360 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * SHA256 for MCUBOOT_USE_BOOTUTIL_SHA256.
+ *
+ * The context buffers partial blocks only; runs of whole blocks are passed
+ * straight from the caller's buffer to a block function.  The portable one
+ * is unrolled eight rounds at a time with a 16 word message schedule, which
+ * keeps the working variables in registers on Cortex-M.  On hosts (the
+ * simulator), the x86 SHA extensions and the ARMv8 cryptography extensions
+ * are used when available.
+ */
+
+#include <stddef.h>
+#include <string.h>
+
+#include "mcuboot_config/mcuboot_config.h"
+
+#ifdef MCUBOOT_USE_BOOTUTIL_SHA256
+
+#include "bootutil/sha256.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 5))
+#define SHA256_HAVE_SHANI
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) && \
+    (defined(__ARM_FEATURE_SHA2) || defined(__ARM_FEATURE_CRYPTO))
+#define SHA256_HAVE_ARMCE
+#include <arm_neon.h>
+#endif
+
+static const uint32_t sha256_k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
+    0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
+    0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+    0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
+    0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5,
+    0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+#define ROR(x, n)       (((x) >> (n)) | ((x) << (32 - (n))))
+#define CH(x, y, z)     ((z) ^ ((x) & ((y) ^ (z))))
+#define MAJ(x, y, z)    (((x) & (y)) | ((z) & ((x) | (y))))
+#define EP0(x)          (ROR(x, 2) ^ ROR(x, 13) ^ ROR(x, 22))
+#define EP1(x)          (ROR(x, 6) ^ ROR(x, 11) ^ ROR(x, 25))
+#define SIG0(x)         (ROR(x, 7) ^ ROR(x, 18) ^ ((x) >> 3))
+#define SIG1(x)         (ROR(x, 17) ^ ROR(x, 19) ^ ((x) >> 10))
+
+/* Message word i >= 16, computed in place of word i - 16. */
+#define SCHED(w, i)                                                     \
+    ((w)[(i) & 15] += SIG1((w)[((i) - 2) & 15]) + (w)[((i) - 7) & 15] + \
+                      SIG0((w)[((i) - 15) & 15]))
+
+/*
+ * One round; the caller rotates the roles of the working variables
+ * instead of moving their values.
+ */
+#define ROUND(a, b, c, d, e, f, g, h, i, wi) do {                       \
+    uint32_t t1 = (h) + EP1(e) + CH(e, f, g) + sha256_k[i] + (wi);     \
+    (d) += t1;                                                          \
+    (h) = t1 + EP0(a) + MAJ(a, b, c);                                   \
+} while (0)
+
+#define ROUNDS8(i, W) do {                                              \
+    ROUND(a, b, c, d, e, f, g, h, (i) + 0, W((i) + 0));                 \
+    ROUND(h, a, b, c, d, e, f, g, (i) + 1, W((i) + 1));                 \
+    ROUND(g, h, a, b, c, d, e, f, (i) + 2, W((i) + 2));                 \
+    ROUND(f, g, h, a, b, c, d, e, (i) + 3, W((i) + 3));                 \
+    ROUND(e, f, g, h, a, b, c, d, (i) + 4, W((i) + 4));                 \
+    ROUND(d, e, f, g, h, a, b, c, (i) + 5, W((i) + 5));                 \
+    ROUND(c, d, e, f, g, h, a, b, (i) + 6, W((i) + 6));                 \
+    ROUND(b, c, d, e, f, g, h, a, (i) + 7, W((i) + 7));                 \
+} while (0)
+
+#define WLOAD(i)        (w[i])
+#define WSCHED(i)       SCHED(w, i)
+
+static void
+sha256_blocks_c(uint32_t state[8], const uint8_t *data, uint32_t nblocks)
+{
+    uint32_t a, b, c, d, e, f, g, h;
+    uint32_t w[16];
+    int i;
+
+    while (nblocks-- > 0) {
+        for (i = 0; i < 16; i++, data += 4) {
+            w[i] = ((uint32_t)data[0] << 24) | ((uint32_t)data[1] << 16) |
+                   ((uint32_t)data[2] << 8) | data[3];
+        }
+
+        a = state[0];
+        b = state[1];
+        c = state[2];
+        d = state[3];
+        e = state[4];
+        f = state[5];
+        g = state[6];
+        h = state[7];
+
+        ROUNDS8(0, WLOAD);
+        ROUNDS8(8, WLOAD);
+        for (i = 16; i < 64; i += 8) {
+            ROUNDS8(i, WSCHED);
+        }
+
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        state[5] += f;
+        state[6] += g;
+        state[7] += h;
+    }
+}
+
+#ifdef SHA256_HAVE_SHANI
+static int
+sha256_shani_usable(void)
+{
+    unsigned int eax, ebx, ecx, edx;
+
+    /* SSSE3 and SSE4.1 are needed as well. */
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx) ||
+        !(ecx & (1 << 9)) || !(ecx & (1 << 19))) {
+        return 0;
+    }
+    if (__get_cpuid_max(0, NULL) < 7) {
+        return 0;
+    }
+    __cpuid_count(7, 0, eax, ebx, ecx, edx);
+
+    return (ebx & (1 << 29)) != 0;
+}
+
+/*
+ * Four rounds per iteration; the state is kept as ABEF/CDGH as
+ * sha256rnds2 expects.
+ */
+__attribute__((target("sha,sse4.1")))
+static void
+sha256_blocks_shani(uint32_t state[8], const uint8_t *data, uint32_t nblocks)
+{
+    const __m128i bswap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL,
+                                         0x0405060700010203ULL);
+    __m128i state0, state1, abef, cdgh, msg, tmp;
+    __m128i w[4];
+    int i;
+
+    tmp = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)&state[0]), 0xb1);
+    state1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)&state[4]),
+                               0x1b);
+    state0 = _mm_alignr_epi8(tmp, state1, 8);
+    state1 = _mm_blend_epi16(state1, tmp, 0xf0);
+
+    while (nblocks-- > 0) {
+        abef = state0;
+        cdgh = state1;
+
+        for (i = 0; i < 16; i++) {
+            if (i < 4) {
+                w[i] = _mm_shuffle_epi8(
+                        _mm_loadu_si128((const __m128i *)(data + 16 * i)),
+                        bswap);
+            } else {
+                tmp = _mm_sha256msg1_epu32(w[i & 3], w[(i + 1) & 3]);
+                tmp = _mm_add_epi32(tmp, _mm_alignr_epi8(w[(i + 3) & 3],
+                                                         w[(i + 2) & 3], 4));
+                w[i & 3] = _mm_sha256msg2_epu32(tmp, w[(i + 3) & 3]);
+            }
+            msg = _mm_add_epi32(w[i & 3],
+                    _mm_loadu_si128((const __m128i *)&sha256_k[4 * i]));
+            state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+            msg = _mm_shuffle_epi32(msg, 0x0e);
+            state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+        }
+
+        state0 = _mm_add_epi32(state0, abef);
+        state1 = _mm_add_epi32(state1, cdgh);
+        data += 64;
+    }
+
+    tmp = _mm_shuffle_epi32(state0, 0x1b);
+    state1 = _mm_shuffle_epi32(state1, 0xb1);
+    state0 = _mm_blend_epi16(tmp, state1, 0xf0);
+    state1 = _mm_alignr_epi8(state1, tmp, 8);
+    _mm_storeu_si128((__m128i *)&state[0], state0);
+    _mm_storeu_si128((__m128i *)&state[4], state1);
+}
+#endif /* SHA256_HAVE_SHANI */
+
+#ifdef SHA256_HAVE_ARMCE
+static void
+sha256_blocks_armce(uint32_t state[8], const uint8_t *data, uint32_t nblocks)
+{
+    uint32x4_t state0, state1, abcd, efgh, msg, tmp;
+    uint32x4_t w[4];
+    int i;
+
+    state0 = vld1q_u32(&state[0]);
+    state1 = vld1q_u32(&state[4]);
+
+    while (nblocks-- > 0) {
+        abcd = state0;
+        efgh = state1;
+
+        for (i = 0; i < 16; i++) {
+            if (i < 4) {
+                w[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + 16 * i)));
+            } else {
+                w[i & 3] = vsha256su1q_u32(
+                        vsha256su0q_u32(w[i & 3], w[(i + 1) & 3]),
+                        w[(i + 2) & 3], w[(i + 3) & 3]);
+            }
+            msg = vaddq_u32(w[i & 3], vld1q_u32(&sha256_k[4 * i]));
+            tmp = state0;
+            state0 = vsha256hq_u32(state0, state1, msg);
+            state1 = vsha256h2q_u32(state1, tmp, msg);
+        }
+
+        state0 = vaddq_u32(state0, abcd);
+        state1 = vaddq_u32(state1, efgh);
+        data += 64;
+    }
+
+    vst1q_u32(&state[0], state0);
+    vst1q_u32(&state[4], state1);
+}
+#endif /* SHA256_HAVE_ARMCE */
+
+static const struct bootutil_sha256_impl sha256_impls[] = {
+    { "c", sha256_blocks_c },
+#ifdef MCUBOOT_SHA256_PLATFORM_BLOCKS
+    { "platform", bootutil_sha256_platform_blocks },
+#endif
+#ifdef SHA256_HAVE_ARMCE
+    { "armv8-ce", sha256_blocks_armce },
+#endif
+#ifdef SHA256_HAVE_SHANI
+    { "sha-ni", sha256_blocks_shani },
+#endif
+};
+
+int
+bootutil_sha256_impls(const struct bootutil_sha256_impl **impls)
+{
+    int count;
+
+    *impls = sha256_impls;
+    count = sizeof sha256_impls / sizeof sha256_impls[0];
+#ifdef SHA256_HAVE_SHANI
+    if (!sha256_shani_usable()) {
+        count--;
+    }
+#endif
+
+    return count;
+}
+
+void
+bootutil_sha256_init(bootutil_sha256_context *ctx)
+{
+    const struct bootutil_sha256_impl *impls;
+    int count;
+
+    count = bootutil_sha256_impls(&impls);
+    ctx->blocks = impls[count - 1].blocks;
+
+    ctx->state[0] = 0x6a09e667;
+    ctx->state[1] = 0xbb67ae85;
+    ctx->state[2] = 0x3c6ef372;
+    ctx->state[3] = 0xa54ff53a;
+    ctx->state[4] = 0x510e527f;
+    ctx->state[5] = 0x9b05688c;
+    ctx->state[6] = 0x1f83d9ab;
+    ctx->state[7] = 0x5be0cd19;
+    ctx->len = 0;
+}
+
+void
+bootutil_sha256_update(bootutil_sha256_context *ctx, const void *data,
+                       uint32_t data_len)
+{
+    const uint8_t *p = data;
+    uint32_t used;
+    uint32_t n;
+
+    used = ctx->len & 63;
+    ctx->len += data_len;
+
+    if (used > 0) {
+        n = 64 - used;
+        if (n > data_len) {
+            n = data_len;
+        }
+        memcpy(&ctx->buf[used], p, n);
+        if (used + n < 64) {
+            return;
+        }
+        ctx->blocks(ctx->state, ctx->buf, 1);
+        p += n;
+        data_len -= n;
+    }
+
+    n = data_len / 64;
+    if (n > 0) {
+        ctx->blocks(ctx->state, p, n);
+        p += n * 64;
+        data_len -= n * 64;
+    }
+
+    if (data_len > 0) {
+        memcpy(ctx->buf, p, data_len);
+    }
+}
+
+void
+bootutil_sha256_finish(bootutil_sha256_context *ctx, uint8_t *output)
+{
+    uint64_t bits = ctx->len << 3;
+    uint32_t used = ctx->len & 63;
+    int i;
+
+    ctx->buf[used++] = 0x80;
+    if (used > 56) {
+        memset(&ctx->buf[used], 0, 64 - used);
+        ctx->blocks(ctx->state, ctx->buf, 1);
+        used = 0;
+    }
+    memset(&ctx->buf[used], 0, 56 - used);
+    for (i = 0; i < 8; i++) {
+        ctx->buf[63 - i] = (uint8_t)(bits >> (8 * i));
+    }
+    ctx->blocks(ctx->state, ctx->buf, 1);
+
+    for (i = 0; i < 8; i++) {
+        output[4 * i] = (uint8_t)(ctx->state[i] >> 24);
+        output[4 * i + 1] = (uint8_t)(ctx->state[i] >> 16);
+        output[4 * i + 2] = (uint8_t)(ctx->state[i] >> 8);
+        output[4 * i + 3] = (uint8_t)ctx->state[i];
+    }
+}
+
+#endif /* MCUBOOT_USE_BOOTUTIL_SHA256 */
@@ -35,12 +35,11 @@ int
 swap_erase_trailer_sectors(const struct boot_loader_state *state,
                            const struct flash_area *fap)
 {
+    struct boot_sector_iter it;
     uint8_t slot;
-    uint32_t sector;
+    uint32_t last_sector;
     uint32_t trailer_sz;
     uint32_t total_sz;
-    uint32_t off;
-    uint32_t sz;
     int fa_id_primary;
     int fa_id_secondary;
     uint8_t image_index;
@@ -62,19 +61,19 @@ swap_erase_trailer_sectors(const struct boot_loader_state *state,
         return BOOT_EFLASH;
     }
 
-    /* delete starting from last sector and moving to beginning */
-    sector = boot_img_num_sectors(state, slot) - 1;
+    /* find the sectors holding the trailer; they get deleted starting from
+     * the last sector and moving to beginning */
+    last_sector = boot_img_num_sectors(state, slot) - 1;
+    boot_sector_iter_init(&it, state, slot, last_sector);
     trailer_sz = boot_trailer_sz(BOOT_WRITE_SZ(state));
-    total_sz = 0;
-    do {
-        sz = boot_img_sector_size(state, slot, sector);
-        off = boot_img_sector_off(state, slot, sector);
-        rc = boot_erase_region(fap, off, sz);
-        assert(rc == 0);
+    total_sz = it.size;
+    while (total_sz < trailer_sz) {
+        boot_sector_iter_prev(&it);
+        total_sz += it.size;
+    }
 
-        sector--;
-        total_sz += sz;
-    } while (total_sz < trailer_sz);
+    rc = boot_erase_sectors(state, fap, slot, it.sector, last_sector);
+    assert(rc == 0);
 
     return rc;
 }
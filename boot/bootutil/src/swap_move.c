@@ -118,45 +118,32 @@ int
 swap_read_status_bytes(const struct flash_area *fap,
         struct boot_loader_state *state, struct boot_status *bs)
 {
-    uint32_t off;
-    uint8_t status;
+    struct boot_status_scan scan;
     int max_entries;
     int found_idx;
-    uint8_t write_sz;
     int move_entries;
-    int rc;
-    int last_rc;
     int erased_sections;
-    int i;
+    int rc;
 
     max_entries = boot_status_entries(BOOT_CURR_IMG(state), fap);
     if (max_entries < 0) {
         return BOOT_EBADARGS;
     }
 
-    erased_sections = 0;
-    found_idx = -1;
-    /* skip erased sectors at the end */
-    last_rc = 1;
-    write_sz = BOOT_WRITE_SZ(state);
-    off = boot_status_off(fap);
-    for (i = max_entries; i > 0; i--) {
-        rc = flash_area_read_is_empty(fap, off + (i - 1) * write_sz, &status, 1);
-        if (rc < 0) {
-            return BOOT_EFLASH;
-        }
+    rc = boot_scan_status(state, fap, max_entries, &scan);
+    if (rc != 0) {
+        return rc;
+    }
 
-        if (rc == 1) {
-            if (rc != last_rc) {
-                erased_sections++;
-            }
-        } else {
-            if (found_idx == -1) {
-                found_idx = i;
-            }
-        }
-        last_rc = rc;
+    /* The move and swap entries are two separate runs: only one erased
+     * section, between them or before the swap entries of an upgrade that
+     * needed no move, may precede the last written entry.
+     */
+    erased_sections = scan.gaps;
+    if (scan.first > 0) {
+        erased_sections++;
     }
+    found_idx = (scan.last >= 0) ? scan.last + 1 : -1;
 
     if (erased_sections > 1) {
         /* This means there was an error writing status on the last
@@ -210,8 +197,9 @@ boot_status_internal_off(const struct boot_status *bs, int elem_sz)
 int
 boot_slots_compatible(struct boot_loader_state *state)
 {
+    struct boot_sector_iter pri;
+    struct boot_sector_iter sec;
     size_t num_sectors;
-    size_t i;
 
     num_sectors = boot_img_num_sectors(state, BOOT_PRIMARY_SLOT);
     if (num_sectors != boot_img_num_sectors(state, BOOT_SECONDARY_SLOT)) {
@@ -224,9 +212,11 @@ boot_slots_compatible(struct boot_loader_state *state)
         return 0;
     }
 
-    for (i = 0; i < num_sectors; i++) {
-        if (boot_img_sector_size(state, BOOT_PRIMARY_SLOT, i) !=
-                boot_img_sector_size(state, BOOT_SECONDARY_SLOT, i)) {
+    boot_sector_iter_init(&pri, state, BOOT_PRIMARY_SLOT, 0);
+    boot_sector_iter_init(&sec, state, BOOT_SECONDARY_SLOT, 0);
+    for (; pri.sector < num_sectors; boot_sector_iter_next(&pri),
+                                     boot_sector_iter_next(&sec)) {
+        if (pri.size != sec.size) {
             BOOT_LOG_WRN("Cannot upgrade: not same sector layout");
             return 0;
         }
@@ -281,6 +271,16 @@ swap_status_source(struct boot_loader_state *state)
 
 /*
  * "Moves" the sector located at idx - 1 to idx.
+ *
+ * Like the swap states below, the move erases its destination again when
+ * resumed, so chunks that boot_copy_region() did not program because they
+ * only hold erased data are always consistent with the source.
+ *
+ * Every step of the move and of the swap is a plain copy, so when the
+ * destination already matches the source (MCUBOOT_SWAP_SKIP_IDENTICAL) the
+ * erase and copy are skipped; only the status gets written.  This stays
+ * correct on resume: an interrupted copy leaves a destination that differs
+ * from its source, and is redone.
  */
 static void
 boot_move_sector_up(int idx, uint32_t sz, struct boot_loader_state *state,
@@ -313,11 +313,13 @@ boot_move_sector_up(int idx, uint32_t sz, struct boot_loader_state *state,
         assert(rc == 0);
     }
 
-    rc = boot_erase_region(fap_pri, new_off, sz);
-    assert(rc == 0);
+    if (!boot_region_identical(state, fap_pri, old_off, fap_pri, new_off, sz)) {
+        rc = boot_erase_region(fap_pri, new_off, sz);
+        assert(rc == 0);
 
-    rc = boot_copy_region(state, fap_pri, fap_pri, old_off, new_off, sz);
-    assert(rc == 0);
+        rc = boot_copy_region(state, fap_pri, fap_pri, old_off, new_off, sz);
+        assert(rc == 0);
+    }
 
     rc = boot_write_status(state, bs);
 
@@ -340,11 +342,15 @@ boot_swap_sectors(int idx, uint32_t sz, struct boot_loader_state *state,
     sec_off = boot_img_sector_off(state, BOOT_SECONDARY_SLOT, idx - 1);
 
     if (bs->state == BOOT_STATUS_STATE_0) {
-        rc = boot_erase_region(fap_pri, pri_off, sz);
-        assert(rc == 0);
+        if (!boot_region_identical(state, fap_sec, sec_off, fap_pri, pri_off,
+                                   sz)) {
+            rc = boot_erase_region(fap_pri, pri_off, sz);
+            assert(rc == 0);
 
-        rc = boot_copy_region(state, fap_sec, fap_pri, sec_off, pri_off, sz);
-        assert(rc == 0);
+            rc = boot_copy_region(state, fap_sec, fap_pri, sec_off, pri_off,
+                                  sz);
+            assert(rc == 0);
+        }
 
         rc = boot_write_status(state, bs);
         bs->state = BOOT_STATUS_STATE_1;
@@ -352,11 +358,15 @@ boot_swap_sectors(int idx, uint32_t sz, struct boot_loader_state *state,
     }
 
     if (bs->state == BOOT_STATUS_STATE_1) {
-        rc = boot_erase_region(fap_sec, sec_off, sz);
-        assert(rc == 0);
+        if (!boot_region_identical(state, fap_pri, pri_up_off, fap_sec, sec_off,
+                                   sz)) {
+            rc = boot_erase_region(fap_sec, sec_off, sz);
+            assert(rc == 0);
 
-        rc = boot_copy_region(state, fap_pri, fap_sec, pri_up_off, sec_off, sz);
-        assert(rc == 0);
+            rc = boot_copy_region(state, fap_pri, fap_sec, pri_up_off, sec_off,
+                                  sz);
+            assert(rc == 0);
+        }
 
         rc = boot_write_status(state, bs);
         bs->idx++;
@@ -486,6 +496,13 @@ swap_run(struct boot_loader_state *state, struct boot_status *bs,
 
     bs->op = BOOT_STATUS_OP_SWAP;
 
+#ifdef MCUBOOT_HASH_ON_COPY
+    if (bs->idx == BOOT_STATUS_IDX_0 && bs->state == BOOT_STATUS_STATE_0) {
+        /* The new image is copied in order into the primary slot. */
+        boot_copy_hash_start(state);
+    }
+#endif
+
     idx = 1;
     while (idx <= g_last_idx) {
         if (idx >= bs->idx) {
@@ -89,43 +89,27 @@ int
 swap_read_status_bytes(const struct flash_area *fap,
         struct boot_loader_state *state, struct boot_status *bs)
 {
-    uint32_t off;
-    uint8_t status;
+    struct boot_status_scan scan;
     int max_entries;
-    int found;
     int found_idx;
     int invalid;
     int rc;
-    int i;
 
-    off = boot_status_off(fap);
     max_entries = boot_status_entries(BOOT_CURR_IMG(state), fap);
     if (max_entries < 0) {
         return BOOT_EBADARGS;
     }
 
-    found = 0;
-    found_idx = 0;
-    invalid = 0;
-    for (i = 0; i < max_entries; i++) {
-        rc = flash_area_read_is_empty(fap, off + i * BOOT_WRITE_SZ(state),
-                &status, 1);
-        if (rc < 0) {
-            return BOOT_EFLASH;
-        }
-
-        if (rc == 1) {
-            if (found && !found_idx) {
-                found_idx = i;
-            }
-        } else if (!found) {
-            found = 1;
-        } else if (found_idx) {
-            invalid = 1;
-            break;
-        }
+    rc = boot_scan_status(state, fap, max_entries, &scan);
+    if (rc != 0) {
+        return rc;
     }
 
+    /* Entries are written in order, so anything written after the first
+     * erased one means a status write went wrong.
+     */
+    invalid = (scan.gaps > 0);
+
     if (invalid) {
         /* This means there was an error writing status on the last
          * swap. Tell user and move on to validation!
@@ -142,12 +126,15 @@ swap_read_status_bytes(const struct flash_area *fap,
 #endif
     }
 
-    if (found) {
-        if (!found_idx) {
-            found_idx = i;
-        }
+    if (scan.first >= 0) {
+        found_idx = scan.first_gap;
         bs->idx = (found_idx / BOOT_STATUS_STATE_COUNT) + 1;
         bs->state = (found_idx % BOOT_STATUS_STATE_COUNT) + 1;
+#ifdef MCUBOOT_SWAP_SKIP_IDENTICAL
+        /* Resuming in the middle of an area which was being skipped. */
+        bs->skipped = (bs->state != BOOT_STATUS_STATE_0 &&
+                       (scan.gap_status & BOOT_STATUS_SKIPPED) != 0);
+#endif
     }
 
     return 0;
@@ -180,7 +167,8 @@ boot_slots_compatible(struct boot_loader_state *state)
 #ifndef MCUBOOT_OVERWRITE_ONLY
     size_t scratch_sz;
 #endif
-    size_t i, j;
+    struct boot_sector_iter pri;
+    struct boot_sector_iter sec;
     int8_t smaller;
 
     num_sectors_primary = boot_img_num_sectors(state, BOOT_PRIMARY_SLOT);
@@ -202,17 +190,20 @@ boot_slots_compatible(struct boot_loader_state *state)
      * number of a slot's sectors are able to fit into another, which only
      * excludes cases where sector sizes are not a multiple of each other.
      */
-    i = sz0 = primary_slot_sz = 0;
-    j = sz1 = secondary_slot_sz = 0;
+    boot_sector_iter_init(&pri, state, BOOT_PRIMARY_SLOT, 0);
+    boot_sector_iter_init(&sec, state, BOOT_SECONDARY_SLOT, 0);
+    sz0 = primary_slot_sz = 0;
+    sz1 = secondary_slot_sz = 0;
     smaller = 0;
-    while (i < num_sectors_primary || j < num_sectors_secondary) {
+    while (pri.sector < num_sectors_primary ||
+           sec.sector < num_sectors_secondary) {
         if (sz0 == sz1) {
-            sz0 += boot_img_sector_size(state, BOOT_PRIMARY_SLOT, i);
-            sz1 += boot_img_sector_size(state, BOOT_SECONDARY_SLOT, j);
-            i++;
-            j++;
+            sz0 += pri.size;
+            sz1 += sec.size;
+            boot_sector_iter_next(&pri);
+            boot_sector_iter_next(&sec);
         } else if (sz0 < sz1) {
-            sz0 += boot_img_sector_size(state, BOOT_PRIMARY_SLOT, i);
+            sz0 += pri.size;
             /* Guarantee that multiple sectors of the secondary slot
              * fit into the primary slot.
              */
@@ -221,9 +212,9 @@ boot_slots_compatible(struct boot_loader_state *state)
                 return 0;
             }
             smaller = 1;
-            i++;
+            boot_sector_iter_next(&pri);
         } else {
-            sz1 += boot_img_sector_size(state, BOOT_SECONDARY_SLOT, j);
+            sz1 += sec.size;
             /* Guarantee that multiple sectors of the primary slot
              * fit into the secondary slot.
              */
@@ -232,7 +223,7 @@ boot_slots_compatible(struct boot_loader_state *state)
                 return 0;
             }
             smaller = 2;
-            j++;
+            boot_sector_iter_next(&sec);
         }
 #ifndef MCUBOOT_OVERWRITE_ONLY
         if (sz0 == sz1) {
@@ -250,8 +241,8 @@ boot_slots_compatible(struct boot_loader_state *state)
 #endif
     }
 
-    if ((i != num_sectors_primary) ||
-        (j != num_sectors_secondary) ||
+    if ((pri.sector != num_sectors_primary) ||
+        (sec.sector != num_sectors_secondary) ||
         (primary_slot_sz != secondary_slot_sz)) {
         BOOT_LOG_WRN("Cannot upgrade: slots are not compatible");
         return 0;
@@ -438,37 +429,52 @@ static uint32_t
 boot_copy_sz(const struct boot_loader_state *state, int last_sector_idx,
              int *out_first_sector_idx)
 {
+    struct boot_sector_iter it;
     size_t scratch_sz;
     uint32_t new_sz;
     uint32_t sz;
-    int i;
 
     sz = 0;
 
     scratch_sz = boot_scratch_area_size(state);
-    for (i = last_sector_idx; i >= 0; i--) {
-        new_sz = sz + boot_img_sector_size(state, BOOT_PRIMARY_SLOT, i);
+    boot_sector_iter_init(&it, state, BOOT_PRIMARY_SLOT, last_sector_idx);
+    while (1) {
+        new_sz = sz + it.size;
         /*
          * The secondary slot is not being checked here, because
          * `boot_slots_compatible` already provides assurance that the copy size
          * will be compatible with the primary slot and scratch.
          */
         if (new_sz > scratch_sz) {
-            break;
+            /* This sector doesn't fit, exclude it. */
+            *out_first_sector_idx = it.sector + 1;
+            return sz;
         }
         sz = new_sz;
+
+        if (it.sector == 0) {
+            break;
+        }
+        boot_sector_iter_prev(&it);
     }
 
-    /* i currently refers to a sector that doesn't fit or it is -1 because all
-     * sectors have been processed.  In both cases, exclude sector i.
-     */
-    *out_first_sector_idx = i + 1;
+    /* All sectors have been processed. */
+    *out_first_sector_idx = 0;
     return sz;
 }
 
 /**
  * Swaps the contents of two flash regions within the two image slots.
  *
+ * Each state erases the region it copies into, also when an interrupted swap
+ * is resumed, so chunks left unprogrammed by boot_copy_region() because they
+ * only hold erased data are always consistent with the source.
+ *
+ * With MCUBOOT_SWAP_SKIP_IDENTICAL, areas which hold the same data in both
+ * slots are not copied at all.  Their status entries are written with
+ * BOOT_STATUS_SKIPPED, so that a resumed swap does not try to restore the
+ * primary slot from a scratch area that was never filled.
+ *
  * @param idx                   The index of the first sector in the range of
  *                                  sectors being swapped.
  * @param sz                    The number of bytes to swap.
@@ -530,6 +536,34 @@ boot_swap_sectors(int idx, uint32_t sz, struct boot_loader_state *state,
     rc = flash_area_open(FLASH_AREA_IMAGE_SCRATCH, &fap_scratch);
     assert (rc == 0);
 
+#ifdef MCUBOOT_SWAP_SKIP_IDENTICAL
+    /* The first area holds the trailer and is always swapped.  Other areas
+     * can only be compared before any of their data is modified.
+     */
+    if (bs->state == BOOT_STATUS_STATE_0) {
+        bs->skipped = (bs->idx != BOOT_STATUS_IDX_0 &&
+                       boot_region_identical(state, fap_primary_slot, img_off,
+                                             fap_secondary_slot, img_off, sz));
+    }
+
+    if (bs->skipped) {
+        BOOT_LOG_DBG("skipping identical area at 0x%x", (unsigned)img_off);
+        while (bs->state <= BOOT_STATUS_STATE_2) {
+            rc = boot_write_status(state, bs);
+            bs->state++;
+            BOOT_STATUS_ASSERT(rc == 0);
+        }
+        bs->skipped = 0;
+        bs->idx++;
+        bs->state = BOOT_STATUS_STATE_0;
+
+        flash_area_close(fap_primary_slot);
+        flash_area_close(fap_secondary_slot);
+        flash_area_close(fap_scratch);
+        return;
+    }
+#endif
+
     if (bs->state == BOOT_STATUS_STATE_0) {
         BOOT_LOG_DBG("erasing scratch area");
         rc = boot_erase_region(fap_scratch, 0, fap_scratch->fa_size);
@@ -667,17 +701,18 @@ void
 swap_run(struct boot_loader_state *state, struct boot_status *bs,
          uint32_t copy_size)
 {
+    struct boot_sector_iter pri;
+    struct boot_sector_iter sec;
     uint32_t sz;
     int first_sector_idx;
     int last_sector_idx;
     uint32_t swap_idx;
-    int last_idx_secondary_slot;
     uint32_t primary_slot_size;
     uint32_t secondary_slot_size;
     primary_slot_size = 0;
     secondary_slot_size = 0;
-    last_sector_idx = 0;
-    last_idx_secondary_slot = 0;
+    boot_sector_iter_init(&pri, state, BOOT_PRIMARY_SLOT, 0);
+    boot_sector_iter_init(&sec, state, BOOT_SECONDARY_SLOT, 0);
 
     /*
      * Knowing the size of the largest image between both slots, here we
@@ -688,24 +723,21 @@ swap_run(struct boot_loader_state *state, struct boot_status *bs,
     while (1) {
         if ((primary_slot_size < copy_size) ||
             (primary_slot_size < secondary_slot_size)) {
-           primary_slot_size += boot_img_sector_size(state,
-                                                     BOOT_PRIMARY_SLOT,
-                                                     last_sector_idx);
+           primary_slot_size += pri.size;
         }
         if ((secondary_slot_size < copy_size) ||
             (secondary_slot_size < primary_slot_size)) {
-           secondary_slot_size += boot_img_sector_size(state,
-                                                       BOOT_SECONDARY_SLOT,
-                                                       last_idx_secondary_slot);
+           secondary_slot_size += sec.size;
         }
         if (primary_slot_size >= copy_size &&
                 secondary_slot_size >= copy_size &&
                 primary_slot_size == secondary_slot_size) {
             break;
         }
-        last_sector_idx++;
-        last_idx_secondary_slot++;
+        boot_sector_iter_next(&pri);
+        boot_sector_iter_next(&sec);
     }
+    last_sector_idx = pri.sector;
 
     swap_idx = 0;
     while (last_sector_idx >= 0) {
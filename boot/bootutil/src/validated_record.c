@@ -0,0 +1,163 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stddef.h>
+#include <string.h>
+
+#include "mcuboot_config/mcuboot_config.h"
+
+#ifdef MCUBOOT_VALIDATED_RECORD
+
+#include "bootutil/bootutil.h"
+#include "bootutil/image.h"
+#include "bootutil/sha256.h"
+#include "bootutil/validated_record.h"
+#include "bootutil_priv.h"
+
+#define BOOT_HMAC_BLOCK_SZ  64
+
+/*
+ * HMAC-SHA256 of the header, the image hash TLV and the index of an image.
+ */
+static int
+boot_validated_record_mac(uint8_t image_index, const struct image_header *hdr,
+                          const uint8_t *img_hash, uint8_t *mac)
+{
+    bootutil_sha256_context sha256_ctx;
+    uint8_t pad[BOOT_HMAC_BLOCK_SZ];
+    uint8_t inner[32];
+    const uint8_t *key;
+    uint32_t key_len;
+    uint32_t i;
+
+    if (boot_validated_record_key_get(&key, &key_len) != 0 ||
+        key_len == 0 || key_len > BOOT_HMAC_BLOCK_SZ) {
+        return -1;
+    }
+
+    memset(pad, 0x36, sizeof pad);
+    for (i = 0; i < key_len; i++) {
+        pad[i] ^= key[i];
+    }
+    bootutil_sha256_init(&sha256_ctx);
+    bootutil_sha256_update(&sha256_ctx, pad, sizeof pad);
+    bootutil_sha256_update(&sha256_ctx, hdr, sizeof *hdr);
+    bootutil_sha256_update(&sha256_ctx, img_hash, BOOTUTIL_IMG_HASH_SIZE);
+    bootutil_sha256_update(&sha256_ctx, &image_index, 1);
+    bootutil_sha256_finish(&sha256_ctx, inner);
+
+    memset(pad, 0x5c, sizeof pad);
+    for (i = 0; i < key_len; i++) {
+        pad[i] ^= key[i];
+    }
+    bootutil_sha256_init(&sha256_ctx);
+    bootutil_sha256_update(&sha256_ctx, pad, sizeof pad);
+    bootutil_sha256_update(&sha256_ctx, inner, sizeof inner);
+    bootutil_sha256_finish(&sha256_ctx, mac);
+
+    memset(pad, 0, sizeof pad);
+    memset(inner, 0, sizeof inner);
+
+    return 0;
+}
+
+/*
+ * Computes the record of the image in a slot, from its header and the
+ * content of its image hash TLV.
+ */
+static int
+boot_validated_record_compute(uint8_t image_index, struct image_header *hdr,
+                              const struct flash_area *fap, uint8_t *record)
+{
+    struct image_tlv_iter it;
+    uint8_t img_hash[BOOTUTIL_IMG_HASH_SIZE];
+    uint32_t off;
+    uint16_t len;
+    int rc;
+
+    rc = bootutil_tlv_iter_begin(&it, hdr, fap, BOOTUTIL_IMG_HASH_TLV, false);
+    if (rc != 0) {
+        return -1;
+    }
+
+    rc = bootutil_tlv_iter_next(&it, &off, &len, NULL);
+    if (rc != 0 || len != sizeof img_hash) {
+        return -1;
+    }
+
+    rc = flash_area_read(fap, off, img_hash, sizeof img_hash);
+    if (rc != 0) {
+        return -1;
+    }
+
+    return boot_validated_record_mac(image_index, hdr, img_hash, record);
+}
+
+/**
+ * Checks the validated record of the image in a slot.
+ *
+ * @return                      0 if the record matches the image;
+ *                              1 if there is no record;
+ *                              -1 if the record doesn't match or on error.
+ */
+int
+boot_validated_record_check(uint8_t image_index, struct image_header *hdr,
+                            const struct flash_area *fap)
+{
+    uint8_t record[BOOT_VALIDATED_RECORD_SZ];
+    uint8_t expected[BOOT_VALIDATED_RECORD_SZ];
+    uint8_t diff;
+    size_t i;
+    int rc;
+
+    rc = flash_area_read_is_empty(fap, boot_validated_record_off(fap),
+                                  record, sizeof record);
+    if (rc < 0) {
+        return -1;
+    } else if (rc == 1) {
+        return 1;
+    }
+
+    rc = boot_validated_record_compute(image_index, hdr, fap, expected);
+    if (rc != 0) {
+        return -1;
+    }
+
+    diff = 0;
+    for (i = 0; i < sizeof record; i++) {
+        diff |= record[i] ^ expected[i];
+    }
+
+    return diff == 0 ? 0 : -1;
+}
+
+/**
+ * Writes the validated record of the image in a slot, which must have been
+ * fully validated, to the slot's erased trailer.
+ *
+ * @return                      0 on success; nonzero on failure.
+ */
+int
+boot_validated_record_write(uint8_t image_index, struct image_header *hdr,
+                            const struct flash_area *fap)
+{
+    uint8_t record[BOOT_VALIDATED_RECORD_SZ];
+    int rc;
+
+    rc = boot_validated_record_compute(image_index, hdr, fap, record);
+    if (rc != 0) {
+        return -1;
+    }
+
+    boot_trailer_cache_invalidate(fap);
+    rc = flash_area_write(fap, boot_validated_record_off(fap), record,
+                          sizeof record);
+    if (rc != 0) {
+        return BOOT_EFLASH;
+    }
+
+    return 0;
+}
+
+#endif /* MCUBOOT_VALIDATED_RECORD */
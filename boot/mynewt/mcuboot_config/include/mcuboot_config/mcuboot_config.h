@@ -32,12 +32,33 @@
 #if MYNEWT_VAL(BOOTUTIL_VALIDATE_SLOT0)
 #define MCUBOOT_VALIDATE_PRIMARY_SLOT 1
 #endif
+#if MYNEWT_VAL(BOOTUTIL_HASH_CHUNKS)
+#define MCUBOOT_HASH_CHUNKS 1
+#endif
+#if MYNEWT_VAL(BOOTUTIL_VALIDATED_RECORD)
+#define MCUBOOT_VALIDATED_RECORD 1
+#endif
+#if MYNEWT_VAL(BOOTUTIL_HASH_ON_COPY)
+#define MCUBOOT_HASH_ON_COPY 1
+#endif
+#if MYNEWT_VAL(BOOTUTIL_BATCH_VERIFY)
+#define MCUBOOT_BATCH_VERIFY 1
+#endif
 #if MYNEWT_VAL(BOOTUTIL_USE_MBED_TLS)
 #define MCUBOOT_USE_MBED_TLS 1
 #endif
 #if MYNEWT_VAL(BOOTUTIL_USE_TINYCRYPT)
 #define MCUBOOT_USE_TINYCRYPT 1
 #endif
+#if MYNEWT_VAL(BOOTUTIL_USE_BOOTUTIL_SHA256)
+#define MCUBOOT_USE_BOOTUTIL_SHA256 1
+#endif
+#if MYNEWT_VAL(BOOTUTIL_SHA384)
+#define MCUBOOT_SHA384 1
+#endif
+#if MYNEWT_VAL(BOOTUTIL_SHA512)
+#define MCUBOOT_SHA512 1
+#endif
 #if MYNEWT_VAL(BOOTUTIL_SIGN_EC256)
 #define MCUBOOT_SIGN_EC256 1
   #ifndef MCUBOOT_USE_TINYCRYPT
@@ -51,6 +72,10 @@
 #if MYNEWT_VAL(BOOTUTIL_SIGN_ED25519)
 #define MCUBOOT_SIGN_ED25519 1
 #endif
+#define MCUBOOT_ED25519_CACHED_KEYS MYNEWT_VAL(BOOTUTIL_ED25519_CACHED_KEYS)
+#if MYNEWT_VAL(BOOTUTIL_ED25519_LARGE_B_TABLE)
+#define MCUBOOT_ED25519_LARGE_B_TABLE 1
+#endif
 #if MYNEWT_VAL(BOOTUTIL_SIGN_EC)
 #define MCUBOOT_SIGN_EC 1
 #endif
@@ -60,16 +85,25 @@
 #if MYNEWT_VAL(BOOTUTIL_ENCRYPT_KW)
 #define MCUBOOT_ENCRYPT_KW 1
 #endif
+#if MYNEWT_VAL(BOOTUTIL_AES_256)
+#define MCUBOOT_AES_256 1
+#endif
 #if MYNEWT_VAL(BOOTUTIL_ENCRYPT_EC256)
 #define MCUBOOT_ENCRYPT_EC256 1
 #endif
+#if MYNEWT_VAL(BOOTUTIL_ENCRYPT_X25519)
+#define MCUBOOT_ENCRYPT_X25519 1
+#endif
 #if MYNEWT_VAL(BOOTUTIL_ENCRYPT_RSA) || MYNEWT_VAL(BOOTUTIL_ENCRYPT_KW) || \
-    MYNEWT_VAL(BOOTUTIL_ENCRYPT_EC256)
+    MYNEWT_VAL(BOOTUTIL_ENCRYPT_EC256) || MYNEWT_VAL(BOOTUTIL_ENCRYPT_X25519)
 #define MCUBOOT_ENC_IMAGES 1
 #endif
 #if MYNEWT_VAL(BOOTUTIL_SWAP_USING_MOVE)
 #define MCUBOOT_SWAP_USING_MOVE 1
 #endif
+#if MYNEWT_VAL(BOOTUTIL_SWAP_SKIP_IDENTICAL)
+#define MCUBOOT_SWAP_SKIP_IDENTICAL 1
+#endif
 #if MYNEWT_VAL(BOOTUTIL_SWAP_SAVE_ENCTLV)
 #define MCUBOOT_SWAP_SAVE_ENCTLV 1
 #endif
@@ -87,6 +121,18 @@
 #endif
 
 #define MCUBOOT_MAX_IMG_SECTORS       MYNEWT_VAL(BOOTUTIL_MAX_IMG_SECTORS)
+#if MYNEWT_VAL(BOOTUTIL_UNIFORM_SECTOR_SIZE) > 0
+#define MCUBOOT_UNIFORM_SECTOR_SIZE   MYNEWT_VAL(BOOTUTIL_UNIFORM_SECTOR_SIZE)
+#endif
+#if MYNEWT_VAL(BOOTUTIL_MAX_SECTOR_RUNS) > 0
+#define MCUBOOT_MAX_SECTOR_RUNS       MYNEWT_VAL(BOOTUTIL_MAX_SECTOR_RUNS)
+#endif
+#define MCUBOOT_BUF_SZ                MYNEWT_VAL(BOOTUTIL_BUF_SIZE)
+#define MCUBOOT_BUF_ALIGN             MYNEWT_VAL(BOOTUTIL_BUF_ALIGN)
+#if MYNEWT_VAL(BOOTUTIL_BUF_ALIGN) > 8
+#define MCUBOOT_BUF_ALIGN_ATTR \
+    __attribute__((aligned(MYNEWT_VAL(BOOTUTIL_BUF_ALIGN))))
+#endif
 
 #if MYNEWT_VAL(BOOTUTIL_FEED_WATCHDOG) && MYNEWT_VAL(WATCHDOG_INTERVAL)
 #include <hal/hal_watchdog.h>
@@ -132,3 +132,13 @@ int flash_area_read_is_empty(const struct flash_area *fa, uint32_t off,
 
     return 1;
 }
+
+#ifdef MCUBOOT_USE_FLASH_MAPPED
+const void *flash_area_get_mapped(const struct flash_area *fa)
+{
+    if (fa->fa_device_id != FLASH_DEVICE_ID) {
+        return NULL;
+    }
+    return (const void *)(FLASH_DEVICE_BASE + fa->fa_off);
+}
+#endif
@@ -90,6 +90,36 @@ uint8_t flash_area_erased_val(const struct flash_area *fap);
 int flash_area_read_is_empty(const struct flash_area *fa, uint32_t off,
         void *dst, uint32_t len);
 
+/*
+ * Returns the sizes of the blocks the device holding the area can erase in
+ * a single operation, as a mask where bit n set means that blocks of 2^n
+ * bytes, aligned on their size from the start of the device, are supported.
+ * Only required with MCUBOOT_USE_FLASH_ERASE_SIZES.
+ */
+uint32_t flash_area_erase_sizes(const struct flash_area *fa);
+
+/*
+ * Returns the address the start of the area can be read at through the CPU's
+ * memory map, or NULL if the area is not memory mapped.  Only required with
+ * MCUBOOT_USE_FLASH_MAPPED.
+ */
+const void *flash_area_get_mapped(const struct flash_area *fa);
+
+/*
+ * Asynchronous write interface, only required with MCUBOOT_USE_FLASH_ASYNC.
+ *
+ * flash_area_write_submit() starts programming len bytes from src at off
+ * and may return before the operation has finished; src must stay valid
+ * until then.  flash_area_write_complete() waits for the write previously
+ * submitted on the area to finish.  At most one write is submitted at a
+ * time per area.
+ *
+ * Both return 0 on success, or an error code on failure.
+ */
+int flash_area_write_submit(const struct flash_area *fa, uint32_t off,
+        const void *src, uint32_t len);
+int flash_area_write_complete(const struct flash_area *fa);
+
 #ifdef __cplusplus
 }
 #endif
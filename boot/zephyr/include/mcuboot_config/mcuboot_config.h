@@ -44,10 +44,54 @@
 #endif
 #endif
 
+#ifdef CONFIG_BOOT_USE_BOOTUTIL_SHA256
+#define MCUBOOT_USE_BOOTUTIL_SHA256
+#endif
+
+#if defined(CONFIG_BOOT_IMG_HASH_SHA384)
+#define MCUBOOT_SHA384
+#elif defined(CONFIG_BOOT_IMG_HASH_SHA512)
+#define MCUBOOT_SHA512
+#endif
+
+#ifdef CONFIG_BOOT_ED25519_CACHED_KEYS
+#define MCUBOOT_ED25519_CACHED_KEYS CONFIG_BOOT_ED25519_CACHED_KEYS
+#endif
+
+#ifdef CONFIG_BOOT_ED25519_LARGE_B_TABLE
+#define MCUBOOT_ED25519_LARGE_B_TABLE
+#endif
+
+#ifdef CONFIG_BOOT_SIG_VERIFY_TIMING
+#include <kernel.h>
+#define MCUBOOT_SIG_VERIFY_TIMING
+#define MCUBOOT_CYCLE_COUNT()         k_cycle_get_32()
+#endif
+
 #ifdef CONFIG_BOOT_VALIDATE_SLOT0
 #define MCUBOOT_VALIDATE_PRIMARY_SLOT
 #endif
 
+#ifdef CONFIG_BOOT_HASH_CHUNKS
+#define MCUBOOT_HASH_CHUNKS
+#endif
+
+#ifdef CONFIG_BOOT_VALIDATED_RECORD
+#define MCUBOOT_VALIDATED_RECORD
+#endif
+
+#ifdef CONFIG_BOOT_HASH_ON_COPY
+#define MCUBOOT_HASH_ON_COPY
+#endif
+
+#ifdef CONFIG_BOOT_BATCH_VERIFY
+#define MCUBOOT_BATCH_VERIFY
+#endif
+
+#ifdef CONFIG_BOOT_FLASH_MAPPED
+#define MCUBOOT_USE_FLASH_MAPPED
+#endif
+
 #ifdef CONFIG_BOOT_UPGRADE_ONLY
 #define MCUBOOT_OVERWRITE_ONLY
 #define MCUBOOT_OVERWRITE_ONLY_FAST
@@ -57,6 +101,10 @@
 #define MCUBOOT_SWAP_USING_MOVE 1
 #endif
 
+#ifdef CONFIG_BOOT_SWAP_SKIP_IDENTICAL
+#define MCUBOOT_SWAP_SKIP_IDENTICAL 1
+#endif
+
 #ifdef CONFIG_LOG
 #define MCUBOOT_HAVE_LOGGING 1
 #endif
@@ -70,11 +118,20 @@
 #define MCUBOOT_ENCRYPT_RSA
 #endif
 
+#ifdef CONFIG_BOOT_ENCRYPT_AES_256
+#define MCUBOOT_AES_256
+#endif
+
 #ifdef CONFIG_BOOT_ENCRYPT_EC256
 #define MCUBOOT_ENC_IMAGES
 #define MCUBOOT_ENCRYPT_EC256
 #endif
 
+#ifdef CONFIG_BOOT_ENCRYPT_X25519
+#define MCUBOOT_ENC_IMAGES
+#define MCUBOOT_ENCRYPT_X25519
+#endif
+
 #ifdef CONFIG_BOOT_BOOTSTRAP
 #define MCUBOOT_BOOTSTRAP 1
 #endif
@@ -116,6 +173,20 @@
 
 #define MCUBOOT_MAX_IMG_SECTORS       CONFIG_BOOT_MAX_IMG_SECTORS
 
+#if CONFIG_BOOT_UNIFORM_SECTOR_SIZE > 0
+#define MCUBOOT_UNIFORM_SECTOR_SIZE   CONFIG_BOOT_UNIFORM_SECTOR_SIZE
+#endif
+
+#if CONFIG_BOOT_MAX_SECTOR_RUNS > 0
+#define MCUBOOT_MAX_SECTOR_RUNS       CONFIG_BOOT_MAX_SECTOR_RUNS
+#endif
+
+#define MCUBOOT_BUF_SZ                CONFIG_BOOT_BUF_SIZE
+#define MCUBOOT_BUF_ALIGN             CONFIG_BOOT_BUF_ALIGN
+#if CONFIG_BOOT_BUF_ALIGN > 8
+#define MCUBOOT_BUF_ALIGN_ATTR        __aligned(CONFIG_BOOT_BUF_ALIGN)
+#endif
+
 #endif /* !__BOOTSIM__ */
 
 #define MCUBOOT_WATCHDOG_FEED()         \
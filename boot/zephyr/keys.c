@@ -32,22 +32,29 @@
 #define HAVE_KEYS
 extern const unsigned char rsa_pub_key[];
 extern unsigned int rsa_pub_key_len;
+extern const unsigned char rsa_pub_key_hash[];
+extern const struct bootutil_rsa_key rsa_pub_key_mont;
 #elif defined(MCUBOOT_SIGN_EC256)
 #define HAVE_KEYS
 extern const unsigned char ecdsa_pub_key[];
 extern unsigned int ecdsa_pub_key_len;
+extern const unsigned char ecdsa_pub_key_hash[];
 #elif defined(MCUBOOT_SIGN_ED25519)
 #define HAVE_KEYS
 extern const unsigned char ed25519_pub_key[];
 extern unsigned int ed25519_pub_key_len;
+extern const unsigned char ed25519_pub_key_hash[];
 #else
 #error "No public key available for given signing algorithm."
 #endif
 
 /*
- * NOTE: *_pub_key and *_pub_key_len are autogenerated based on the provided
- *       key file. If no key file was configured, the array and length must be
- *       provided and added to the build manually.
+ * NOTE: *_pub_key, *_pub_key_len, *_pub_key_hash and rsa_pub_key_mont are
+ *       autogenerated based on the provided key file, and
+ *       MCUBOOT_PUB_KEY_HASH is then defined.  If no key file was
+ *       configured, the array and length must be provided and added to the
+ *       build manually; the key hash is then computed at boot, and RSA keys
+ *       are parsed for each signature.
  */
 #if defined(HAVE_KEYS)
 const struct bootutil_key bootutil_keys[] = {
@@ -55,12 +62,22 @@ const struct bootutil_key bootutil_keys[] = {
 #if defined(MCUBOOT_SIGN_RSA)
         .key = rsa_pub_key,
         .len = &rsa_pub_key_len,
+#ifdef MCUBOOT_PUB_KEY_HASH
+        .hash = rsa_pub_key_hash,
+        .rsa = &rsa_pub_key_mont,
+#endif
 #elif defined(MCUBOOT_SIGN_EC256)
         .key = ecdsa_pub_key,
         .len = &ecdsa_pub_key_len,
+#ifdef MCUBOOT_PUB_KEY_HASH
+        .hash = ecdsa_pub_key_hash,
+#endif
 #elif defined(MCUBOOT_SIGN_ED25519)
         .key = ed25519_pub_key,
         .len = &ed25519_pub_key_len,
+#ifdef MCUBOOT_PUB_KEY_HASH
+        .hash = ed25519_pub_key_hash,
+#endif
 #endif
     },
 };
@@ -190,6 +207,18 @@ const struct bootutil_key bootutil_enc_key = {
     .key = enc_priv_key,
     .len = &enc_priv_key_len,
 };
+#elif defined(MCUBOOT_ENCRYPT_X25519)
+unsigned char enc_priv_key[] = {
+  0x30, 0x2e, 0x02, 0x01, 0x00, 0x30, 0x05, 0x06, 0x03, 0x2b, 0x65, 0x6e,
+  0x04, 0x22, 0x04, 0x20, 0xa0, 0xd0, 0xe9, 0xab, 0x78, 0x66, 0xb9, 0xde,
+  0x12, 0x4c, 0xd8, 0xef, 0x3c, 0xeb, 0xab, 0x74, 0x6d, 0x3f, 0x92, 0x71,
+  0xe9, 0x8b, 0xe0, 0x98, 0xbd, 0xc6, 0xad, 0xdb, 0xae, 0x7a, 0x41, 0x51,
+};
+static unsigned int enc_priv_key_len = 48;
+const struct bootutil_key bootutil_enc_key = {
+    .key = enc_priv_key,
+    .len = &enc_priv_key_len,
+};
 #elif defined(MCUBOOT_ENCRYPT_KW)
 #error "Encrypted images with AES-KW is not implemented yet."
 #endif
@@ -45,6 +45,17 @@
 #include "curve25519.h"
 // Various pre-computed constants.
 #include "curve25519_tables.h"
+#if defined(MCUBOOT_ED25519_LARGE_B_TABLE)
+// Odd multiples of B up to 63B, for width 7 signed digits of b.
+#include "curve25519_b_table.h"
+#define B_SLIDE_MAX 63
+#else
+#define B_SLIDE_MAX 15
+#endif
+
+#ifndef MCUBOOT_ED25519_CACHED_KEYS
+#define MCUBOOT_ED25519_CACHED_KEYS 1
+#endif
 
 #define SHA512_DIGEST_LENGTH 64
 
@@ -590,7 +601,9 @@ void x25519_ge_sub(ge_p1p1 *r, const ge_p3 *p, const ge_cached *q) {
   fe_add(&r->T, &trZ, &trT);
 }
 
-static void slide(signed char *r, const uint8_t *a) {
+// Recodes a into signed odd digits of absolute value at most |max|, each
+// followed by enough zero digits that r is a sliding window expansion of a.
+static void slide(signed char *r, const uint8_t *a, int max) {
   int i;
   int b;
   int k;
@@ -603,10 +616,10 @@ static void slide(signed char *r, const uint8_t *a) {
     if (r[i]) {
       for (b = 1; b <= 6 && i + b < 256; ++b) {
         if (r[i + b]) {
-          if (r[i] + (r[i + b] << b) <= 15) {
+          if (r[i] + (r[i + b] << b) <= max) {
             r[i] += r[i + b] << b;
             r[i + b] = 0;
-          } else if (r[i] - (r[i + b] << b) >= -15) {
+          } else if (r[i] - (r[i + b] << b) >= -max) {
             r[i] -= r[i + b] << b;
             for (k = i + b; k < 256; ++k) {
               if (!r[k]) {
@@ -624,6 +637,17 @@ static void slide(signed char *r, const uint8_t *a) {
   }
 }
 
+// Returns (2*i+1)*B.
+static const ge_precomp *ge_b_multiple(int i) {
+#if defined(MCUBOOT_ED25519_LARGE_B_TABLE)
+  if (i >= 8) {
+    return &Bi_large[i - 8];
+  }
+#endif
+  return &Bi[i];
+}
+
+#if !defined(MCUBOOT_BATCH_VERIFY)
 // r = a * A + b * B
 // where a = a[0]+256*a[1]+...+256^31 a[31].
 // and b = b[0]+256*b[1]+...+256^31 b[31].
@@ -638,8 +662,8 @@ static void ge_double_scalarmult_vartime(ge_p2 *r, const uint8_t *a,
   ge_p3 A2;
   int i;
 
-  slide(aslide, a);
-  slide(bslide, b);
+  slide(aslide, a, 15);
+  slide(bslide, b, B_SLIDE_MAX);
 
   x25519_ge_p3_to_cached(&Ai[0], A);
   ge_p3_dbl(&t, A);
@@ -687,15 +711,16 @@ static void ge_double_scalarmult_vartime(ge_p2 *r, const uint8_t *a,
 
     if (bslide[i] > 0) {
       x25519_ge_p1p1_to_p3(&u, &t);
-      ge_madd(&t, &u, &Bi[bslide[i] / 2]);
+      ge_madd(&t, &u, ge_b_multiple(bslide[i] / 2));
     } else if (bslide[i] < 0) {
       x25519_ge_p1p1_to_p3(&u, &t);
-      ge_msub(&t, &u, &Bi[(-bslide[i]) / 2]);
+      ge_msub(&t, &u, ge_b_multiple((-bslide[i]) / 2));
     }
 
     x25519_ge_p1p1_to_p2(r, &t);
   }
 }
+#endif
 
 // int64_lshift21 returns |a << 21| but is defined when shifting bits into the
 // sign bit. This works around a language flaw in C.
@@ -1046,32 +1071,125 @@ void x25519_sc_reduce(uint8_t s[64]) {
   s[31] = s11 >> 17;
 }
 
-int ED25519_verify(const uint8_t *message, size_t message_len,
-                   const uint8_t signature[64], const uint8_t public_key[32]) {
+#if MCUBOOT_ED25519_CACHED_KEYS > 0
+// Public keys last decompressed by ED25519_verify, already negated.  The
+// boot loader checks every image against the same few keys, and decoding
+// one takes a field exponentiation.
+struct ed25519_key_cache {
+  uint8_t valid;
+  uint8_t public_key[32];
   ge_p3 A;
-  if ((signature[63] & 224) != 0 ||
-      !x25519_ge_frombytes_vartime(&A, public_key)) {
+};
+
+#ifdef __BOOTSIM__
+// The simulator runs one boot loader per thread.
+static __thread struct ed25519_key_cache key_cache[MCUBOOT_ED25519_CACHED_KEYS];
+static __thread unsigned key_cache_next;
+#else
+static struct ed25519_key_cache key_cache[MCUBOOT_ED25519_CACHED_KEYS];
+static unsigned key_cache_next;
+#endif
+#endif
+
+// Sets A to minus the point encoded by public_key.  Returns 0 if it isn't a
+// point of the curve.
+static int ge_public_key_neg(ge_p3 *A, const uint8_t public_key[32]) {
+#if MCUBOOT_ED25519_CACHED_KEYS > 0
+  struct ed25519_key_cache *entry;
+  unsigned i;
+
+  for (i = 0; i < MCUBOOT_ED25519_CACHED_KEYS; i++) {
+    if (key_cache[i].valid &&
+        memcmp(key_cache[i].public_key, public_key, 32) == 0) {
+      *A = key_cache[i].A;
+      return 1;
+    }
+  }
+#endif
+
+  if (!x25519_ge_frombytes_vartime(A, public_key)) {
     return 0;
   }
 
   fe_loose t;
-  fe_neg(&t, &A.X);
-  fe_carry(&A.X, &t);
-  fe_neg(&t, &A.T);
-  fe_carry(&A.T, &t);
+  fe_neg(&t, &A->X);
+  fe_carry(&A->X, &t);
+  fe_neg(&t, &A->T);
+  fe_carry(&A->T, &t);
+
+#if MCUBOOT_ED25519_CACHED_KEYS > 0
+  entry = &key_cache[key_cache_next];
+  key_cache_next = (key_cache_next + 1) % MCUBOOT_ED25519_CACHED_KEYS;
+  memcpy(entry->public_key, public_key, 32);
+  entry->A = *A;
+  entry->valid = 1;
+#endif
+  return 1;
+}
 
-  uint8_t pkcopy[32];
-  memcpy(pkcopy, public_key, 32);
-  uint8_t rcopy[32];
-  memcpy(rcopy, signature, 32);
+// out = SHA-512 of the concatenation of the n parts.
+static void sha512_parts(uint8_t out[SHA512_DIGEST_LENGTH], size_t n,
+                         const uint8_t *const *parts, const size_t *lens) {
+#if defined(MCUBOOT_USE_MBED_TLS)
+
+  mbedtls_sha512_context ctx;
+  int ret;
+
+  mbedtls_sha512_init(&ctx);
+
+  ret = mbedtls_sha512_starts_ret(&ctx, 0);
+  assert(ret == 0);
+
+  for (size_t i = 0; i < n; i++) {
+    ret = mbedtls_sha512_update_ret(&ctx, parts[i], lens[i]);
+    assert(ret == 0);
+  }
+
+  ret = mbedtls_sha512_finish_ret(&ctx, out);
+  assert(ret == 0);
+  mbedtls_sha512_free(&ctx);
+
+#else
+
+  struct tc_sha512_state_struct s;
+  int rc;
+
+  rc = tc_sha512_init(&s);
+  assert(rc == TC_CRYPTO_SUCCESS);
+
+  for (size_t i = 0; i < n; i++) {
+    rc = tc_sha512_update(&s, parts[i], lens[i]);
+    assert(rc == TC_CRYPTO_SUCCESS);
+  }
+
+  rc = tc_sha512_final(out, &s);
+  assert(rc == TC_CRYPTO_SUCCESS);
+
+#endif
+}
+
+// h = SHA-512(R || A || message) mod l, the scalar the public key is
+// multiplied by.
+static void ed25519_challenge(uint8_t h[SHA512_DIGEST_LENGTH],
+                              const uint8_t signature[64],
+                              const uint8_t public_key[32],
+                              const uint8_t *message, size_t message_len) {
+  const uint8_t *parts[3] = { signature, public_key, message };
+  const size_t lens[3] = { 32, 32, message_len };
+
+  sha512_parts(h, 3, parts, lens);
+  x25519_sc_reduce(h);
+}
+
+// Returns 1 if s is below the order of the base point, as
+// https://tools.ietf.org/html/rfc8032#section-5.1.7 requires to prevent
+// signature malleability.
+static int sc_is_canonical(const uint8_t s[32]) {
   union {
     uint64_t u64[4];
     uint8_t u8[32];
   } scopy;
-  memcpy(&scopy.u8[0], signature + 32, 32);
-
-  // https://tools.ietf.org/html/rfc8032#section-5.1.7 requires that s be in
-  // the range [0, order) in order to prevent signature malleability.
+  memcpy(&scopy.u8[0], s, 32);
 
   // kOrder is the order of Curve25519 in little-endian form.
   static const uint64_t kOrder[4] = {
@@ -1084,62 +1202,390 @@ int ED25519_verify(const uint8_t *message, size_t message_len,
     if (scopy.u64[i] > kOrder[i]) {
       return 0;
     } else if (scopy.u64[i] < kOrder[i]) {
-      break;
+      return 1;
     } else if (i == 0) {
       return 0;
     }
   }
+}
 
-#if defined(MCUBOOT_USE_MBED_TLS)
-
-  mbedtls_sha512_context ctx;
-  int ret;
+#if defined(MCUBOOT_BATCH_VERIFY)
+static int ed25519_verify_cofactored(const uint8_t h[32],
+                                     const uint8_t signature[64],
+                                     const ge_p3 *A);
+#endif
 
-  mbedtls_sha512_init(&ctx);
+int ED25519_verify(const uint8_t *message, size_t message_len,
+                   const uint8_t signature[64], const uint8_t public_key[32]) {
+  ge_p3 A;
+  if ((signature[63] & 224) != 0 ||
+      !ge_public_key_neg(&A, public_key)) {
+    return 0;
+  }
 
-  ret = mbedtls_sha512_starts_ret(&ctx, 0);
-  assert(ret == 0);
+  uint8_t scopy[32];
+  memcpy(scopy, signature + 32, 32);
 
-  ret = mbedtls_sha512_update_ret(&ctx, signature, 32);
-  assert(ret == 0);
-  ret = mbedtls_sha512_update_ret(&ctx, public_key, 32);
-  assert(ret == 0);
-  ret = mbedtls_sha512_update_ret(&ctx, message, message_len);
-  assert(ret == 0);
+  if (!sc_is_canonical(scopy)) {
+    return 0;
+  }
 
   uint8_t h[SHA512_DIGEST_LENGTH];
-  ret = mbedtls_sha512_finish_ret(&ctx, h);
-  assert(ret == 0);
-  mbedtls_sha512_free(&ctx);
+  ed25519_challenge(h, signature, public_key, message, message_len);
 
+#if defined(MCUBOOT_BATCH_VERIFY)
+  // Check the same equation as ED25519_verify_batch, so that an image
+  // doesn't pass or fail depending on whether it was checked in a batch.
+  return ed25519_verify_cofactored(h, signature, &A);
 #else
+  uint8_t rcopy[32];
+  memcpy(rcopy, signature, 32);
 
-  struct tc_sha512_state_struct s;
-  int rc;
+  ge_p2 R;
+  ge_double_scalarmult_vartime(&R, h, &A, scopy);
 
-  rc = tc_sha512_init(&s);
-  assert(rc == TC_CRYPTO_SUCCESS);
+  uint8_t rcheck[32];
+  x25519_ge_tobytes(rcheck, &R);
 
-  rc = tc_sha512_update(&s, signature, 32);
-  assert(rc == TC_CRYPTO_SUCCESS);
-  rc = tc_sha512_update(&s, public_key, 32);
-  assert(rc == TC_CRYPTO_SUCCESS);
-  rc = tc_sha512_update(&s, message, message_len);
-  assert(rc == TC_CRYPTO_SUCCESS);
+  return CRYPTO_memcmp(rcheck, rcopy, sizeof(rcheck)) == 0;
+#endif
+}
 
-  uint8_t h[TC_SHA512_DIGEST_SIZE];
-  rc = tc_sha512_final(h, &s);
-  assert(rc == TC_CRYPTO_SUCCESS);
+// Swaps f and g if b is 1, in constant time.
+static void fe_cswap(fe *f, fe *g, fe_limb_t b) {
+  b = 0 - b;
+  for (unsigned i = 0; i < FE_NUM_LIMBS; i++) {
+    fe_limb_t x = f->v[i] ^ g->v[i];
+    x &= b;
+    f->v[i] ^= x;
+    g->v[i] ^= x;
+  }
+}
 
+// h = f * 121666
+static void fe_mul121666(fe *h, const fe_loose *f) {
+  static const fe_limb_t a24[FE_NUM_LIMBS] = {121666};
+  fe_mul_impl(h->v, f->v, a24);
+}
+
+// The Montgomery ladder of RFC 7748, section 5.
+static void x25519_scalar_mult(uint8_t out[32], const uint8_t scalar[32],
+                               const uint8_t point[32]) {
+  fe x1, x2, z2, x3, z3, tmp0, tmp1;
+  fe_loose x2l, z2l, x3l, tmp0l, tmp1l;
+
+  uint8_t e[32];
+  memcpy(e, scalar, 32);
+  e[0] &= 248;
+  e[31] &= 127;
+  e[31] |= 64;
+
+  fe_frombytes(&x1, point);
+  fe_1(&x2);
+  fe_0(&z2);
+  fe_copy(&x3, &x1);
+  fe_1(&z3);
+
+  fe_limb_t swap = 0;
+  for (int pos = 254; pos >= 0; --pos) {
+    fe_limb_t b = 1 & (e[pos / 8] >> (pos & 7));
+    swap ^= b;
+    fe_cswap(&x2, &x3, swap);
+    fe_cswap(&z2, &z3, swap);
+    swap = b;
+    fe_sub(&tmp0l, &x3, &z3);
+    fe_sub(&tmp1l, &x2, &z2);
+    fe_add(&x2l, &x2, &z2);
+    fe_add(&z2l, &x3, &z3);
+    fe_mul_tll(&z3, &tmp0l, &x2l);
+    fe_mul_tll(&z2, &z2l, &tmp1l);
+    fe_sq_tl(&tmp0, &tmp1l);
+    fe_sq_tl(&tmp1, &x2l);
+    fe_add(&x3l, &z3, &z2);
+    fe_sub(&z2l, &z3, &z2);
+    fe_mul_ttt(&x2, &tmp1, &tmp0);
+    fe_sub(&tmp1l, &tmp1, &tmp0);
+    fe_sq_tl(&z2, &z2l);
+    fe_mul121666(&z3, &tmp1l);
+    fe_sq_tl(&x3, &x3l);
+    fe_add(&tmp0l, &tmp0, &z3);
+    fe_mul_ttt(&z3, &x1, &z2);
+    fe_mul_tll(&z2, &tmp1l, &tmp0l);
+  }
+  fe_cswap(&x2, &x3, swap);
+  fe_cswap(&z2, &z3, swap);
+
+  fe_invert(&z2, &z2);
+  fe_mul_ttt(&x2, &x2, &z2);
+  fe_tobytes(out, &x2);
+}
+
+int X25519(uint8_t out_shared_key[32], const uint8_t private_key[32],
+           const uint8_t peer_public_value[32]) {
+  static const uint8_t kZeros[32] = {0};
+  x25519_scalar_mult(out_shared_key, private_key, peer_public_value);
+  // The all-zero output results when the input is a point of small order.
+  return CRYPTO_memcmp(kZeros, out_shared_key, 32) != 0;
+}
+
+#if defined(MCUBOOT_BATCH_VERIFY)
+#if defined(MCUBOOT_IMAGE_NUMBER)
+#define ED25519_BATCH_MAX MCUBOOT_IMAGE_NUMBER
+#else
+#define ED25519_BATCH_MAX 1
 #endif
 
-  x25519_sc_reduce(h);
+// Odd multiples kept of each point of a batch: P, 3P, 5P, 7P.
+#define BATCH_MULTIPLES 4
+
+// out = a * b mod l.
+static void sc_mul(uint8_t out[32], const uint8_t a[32], const uint8_t b[32]) {
+  uint32_t x[8], y[8], p[16];
+  uint8_t wide[64];
+  uint64_t t;
+  uint32_t carry;
+  int i, j;
+
+  for (i = 0; i < 8; i++) {
+    x[i] = (uint32_t)load_4(a + 4 * i);
+    y[i] = (uint32_t)load_4(b + 4 * i);
+    p[i] = 0;
+    p[i + 8] = 0;
+  }
+  for (i = 0; i < 8; i++) {
+    carry = 0;
+    for (j = 0; j < 8; j++) {
+      t = (uint64_t)x[i] * y[j] + p[i + j] + carry;
+      p[i + j] = (uint32_t)t;
+      carry = (uint32_t)(t >> 32);
+    }
+    p[i + 8] = carry;
+  }
+  for (i = 0; i < 64; i++) {
+    wide[i] = (uint8_t)(p[i / 4] >> (8 * (i % 4)));
+  }
+  x25519_sc_reduce(wide);
+  memcpy(out, wide, 32);
+}
 
-  ge_p2 R;
-  ge_double_scalarmult_vartime(&R, h, &A, scopy.u8);
+// out = a + b mod l.
+static void sc_add(uint8_t out[32], const uint8_t a[32], const uint8_t b[32]) {
+  uint8_t wide[64];
+  unsigned carry = 0;
+  int i;
 
-  uint8_t rcheck[32];
-  x25519_ge_tobytes(rcheck, &R);
+  memset(wide, 0, sizeof(wide));
+  for (i = 0; i < 32; i++) {
+    carry += (unsigned)a[i] + b[i];
+    wide[i] = (uint8_t)carry;
+    carry >>= 8;
+  }
+  wide[32] = (uint8_t)carry;
+  x25519_sc_reduce(wide);
+  memcpy(out, wide, 32);
+}
 
-  return CRYPTO_memcmp(rcheck, rcopy, sizeof(rcheck)) == 0;
+// Sets R to minus the point encoded by s.  Returns 0 if s isn't the
+// canonical encoding of a point of the curve, which ED25519_verify would
+// never match.
+static int ge_frombytes_canonical_neg(ge_p3 *R, const uint8_t s[32]) {
+  uint8_t check[32];
+
+  if (!x25519_ge_frombytes_vartime(R, s)) {
+    return 0;
+  }
+  // Z is 1, so this is x25519_ge_tobytes without the inversion.
+  fe_tobytes(check, &R->Y);
+  check[31] ^= fe_isnegative(&R->X) << 7;
+  if (memcmp(check, s, 32) != 0) {
+    return 0;
+  }
+
+  fe_loose t;
+  fe_neg(&t, &R->X);
+  fe_carry(&R->X, &t);
+  fe_neg(&t, &R->T);
+  fe_carry(&R->T, &t);
+  return 1;
+}
+
+// r = sum of a[i] * A[i] for i < n, plus b * B.
+static void ge_multi_scalarmult_vartime(ge_p2 *r, size_t n,
+                                        const uint8_t (*a)[32],
+                                        const ge_p3 *A, const uint8_t *b) {
+  signed char aslide[2 * ED25519_BATCH_MAX][256];
+  signed char bslide[256];
+  ge_cached Ai[2 * ED25519_BATCH_MAX][BATCH_MULTIPLES];
+  ge_p1p1 t;
+  ge_p3 u;
+  ge_p3 A2;
+  size_t k;
+  int i, j;
+
+  for (k = 0; k < n; k++) {
+    slide(aslide[k], a[k], 2 * BATCH_MULTIPLES - 1);
+
+    x25519_ge_p3_to_cached(&Ai[k][0], &A[k]);
+    ge_p3_dbl(&t, &A[k]);
+    x25519_ge_p1p1_to_p3(&A2, &t);
+    for (j = 1; j < BATCH_MULTIPLES; j++) {
+      x25519_ge_add(&t, &A2, &Ai[k][j - 1]);
+      x25519_ge_p1p1_to_p3(&u, &t);
+      x25519_ge_p3_to_cached(&Ai[k][j], &u);
+    }
+  }
+  slide(bslide, b, B_SLIDE_MAX);
+
+  ge_p2_0(r);
+
+  for (i = 255; i >= 0; --i) {
+    if (bslide[i]) {
+      break;
+    }
+    for (k = 0; k < n && !aslide[k][i]; k++) {
+    }
+    if (k < n) {
+      break;
+    }
+  }
+
+  for (; i >= 0; --i) {
+    ge_p2_dbl(&t, r);
+
+    for (k = 0; k < n; k++) {
+      if (aslide[k][i] > 0) {
+        x25519_ge_p1p1_to_p3(&u, &t);
+        x25519_ge_add(&t, &u, &Ai[k][aslide[k][i] / 2]);
+      } else if (aslide[k][i] < 0) {
+        x25519_ge_p1p1_to_p3(&u, &t);
+        x25519_ge_sub(&t, &u, &Ai[k][(-aslide[k][i]) / 2]);
+      }
+    }
+
+    if (bslide[i] > 0) {
+      x25519_ge_p1p1_to_p3(&u, &t);
+      ge_madd(&t, &u, ge_b_multiple(bslide[i] / 2));
+    } else if (bslide[i] < 0) {
+      x25519_ge_p1p1_to_p3(&u, &t);
+      ge_msub(&t, &u, ge_b_multiple((-bslide[i]) / 2));
+    }
+
+    x25519_ge_p1p1_to_p2(r, &t);
+  }
+}
+
+// Returns 1 if 8 * r is the neutral element, that is if r only has a small
+// order component.
+static int ge_p2_is_small_order(ge_p2 *r) {
+  ge_p1p1 t;
+  fe_loose check;
+  int i;
+
+  for (i = 0; i < 3; i++) {
+    ge_p2_dbl(&t, r);
+    x25519_ge_p1p1_to_p2(r, &t);
+  }
+
+  // The neutral element is X = 0, Y = Z.
+  fe_copy_lt(&check, &r->X);
+  if (fe_isnonzero(&check)) {
+    return 0;
+  }
+  fe_sub(&check, &r->Y, &r->Z);
+  return !fe_isnonzero(&check);
+}
+
+// Checks 8 * (s * B - R - h * A) = 0 for one signature, where A is already
+// negated, instead of comparing the encoding of s * B - h * A with R.  The
+// two only differ when R or A has a small order component.
+static int ed25519_verify_cofactored(const uint8_t h[32],
+                                     const uint8_t signature[64],
+                                     const ge_p3 *A) {
+  static const uint8_t one[32] = {1};
+  uint8_t scalars[2][32];
+  ge_p3 points[2];
+  ge_p2 r;
+
+  if (!ge_frombytes_canonical_neg(&points[1], signature)) {
+    return 0;
+  }
+  points[0] = *A;
+  memcpy(scalars[0], h, 32);
+  memcpy(scalars[1], one, 32);
+
+  ge_multi_scalarmult_vartime(&r, 2, scalars, points, signature + 32);
+  return ge_p2_is_small_order(&r);
+}
+
+// Checks count signatures of messages of the same length at once: with
+// z_i derived from all of the signatures, keys and messages,
+//
+//   8 * (sum(z_i * s_i) * B - sum(z_i * R_i) - sum(z_i * h_i * A_i)) = 0
+//
+// holds when every signature is valid, and with probability 2^-128 when
+// one is not.  One multi scalar multiplication shares the doublings that
+// separate verifications each do.  Returns 1 if all signatures are valid,
+// 0 if any is not or count isn't supported; the signatures must then be
+// checked one by one to find the bad ones.
+int ED25519_verify_batch(size_t count, const uint8_t *const *messages,
+                         size_t message_len,
+                         const uint8_t *const *signatures,
+                         const uint8_t *const *public_keys) {
+  ge_p3 points[2 * ED25519_BATCH_MAX];
+  uint8_t scalars[2 * ED25519_BATCH_MAX][32];
+  uint8_t h[ED25519_BATCH_MAX][SHA512_DIGEST_LENGTH];
+  const uint8_t *parts[3 * ED25519_BATCH_MAX];
+  size_t lens[3 * ED25519_BATCH_MAX];
+  uint8_t seed[SHA512_DIGEST_LENGTH + 1];
+  uint8_t z[SHA512_DIGEST_LENGTH];
+  uint8_t b[32];
+  uint8_t zs[32];
+  ge_p2 r;
+  size_t i;
+
+  if (count == 0 || count > ED25519_BATCH_MAX) {
+    return 0;
+  }
+
+  for (i = 0; i < count; i++) {
+    const uint8_t *signature = signatures[i];
+
+    if ((signature[63] & 224) != 0 || !sc_is_canonical(signature + 32) ||
+        !ge_public_key_neg(&points[2 * i], public_keys[i]) ||
+        !ge_frombytes_canonical_neg(&points[2 * i + 1], signature)) {
+      return 0;
+    }
+    ed25519_challenge(h[i], signature, public_keys[i], messages[i],
+                      message_len);
+
+    parts[3 * i] = signature;
+    lens[3 * i] = 64;
+    parts[3 * i + 1] = public_keys[i];
+    lens[3 * i + 1] = 32;
+    parts[3 * i + 2] = h[i];
+    lens[3 * i + 2] = 32;
+  }
+
+  // The z_i are 128-bit, derived from everything checked so that no
+  // signature can be chosen to cancel out another.
+  sha512_parts(seed, 3 * count, parts, lens);
+
+  memset(b, 0, sizeof(b));
+  for (i = 0; i < count; i++) {
+    const uint8_t *zparts[1] = { seed };
+    const size_t zlens[1] = { sizeof(seed) };
+
+    seed[SHA512_DIGEST_LENGTH] = (uint8_t)i;
+    sha512_parts(z, 1, zparts, zlens);
+    memset(z + 16, 0, 16);
+
+    sc_mul(scalars[2 * i], z, h[i]);
+    memcpy(scalars[2 * i + 1], z, 32);
+    sc_mul(zs, z, signatures[i] + 32);
+    sc_add(b, b, zs);
+  }
+
+  ge_multi_scalarmult_vartime(&r, 2 * count, scalars, points, b);
+  return ge_p2_is_small_order(&r);
 }
+#endif /* MCUBOOT_BATCH_VERIFY */
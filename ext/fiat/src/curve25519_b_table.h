@@ -0,0 +1,198 @@
+// This file is generated from
+//    ./scripts/ed25519_b_table.py > curve25519_b_table.h
+
+// Bi_large[i] = (2*(i+8)+1)*B
+static const ge_precomp Bi_large[24] = {
+    {
+        {{17735041, 27114469, 9040472, 7210680, 43325571, 26153544, 26948151,
+          12350803, 38656901, 28625252}},
+        {{2154119, 14782993, 28737794, 11906199, 36205504, 26488101, 19338132,
+          16910143, 50209922, 29794297}},
+        {{29935700, 6336041, 20999566, 30405369, 13628497, 24612108, 61639745,
+          22359641, 56973806, 18684690}},
+    },
+    {
+        {{29792811, 31379227, 46332526, 20675663, 58452680, 20584117, 42892250,
+          32958636, 31674345, 24275271}},
+        {{7606599, 22131225, 17376912, 15235046, 32822971, 7512882, 30227203,
+          14344178, 9952094, 8804749}},
+        {{32575079, 3961822, 36404898, 17773250, 67073898, 1319543, 30641032,
+          7823672, 63309858, 18878784}},
+    },
+    {
+        {{10715079, 19379211, 26572932, 18690221, 42034819, 23989795, 12020708,
+          19771669, 38888710, 22335074}},
+        {{37146997, 554126, 63326061, 20925660, 49205290, 8620615, 53375504,
+          25938867, 8752612, 31225894}},
+        {{4529887, 12416158, 60388162, 30157900, 15427957, 27628808, 61150927,
+          12724463, 23658330, 23690055}},
+    },
+    {
+        {{34934403, 21269183, 45810226, 19657305, 54297192, 7413280, 66851983,
+          6164080, 25005049, 18002658}},
+        {{5403481, 24654166, 61855580, 13522652, 14989680, 1879017, 43913069,
+          25724172, 20315901, 421248}},
+        {{34818947, 1705239, 25347020, 7938434, 51632025, 1720023, 54809726,
+          32655885, 64907986, 5517607}},
+    },
+    {
+        {{21434680, 16557378, 13251023, 30047149, 24494012, 27723949, 62710290,
+          19153429, 7715737, 28093800}},
+        {{14461032, 6393639, 22681353, 14533514, 52493587, 3544717, 57780998,
+          24657863, 59891807, 31628125}},
+        {{60864886, 31199953, 18524951, 11247802, 43517645, 21165456, 26204394,
+          27268421, 63221077, 29979135}},
+    },
+    {
+        {{30382514, 10077556, 27696264, 8918288, 30231380, 17961119, 9092549,
+          7627898, 41405215, 31798052}},
+        {{13670592, 720327, 7131696, 19360499, 66651570, 16947532, 3061924,
+          22871019, 39814495, 20141336}},
+        {{44847187, 28379568, 38472030, 23697331, 49441718, 3215393, 1669253,
+          30451034, 62323912, 29368533}},
+    },
+    {
+        {{7814913, 1690062, 27222385, 30715870, 48444195, 28125622, 48943580,
+          32330149, 25500368, 1818106}},
+        {{39340596, 15199968, 52787715, 18781603, 18787729, 5464578, 11652644,
+          8722118, 57056621, 5153960}},
+        {{5733861, 14534448, 59480402, 15892910, 30737296, 188529, 491756,
+          17646733, 33071791, 15771063}},
+    },
+    {
+        {{18130707, 21331574, 52581845, 30172287, 44350959, 22271792, 1149903,
+          16209407, 20222151, 32139086}},
+        {{52372801, 13847470, 52690845, 3802477, 48387139, 10595589, 13745896,
+          3112846, 50361463, 2761905}},
+        {{45982696, 12273933, 15897066, 704320, 31367969, 3120352, 11710867,
+          16405685, 19410991, 10591627}},
+    },
+    {
+        {{14900005, 885327, 22211023, 15569757, 34309216, 29866047, 13199845,
+          27738520, 4631001, 13354856}},
+        {{36631997, 23300851, 59535242, 27474493, 59924914, 29067704, 17551261,
+          13583017, 37580567, 31071178}},
+        {{22641770, 21277083, 10843473, 1582748, 37504588, 634914, 15612385,
+          18139122, 59415250, 22563863}},
+    },
+    {
+        {{9613009, 19260283, 41722369, 1731435, 53022549, 4700744, 26055020,
+          27627618, 20854228, 175025}},
+        {{61915349, 11733561, 59403492, 31381562, 29521830, 16845409, 54973419,
+          26057054, 49464700, 796779}},
+        {{3855018, 8248512, 12652406, 88331, 2948262, 971326, 15614761,
+          9441028, 29507685, 8583792}},
+    },
+    {
+        {{9860006, 14808585, 9600042, 24095287, 23400176, 24077237, 63783137,
+          3916687, 56750252, 30681804}},
+        {{33709664, 3740344, 52888604, 25059045, 46197996, 22678812, 45207164,
+          6431243, 21300862, 27646257}},
+        {{49811511, 9216232, 25043921, 18738174, 29145960, 3024227, 65580502,
+          530149, 66809973, 22275500}},
+    },
+    {
+        {{23499385, 24936714, 38355445, 2354155, 15431304, 5726449, 46809414,
+          7589351, 5421941, 16121767}},
+        {{45162189, 23851397, 9380591, 15192763, 36034862, 15525765, 5277811,
+          25040629, 33286237, 31693326}},
+        {{62424427, 13336013, 49368582, 1581264, 30884213, 15048226, 66823504,
+          4736577, 53805192, 29608355}},
+    },
+    {
+        {{25190215, 26304748, 58928336, 9111275, 64280343, 5025798, 61299599,
+          20659504, 30387592, 32519377}},
+        {{14480213, 17057820, 2286692, 32980967, 14693157, 22197912, 49247898,
+          9909859, 236428, 16857435}},
+        {{7877514, 29872867, 45886243, 25902853, 41998762, 6241604, 35694938,
+          15657879, 56797932, 8609105}},
+    },
+    {
+        {{54245208, 32562161, 57887697, 19509733, 45323534, 3918114, 27606728,
+          25974066, 7290094, 11418745}},
+        {{28964163, 20950093, 44929966, 26145892, 34786807, 18058153, 18187179,
+          27016486, 42438836, 14869174}},
+        {{55703901, 1222455, 64329400, 24533246, 11330890, 9135834, 3589529,
+          19555234, 53275553, 1207212}},
+    },
+    {
+        {{33323313, 2048733, 12219722, 6017849, 4177481, 23804208, 19535260,
+          10453936, 55775079, 31816581}},
+        {{64814718, 27217688, 29891310, 4504619, 8548709, 21986323, 62140656,
+          12555980, 34377058, 21436823}},
+        {{49069441, 9880212, 33350825, 24576421, 24446077, 15616561, 19302117,
+          9370836, 55172180, 28526191}},
+    },
+    {
+        {{28296070, 26757209, 56755199, 4572840, 2140330, 10029994, 53559056,
+          8187614, 41167332, 24643278}},
+        {{35101859, 30958612, 66105296, 3168612, 22836264, 10055966, 22893634,
+          13045780, 28576558, 30704591}},
+        {{59987873, 21166324, 43296694, 15387892, 39447987, 19996270, 5059183,
+          19972934, 30207804, 29631666}},
+    },
+    {
+        {{335311, 16132893, 21221549, 4369853, 1038992, 24394987, 24372708,
+          24889161, 62329722, 17157782}},
+        {{56922508, 1347520, 23300731, 27393371, 42651667, 8512932, 27610931,
+          24436993, 3998295, 3835244}},
+        {{16327050, 22776956, 14746360, 22599650, 23700920, 11727222, 25900154,
+          21823218, 34907363, 25105813}},
+    },
+    {
+        {{59807886, 12089757, 48515346, 7922406, 480852, 26361581, 4246898,
+          10714230, 644198, 13128477}},
+        {{7174885, 26592113, 59892333, 6465478, 4145835, 17673606, 38764952,
+          22293290, 1360980, 25805937}},
+        {{40179568, 6331649, 42386021, 20205884, 15635073, 6103612, 56391180,
+          6789942, 7597240, 24095312}},
+    },
+    {
+        {{54776568, 3381500, 18757262, 7875103, 106218, 1145711, 19452113,
+          27649723, 26496795, 19612129}},
+        {{46701540, 24101444, 49515651, 25946994, 45338156, 9941093, 55509371,
+          31298943, 1347425, 15381335}},
+        {{53576449, 26135856, 17092785, 3684747, 57829121, 27109516, 2987881,
+          10987137, 52269096, 15465522}},
+    },
+    {
+        {{12924165, 26264317, 5272132, 10039545, 27497072, 30615494, 60406855,
+          30400829, 53656985, 11746941}},
+        {{35668062, 24246990, 47788280, 25128298, 37456967, 19518969, 43459670,
+          10724644, 7294162, 4471290}},
+        {{33813988, 3549109, 101112, 21464449, 4858392, 3029943, 59999440,
+          21424738, 34313875, 1512799}},
+    },
+    {
+        {{29494960, 28240930, 51093230, 28823678, 25682287, 21242363, 10463025,
+          4241111, 8656993, 10649532}},
+        {{63536751, 7572551, 62249759, 25202639, 32046232, 32318941, 29315141,
+          15424555, 24706712, 28857648}},
+        {{47618751, 5819839, 19528172, 20715950, 40655763, 20611047, 4960954,
+          6496879, 2790858, 28045273}},
+    },
+    {
+        {{18065612, 22289470, 44837820, 31021159, 32797785, 15389833, 11230024,
+          31144773, 15579137, 4915791}},
+        {{49664705, 3638040, 57888693, 19234931, 40104182, 28143840, 28667142,
+          18386877, 18584835, 3592929}},
+        {{12065039, 18867394, 6430594, 17107159, 1727094, 13096957, 61520237,
+          27056604, 27026997, 13543966}},
+    },
+    {
+        {{1404081, 4022847, 27586665, 14209107, 28740330, 30038710, 51818051,
+          20241476, 1871192, 8696643}},
+        {{17325298, 33376175, 65271265, 4931225, 31708266, 6292284, 23064744,
+          22072792, 43945505, 9236924}},
+        {{51955585, 20268063, 61151838, 26383348, 4766519, 20788033, 21173534,
+          27030753, 9509140, 7790046}},
+    },
+    {
+        {{24124086, 5364343, 28620391, 10538620, 59433851, 19581010, 60862718,
+          9945787, 10491858, 32213802}},
+        {{7062127, 13930079, 2259902, 6463144, 32137099, 24748848, 41557343,
+          29331342, 47345194, 13022814}},
+        {{18921826, 392002, 55817981, 6420686, 8000611, 22415972, 14722962,
+          26246290, 20604450, 8079345}},
+    },
+};
@@ -59,4 +59,3 @@ int cc310_ecdsa_verify_secp256r1(uint8_t *hash,
         nrf_cc310_disable();
         return rc;
 }
-
@@ -13,6 +13,8 @@
 #include <devicetree.h>
 #include <string.h>
 
+#include "mcuboot_config/mcuboot_config.h"
+
 typedef nrf_cc310_bl_hash_context_sha256_t bootutil_sha256_context;
 
 int cc310_ecdsa_verify_secp256r1(uint8_t *hash,
@@ -189,6 +189,222 @@ static bitcount_t smax(bitcount_t a, bitcount_t b)
 	return (a > b ? a : b);
 }
 
+#if defined(uECC_VERIFY_G_WINDOW)
+/*
+ * Verification with precomputed multiples of G: u1*G + u2*Q is computed with
+ * interleaved width-w NAFs of u1 and u2, adding (2i + 1)G from a constant
+ * table and (2i + 1)Q precomputed on the stack.  A larger window for G makes
+ * fewer additions at the cost of 2^(w - 2) * 64 bytes of flash.
+ */
+#if uECC_VERIFY_G_WINDOW < 2 || uECC_VERIFY_G_WINDOW > 8
+#error "uECC_VERIFY_G_WINDOW must be between 2 and 8"
+#endif
+
+#define G_POINTS (1 << (uECC_VERIFY_G_WINDOW - 2))
+#define Q_WINDOW 4
+#define Q_POINTS (1 << (Q_WINDOW - 2))
+#define NAF_DIGITS (NUM_ECC_WORDS * uECC_WORD_BITS + 1)
+
+#include "ecc_dsa_g_table.h"
+
+/*
+ * Writes the width-w NAF of k, least significant digit first, and returns
+ * the number of digits.  Non-zero digits are odd and below 2^(w - 1) in
+ * absolute value.
+ */
+static bitcount_t wnaf(int8_t *naf, const uECC_word_t *k, unsigned w)
+{
+	uECC_word_t t[NUM_ECC_WORDS + 1];
+	uECC_word_t borrow;
+	uECC_word_t d;
+	bitcount_t len = 0;
+	wordcount_t i;
+	int digit;
+
+	uECC_vli_set(t, k, NUM_ECC_WORDS);
+	t[NUM_ECC_WORDS] = 0;
+
+	while (!uECC_vli_isZero(t, NUM_ECC_WORDS + 1)) {
+		digit = 0;
+		if (t[0] & 1) {
+			digit = (int)(t[0] & ((1u << w) - 1));
+			if (digit >= (1 << (w - 1))) {
+				digit -= 1 << w;
+			}
+			/* t -= digit, which clears its low w bits. */
+			if (digit > 0) {
+				d = (uECC_word_t)digit;
+				for (i = 0; i < NUM_ECC_WORDS + 1 && d; ++i) {
+					borrow = t[i] < d;
+					t[i] -= d;
+					d = borrow;
+				}
+			} else {
+				d = (uECC_word_t)-digit;
+				for (i = 0; i < NUM_ECC_WORDS + 1 && d; ++i) {
+					t[i] += d;
+					d = t[i] < d;
+				}
+			}
+		}
+		naf[len++] = (int8_t)digit;
+
+		for (i = 0; i < NUM_ECC_WORDS; ++i) {
+			t[i] = (t[i] >> 1) | (t[i + 1] << (uECC_WORD_BITS - 1));
+		}
+		t[NUM_ECC_WORDS] >>= 1;
+	}
+	return len;
+}
+
+/*
+ * (X1, Y1, Z1) += +/-(X2, Y2, Z2), in Jacobian coordinates, Z = 0 being the
+ * point at infinity.  Z2 is NULL for an affine point.
+ */
+static void ecc_point_add(uECC_word_t *X1, uECC_word_t *Y1, uECC_word_t *Z1,
+			  const uECC_word_t *X2, const uECC_word_t *Y2,
+			  const uECC_word_t *Z2, int negate, uECC_Curve curve)
+{
+	uECC_word_t y2[NUM_ECC_WORDS];
+	uECC_word_t u1[NUM_ECC_WORDS], s1[NUM_ECC_WORDS];
+	uECC_word_t u2[NUM_ECC_WORDS], s2[NUM_ECC_WORDS];
+	uECC_word_t h[NUM_ECC_WORDS], r[NUM_ECC_WORDS];
+	uECC_word_t t[NUM_ECC_WORDS];
+	wordcount_t num_words = curve->num_words;
+
+	uECC_vli_set(y2, Y2, num_words);
+	if (negate) {
+		uECC_vli_clear(y2, num_words);
+		uECC_vli_modSub(y2, y2, Y2, curve->p, num_words);
+	}
+
+	if (Z2 && uECC_vli_isZero(Z2, num_words)) {
+		return;
+	}
+	if (uECC_vli_isZero(Z1, num_words)) {
+		uECC_vli_set(X1, X2, num_words);
+		uECC_vli_set(Y1, y2, num_words);
+		if (Z2) {
+			uECC_vli_set(Z1, Z2, num_words);
+		} else {
+			uECC_vli_clear(Z1, num_words);
+			Z1[0] = 1;
+		}
+		return;
+	}
+
+	if (Z2) {
+		uECC_vli_modMult_fast(t, Z2, Z2, curve);    /* Z2^2 */
+		uECC_vli_modMult_fast(u1, X1, t, curve);    /* U1 = X1*Z2^2 */
+		uECC_vli_modMult_fast(t, t, Z2, curve);     /* Z2^3 */
+		uECC_vli_modMult_fast(s1, Y1, t, curve);    /* S1 = Y1*Z2^3 */
+	} else {
+		uECC_vli_set(u1, X1, num_words);
+		uECC_vli_set(s1, Y1, num_words);
+	}
+	uECC_vli_modMult_fast(t, Z1, Z1, curve);            /* Z1^2 */
+	uECC_vli_modMult_fast(u2, X2, t, curve);            /* U2 = X2*Z1^2 */
+	uECC_vli_modMult_fast(t, t, Z1, curve);             /* Z1^3 */
+	uECC_vli_modMult_fast(s2, y2, t, curve);            /* S2 = Y2*Z1^3 */
+
+	uECC_vli_modSub(h, u2, u1, curve->p, num_words);    /* H = U2 - U1 */
+	uECC_vli_modSub(r, s2, s1, curve->p, num_words);    /* R = S2 - S1 */
+	if (uECC_vli_isZero(h, num_words)) {
+		if (uECC_vli_isZero(r, num_words)) {
+			/* Same point. */
+			curve->double_jacobian(X1, Y1, Z1, curve);
+		} else {
+			/* Opposite points. */
+			uECC_vli_clear(Z1, num_words);
+		}
+		return;
+	}
+
+	uECC_vli_modMult_fast(Z1, Z1, h, curve);            /* Z3 = Z1*Z2*H */
+	if (Z2) {
+		uECC_vli_modMult_fast(Z1, Z1, Z2, curve);
+	}
+	uECC_vli_modMult_fast(t, h, h, curve);              /* H^2 */
+	uECC_vli_modMult_fast(h, h, t, curve);              /* H^3 */
+	uECC_vli_modMult_fast(u1, u1, t, curve);            /* V = U1*H^2 */
+	uECC_vli_modMult_fast(s1, s1, h, curve);            /* S1*H^3 */
+
+	uECC_vli_modMult_fast(X1, r, r, curve);             /* R^2 */
+	uECC_vli_modSub(X1, X1, h, curve->p, num_words);    /* - H^3 */
+	uECC_vli_modSub(X1, X1, u1, curve->p, num_words);   /* - V */
+	uECC_vli_modSub(X1, X1, u1, curve->p, num_words);   /* - V = X3 */
+	uECC_vli_modSub(t, u1, X1, curve->p, num_words);    /* V - X3 */
+	uECC_vli_modMult_fast(Y1, r, t, curve);             /* R*(V - X3) */
+	uECC_vli_modSub(Y1, Y1, s1, curve->p, num_words);   /* - S1*H^3 = Y3 */
+}
+
+/*
+ * Computes the affine x coordinate of u1*G + u2*Q in rx.  Returns 0 if the
+ * sum is the point at infinity.
+ */
+static int ecc_verify_sum(uECC_word_t *rx, const uECC_word_t *u1,
+			  const uECC_word_t *u2, const uECC_word_t *Q,
+			  uECC_Curve curve)
+{
+	int8_t g_naf[NAF_DIGITS];
+	int8_t q_naf[NAF_DIGITS];
+	uECC_word_t qx[Q_POINTS][NUM_ECC_WORDS];
+	uECC_word_t qy[Q_POINTS][NUM_ECC_WORDS];
+	uECC_word_t qz[Q_POINTS][NUM_ECC_WORDS];
+	uECC_word_t dx[NUM_ECC_WORDS], dy[NUM_ECC_WORDS], dz[NUM_ECC_WORDS];
+	uECC_word_t ry[NUM_ECC_WORDS], rz[NUM_ECC_WORDS];
+	wordcount_t num_words = curve->num_words;
+	bitcount_t g_len, q_len;
+	bitcount_t i;
+	int digit;
+	int k;
+
+	g_len = wnaf(g_naf, u1, uECC_VERIFY_G_WINDOW);
+	q_len = wnaf(q_naf, u2, Q_WINDOW);
+
+	/* (2k + 1)Q = (2k - 1)Q + 2Q */
+	uECC_vli_set(qx[0], Q, num_words);
+	uECC_vli_set(qy[0], Q + num_words, num_words);
+	uECC_vli_clear(qz[0], num_words);
+	qz[0][0] = 1;
+	uECC_vli_set(dx, qx[0], num_words);
+	uECC_vli_set(dy, qy[0], num_words);
+	uECC_vli_set(dz, qz[0], num_words);
+	curve->double_jacobian(dx, dy, dz, curve);
+	for (k = 1; k < Q_POINTS; ++k) {
+		uECC_vli_set(qx[k], qx[k - 1], num_words);
+		uECC_vli_set(qy[k], qy[k - 1], num_words);
+		uECC_vli_set(qz[k], qz[k - 1], num_words);
+		ecc_point_add(qx[k], qy[k], qz[k], dx, dy, dz, 0, curve);
+	}
+
+	uECC_vli_clear(rz, num_words);
+	for (i = smax(g_len, q_len) - 1; i >= 0; --i) {
+		curve->double_jacobian(rx, ry, rz, curve);
+		digit = i < g_len ? g_naf[i] : 0;
+		if (digit) {
+			k = (digit < 0 ? -digit : digit) >> 1;
+			ecc_point_add(rx, ry, rz, ecc_g_odd_multiples[k],
+				      ecc_g_odd_multiples[k] + num_words, 0,
+				      digit < 0, curve);
+		}
+		digit = i < q_len ? q_naf[i] : 0;
+		if (digit) {
+			k = (digit < 0 ? -digit : digit) >> 1;
+			ecc_point_add(rx, ry, rz, qx[k], qy[k], qz[k],
+				      digit < 0, curve);
+		}
+	}
+
+	if (uECC_vli_isZero(rz, num_words)) {
+		return 0;
+	}
+	uECC_vli_modInv(rz, rz, curve->p, num_words); /* Z = 1/Z */
+	apply_z(rx, ry, rz, curve);
+	return 1;
+}
+#endif /* uECC_VERIFY_G_WINDOW */
+
 int uECC_verify(const uint8_t *public_key, const uint8_t *message_hash,
 		unsigned hash_size, const uint8_t *signature,
 	        uECC_Curve curve)
@@ -196,8 +412,9 @@ int uECC_verify(const uint8_t *public_key, const uint8_t *message_hash,
 
 	uECC_word_t u1[NUM_ECC_WORDS], u2[NUM_ECC_WORDS];
 	uECC_word_t z[NUM_ECC_WORDS];
-	uECC_word_t sum[NUM_ECC_WORDS * 2];
 	uECC_word_t rx[NUM_ECC_WORDS];
+#if !defined(uECC_VERIFY_G_WINDOW)
+	uECC_word_t sum[NUM_ECC_WORDS * 2];
 	uECC_word_t ry[NUM_ECC_WORDS];
 	uECC_word_t tx[NUM_ECC_WORDS];
 	uECC_word_t ty[NUM_ECC_WORDS];
@@ -206,6 +423,7 @@ int uECC_verify(const uint8_t *public_key, const uint8_t *message_hash,
 	const uECC_word_t *point;
 	bitcount_t num_bits;
 	bitcount_t i;
+#endif
 
 	uECC_word_t _public[NUM_ECC_WORDS * 2];
 	uECC_word_t r[NUM_ECC_WORDS], s[NUM_ECC_WORDS];
@@ -240,6 +458,11 @@ int uECC_verify(const uint8_t *public_key, const uint8_t *message_hash,
 	uECC_vli_modMult(u1, u1, z, curve->n, num_n_words); /* u1 = e/s */
 	uECC_vli_modMult(u2, r, z, curve->n, num_n_words); /* u2 = r/s */
 
+#if defined(uECC_VERIFY_G_WINDOW)
+	if (!ecc_verify_sum(rx, u1, u2, _public, curve)) {
+		return 0;
+	}
+#else
 	/* Calculate sum = G + Q. */
 	uECC_vli_set(sum, _public, num_words);
 	uECC_vli_set(sum + num_words, _public + num_words, num_words);
@@ -283,6 +506,7 @@ int uECC_verify(const uint8_t *public_key, const uint8_t *message_hash,
 
 	uECC_vli_modInv(z, z, curve->p, num_words); /* Z = 1/Z */
 	apply_z(rx, ry, z, curve);
+#endif /* uECC_VERIFY_G_WINDOW */
 
 	/* v = x1 (mod n) */
 	if (uECC_vli_cmp_unsafe(curve->n, rx, num_n_words) != 1) {
@@ -0,0 +1,660 @@
+/* Autogenerated by scripts/ecc_g_table.py, do not edit. */
+
+/*
+ * (2i + 1)G for the P-256 generator G, in affine coordinates.  Only
+ * the 2^(uECC_VERIFY_G_WINDOW - 2) points used are built in.
+ */
+static const uECC_word_t ecc_g_odd_multiples[G_POINTS][NUM_ECC_WORDS * 2] = {
+	{ /* 1G */
+		BYTES_TO_WORDS_8(96, C2, 98, D8, 45, 39, A1, F4),
+		BYTES_TO_WORDS_8(A0, 33, EB, 2D, 81, 7D, 03, 77),
+		BYTES_TO_WORDS_8(F2, 40, A4, 63, E5, E6, BC, F8),
+		BYTES_TO_WORDS_8(47, 42, 2C, E1, F2, D1, 17, 6B),
+		BYTES_TO_WORDS_8(F5, 51, BF, 37, 68, 40, B6, CB),
+		BYTES_TO_WORDS_8(CE, 5E, 31, 6B, 57, 33, CE, 2B),
+		BYTES_TO_WORDS_8(16, 9E, 0F, 7C, 4A, EB, E7, 8E),
+		BYTES_TO_WORDS_8(9B, 7F, 1A, FE, E2, 42, E3, 4F),
+	},
+#if uECC_VERIFY_G_WINDOW >= 3
+	{ /* 3G */
+		BYTES_TO_WORDS_8(6C, FD, E7, C6, 1B, 66, 41, FB),
+		BYTES_TO_WORDS_8(85, A9, AD, EF, 21, B7, C6, E6),
+		BYTES_TO_WORDS_8(65, F1, 4B, 1D, 95, EF, F7, C8),
+		BYTES_TO_WORDS_8(44, 0A, 33, A6, D1, E4, CB, 5E),
+		BYTES_TO_WORDS_8(32, 50, 7D, A2, 27, B1, 79, 9A),
+		BYTES_TO_WORDS_8(3D, B8, 4F, 38, 36, B0, 2A, D8),
+		BYTES_TO_WORDS_8(EC, A2, 64, 1A, CE, 06, 4B, 37),
+		BYTES_TO_WORDS_8(7E, FF, 98, 49, 0C, 64, 34, 87),
+	},
+#endif
+#if uECC_VERIFY_G_WINDOW >= 4
+	{ /* 5G */
+		BYTES_TO_WORDS_8(ED, 33, D0, C3, 0D, 4A, 55, 21),
+		BYTES_TO_WORDS_8(24, E5, 5B, 1F, FD, 82, 8C, EF),
+		BYTES_TO_WORDS_8(DF, 8F, 66, 08, 56, C8, 84, D7),
+		BYTES_TO_WORDS_8(D2, 40, 51, 51, 7A, 0B, 59, 51),
+		BYTES_TO_WORDS_8(A4, 6D, A1, FD, 44, BB, D0, D1),
+		BYTES_TO_WORDS_8(88, 08, D8, D4, 00, 2F, 01, 0D),
+		BYTES_TO_WORDS_8(26, 79, 8A, BF, 36, BF, E1, 8A),
+		BYTES_TO_WORDS_8(7D, 72, 4A, 90, A8, 7D, C1, E0),
+	},
+	{ /* 7G */
+		BYTES_TO_WORDS_8(A3, B2, 87, 31, 70, 28, 06, 30),
+		BYTES_TO_WORDS_8(5B, EF, 0F, A8, B8, F8, F9, 7E),
+		BYTES_TO_WORDS_8(60, FB, 01, 7C, 66, 30, BB, 25),
+		BYTES_TO_WORDS_8(46, 7B, BF, A0, 6F, 3B, 53, 8E),
+		BYTES_TO_WORDS_8(B4, 00, F4, C1, 86, 1A, 5E, C5),
+		BYTES_TO_WORDS_8(21, 1B, 04, CB, 33, 36, C7, 53),
+		BYTES_TO_WORDS_8(00, 90, F5, A6, 83, 9F, 06, 6D),
+		BYTES_TO_WORDS_8(36, 18, 33, E0, BD, 1D, EB, 73),
+	},
+#endif
+#if uECC_VERIFY_G_WINDOW >= 5
+	{ /* 9G */
+		BYTES_TO_WORDS_8(E0, 9E, 94, 90, 4B, 8A, 9E, D7),
+		BYTES_TO_WORDS_8(B3, F8, 6D, 2C, 8C, CB, 0A, 9E),
+		BYTES_TO_WORDS_8(72, F8, 71, 1D, D5, 38, 89, 87),
+		BYTES_TO_WORDS_8(71, 0B, DF, FE, B6, D7, 68, EA),
+		BYTES_TO_WORDS_8(FA, 48, D0, 4D, 4A, 22, 5A, E8),
+		BYTES_TO_WORDS_8(3F, 82, DE, A4, EA, 4F, 71, 4D),
+		BYTES_TO_WORDS_8(C8, A0, 8E, 4A, 96, 4A, 01, 87),
+		BYTES_TO_WORDS_8(E7, FC, C9, 72, C9, 44, 27, 2A),
+	},
+	{ /* 11G */
+		BYTES_TO_WORDS_8(D1, 21, BC, 74, D3, 91, 33, 43),
+		BYTES_TO_WORDS_8(BF, 48, 50, 25, D0, 2E, 74, 16),
+		BYTES_TO_WORDS_8(DA, 1C, C2, B0, 9D, 37, 38, 06),
+		BYTES_TO_WORDS_8(59, 4C, 3B, 88, B7, 13, D1, 3E),
+		BYTES_TO_WORDS_8(40, 37, 2A, E8, FC, EE, F8, E2),
+		BYTES_TO_WORDS_8(DA, 89, 98, 5E, DA, 04, 0D, 09),
+		BYTES_TO_WORDS_8(8A, C6, F4, A4, AF, 43, C8, 24),
+		BYTES_TO_WORDS_8(A2, C8, C4, CC, 9A, 20, 99, 90),
+	},
+	{ /* 13G */
+		BYTES_TO_WORDS_8(01, 2C, 07, 46, 9D, 5D, E1, 98),
+		BYTES_TO_WORDS_8(8A, D5, EA, 65, 4B, 28, 2E, 79),
+		BYTES_TO_WORDS_8(FC, E2, 5E, D8, F2, 5D, 80, 61),
+		BYTES_TO_WORDS_8(5A, 49, AC, E0, 7A, 83, 7C, 17),
+		BYTES_TO_WORDS_8(D8, BF, C7, EF, E2, BB, 43, 9C),
+		BYTES_TO_WORDS_8(F3, 4D, FB, A1, C3, 14, EE, 26),
+		BYTES_TO_WORDS_8(72, 4E, 0F, B4, AD, 91, 40, A2),
+		BYTES_TO_WORDS_8(58, A5, BE, 4E, CD, 58, BB, 63),
+	},
+	{ /* 15G */
+		BYTES_TO_WORDS_8(5F, 9D, 9B, E5, 63, 8C, 66, 63),
+		BYTES_TO_WORDS_8(F1, 0E, 3A, DE, 92, AF, 03, AE),
+		BYTES_TO_WORDS_8(65, 82, 88, 99, 89, 37, FB, AD),
+		BYTES_TO_WORDS_8(E7, BA, 1A, 97, C6, 4D, 45, F0),
+		BYTES_TO_WORDS_8(36, 4F, 03, 0D, DE, 9C, E5, 47),
+		BYTES_TO_WORDS_8(3F, FA, B5, 75, CE, 21, 3B, 2A),
+		BYTES_TO_WORDS_8(E6, 43, 96, 1F, E5, 94, 65, 4E),
+		BYTES_TO_WORDS_8(1F, 2D, 2E, 59, E3, 3E, B9, B5),
+	},
+#endif
+#if uECC_VERIFY_G_WINDOW >= 6
+	{ /* 17G */
+		BYTES_TO_WORDS_8(3E, A7, 38, 47, E3, BC, 1A, BA),
+		BYTES_TO_WORDS_8(F8, 4A, D6, F0, 78, 86, A6, 5F),
+		BYTES_TO_WORDS_8(1A, 30, 75, 6F, B6, 84, 09, 9C),
+		BYTES_TO_WORDS_8(3A, CC, F1, C0, 04, 69, 77, 47),
+		BYTES_TO_WORDS_8(DC, FC, F1, 71, FF, 87, F7, 32),
+		BYTES_TO_WORDS_8(3F, 73, D5, 28, 44, 80, B2, 81),
+		BYTES_TO_WORDS_8(83, 8E, 64, 77, 65, 85, 31, 62),
+		BYTES_TO_WORDS_8(28, 57, B9, B5, E6, 5E, 00, AA),
+	},
+	{ /* 19G */
+		BYTES_TO_WORDS_8(83, ED, 03, AB, 74, 7B, FC, C1),
+		BYTES_TO_WORDS_8(95, 48, 88, 57, 22, 45, 2C, 78),
+		BYTES_TO_WORDS_8(07, C5, 08, 71, C1, B7, 39, CE),
+		BYTES_TO_WORDS_8(25, 0C, 2C, 10, 61, 28, 6D, CB),
+		BYTES_TO_WORDS_8(AA, CD, CE, 2B, 75, 50, 91, E3),
+		BYTES_TO_WORDS_8(03, 3E, FA, 30, 6E, 71, 96, A4),
+		BYTES_TO_WORDS_8(E4, 6C, 6D, 0D, 10, E7, 35, 5C),
+		BYTES_TO_WORDS_8(51, EF, D9, 24, 4B, 61, D7, 58),
+	},
+	{ /* 21G */
+		BYTES_TO_WORDS_8(83, 9E, 39, 67, 4E, 36, 76, FD),
+		BYTES_TO_WORDS_8(23, 15, 2B, F4, 39, 21, 58, 3A),
+		BYTES_TO_WORDS_8(A5, BC, 73, B4, 6E, C8, 4A, 2E),
+		BYTES_TO_WORDS_8(7B, 7C, 63, 86, F6, FC, 50, 32),
+		BYTES_TO_WORDS_8(09, 8C, D4, 71, A0, 24, DE, 15),
+		BYTES_TO_WORDS_8(82, 6A, 56, 3B, C3, D3, 7C, 89),
+		BYTES_TO_WORDS_8(8C, B8, 7E, 1D, 0D, 09, B3, 97),
+		BYTES_TO_WORDS_8(93, 35, 7D, 66, 42, C3, E7, 42),
+	},
+	{ /* 23G */
+		BYTES_TO_WORDS_8(96, 78, CA, 45, 30, 57, 2E, 67),
+		BYTES_TO_WORDS_8(FE, A4, 64, DF, A5, C0, 0B, 3C),
+		BYTES_TO_WORDS_8(A6, 3F, 58, D4, 39, 3E, 8A, D2),
+		BYTES_TO_WORDS_8(D7, 40, 26, 9C, 23, C7, 91, 0E),
+		BYTES_TO_WORDS_8(55, AD, 40, 31, 54, 46, 80, 13),
+		BYTES_TO_WORDS_8(AE, A5, E7, 75, 35, 83, 68, 7E),
+		BYTES_TO_WORDS_8(6D, BD, E0, B8, 3B, 73, 22, 1A),
+		BYTES_TO_WORDS_8(22, BA, 0D, 55, 3B, 5C, F6, 5D),
+	},
+	{ /* 25G */
+		BYTES_TO_WORDS_8(87, D6, 00, F2, 45, DC, A4, 84),
+		BYTES_TO_WORDS_8(24, 1B, 6F, B7, C5, 2F, 65, 41),
+		BYTES_TO_WORDS_8(84, FA, 07, 8C, 2D, F5, F4, 85),
+		BYTES_TO_WORDS_8(B6, 0B, 0C, 4B, 55, E2, 67, 3A),
+		BYTES_TO_WORDS_8(24, 93, F7, 02, B3, 16, ED, A9),
+		BYTES_TO_WORDS_8(8A, 61, A7, 35, F7, 8A, 18, 8C),
+		BYTES_TO_WORDS_8(0D, FB, 3A, 16, 67, F2, DA, 26),
+		BYTES_TO_WORDS_8(43, CF, 1F, 2F, 87, F1, D0, 27),
+	},
+	{ /* 27G */
+		BYTES_TO_WORDS_8(D1, 83, 08, 3B, 17, 01, E2, F2),
+		BYTES_TO_WORDS_8(AB, 54, 3E, 68, BD, 55, 63, 57),
+		BYTES_TO_WORDS_8(78, F3, 11, 46, AC, 2F, BA, DE),
+		BYTES_TO_WORDS_8(51, 0D, D8, 19, 58, FA, 4F, 18),
+		BYTES_TO_WORDS_8(6F, 6E, 90, 60, C2, 42, D2, 20),
+		BYTES_TO_WORDS_8(16, 49, F0, 63, CC, EC, BD, 45),
+		BYTES_TO_WORDS_8(95, 99, CB, 26, 08, D9, C6, A4),
+		BYTES_TO_WORDS_8(59, F3, 88, 66, 27, 6E, A6, C0),
+	},
+	{ /* 29G */
+		BYTES_TO_WORDS_8(EF, 4D, 78, 1C, 3D, 69, DD, DE),
+		BYTES_TO_WORDS_8(41, 8A, B5, 88, C6, D1, 8C, FD),
+		BYTES_TO_WORDS_8(8C, 3B, 85, 90, A0, 6D, C3, A7),
+		BYTES_TO_WORDS_8(07, 5B, 19, FA, DE, 3A, D3, D6),
+		BYTES_TO_WORDS_8(A6, BC, D1, 93, 45, 12, 0C, 55),
+		BYTES_TO_WORDS_8(ED, ED, 95, 4B, AB, 66, A1, 09),
+		BYTES_TO_WORDS_8(CB, 5D, 8A, 55, 5F, 24, 78, 3F),
+		BYTES_TO_WORDS_8(7E, 5D, 19, EE, 16, BA, AA, 84),
+	},
+	{ /* 31G */
+		BYTES_TO_WORDS_8(8B, 5B, B4, A1, A0, 9A, 3F, 3E),
+		BYTES_TO_WORDS_8(3E, 5B, A9, 52, 7D, DB, C9, FA),
+		BYTES_TO_WORDS_8(A0, 9A, AE, A7, 26, A0, 5D, A8),
+		BYTES_TO_WORDS_8(5D, E0, C7, 2D, 50, 9E, 1D, 30),
+		BYTES_TO_WORDS_8(67, E2, 7E, A1, AE, B6, 8D, D5),
+		BYTES_TO_WORDS_8(61, CA, 87, 68, E4, 9A, 8D, 29),
+		BYTES_TO_WORDS_8(72, 7D, 01, 6B, 02, 3C, D2, E0),
+		BYTES_TO_WORDS_8(23, 12, 06, B3, F6, B6, 51, 65),
+	},
+#endif
+#if uECC_VERIFY_G_WINDOW >= 7
+	{ /* 33G */
+		BYTES_TO_WORDS_8(93, D7, 2C, CB, F3, 00, C1, 65),
+		BYTES_TO_WORDS_8(FD, 72, A8, 3A, 53, 0A, 3B, A0),
+		BYTES_TO_WORDS_8(4E, D3, D9, 89, 5B, A2, 9A, FA),
+		BYTES_TO_WORDS_8(56, 13, D8, FC, 99, D6, 07, 98),
+		BYTES_TO_WORDS_8(F4, 4A, 63, 79, 24, F9, 6B, 2F),
+		BYTES_TO_WORDS_8(53, 78, 58, 6C, B9, 30, E6, FF),
+		BYTES_TO_WORDS_8(2F, 1B, 09, 1D, 4D, 1A, A0, 86),
+		BYTES_TO_WORDS_8(F2, 1B, B1, CA, DC, 9C, A5, C2),
+	},
+	{ /* 35G */
+		BYTES_TO_WORDS_8(1A, 29, BB, 33, 90, 38, 2D, A1),
+		BYTES_TO_WORDS_8(00, 97, AF, 92, FE, E1, E8, 94),
+		BYTES_TO_WORDS_8(CA, 48, 6C, 32, D7, 3A, FA, 8F),
+		BYTES_TO_WORDS_8(16, 7D, D2, 9E, 58, 4A, 8D, D5),
+		BYTES_TO_WORDS_8(D5, B9, 86, F5, C6, C9, B0, A5),
+		BYTES_TO_WORDS_8(79, 49, 03, 3B, 16, 1C, 27, 67),
+		BYTES_TO_WORDS_8(F6, FE, C7, 2D, 63, 92, EA, 76),
+		BYTES_TO_WORDS_8(85, 6B, 72, 02, D1, 14, 55, D4),
+	},
+	{ /* 37G */
+		BYTES_TO_WORDS_8(48, 33, 2B, 50, 94, 28, A9, 73),
+		BYTES_TO_WORDS_8(44, FD, 6B, 24, 79, 13, D2, E0),
+		BYTES_TO_WORDS_8(AA, 26, A8, 11, 86, 97, B0, D6),
+		BYTES_TO_WORDS_8(7D, 81, DB, 6D, 64, 6A, 9A, 41),
+		BYTES_TO_WORDS_8(B2, 14, 92, B0, 81, 6C, 1D, DB),
+		BYTES_TO_WORDS_8(E2, E1, DE, F3, 72, D0, C6, 13),
+		BYTES_TO_WORDS_8(D5, 2F, 4C, 95, B1, 9F, 5C, 54),
+		BYTES_TO_WORDS_8(84, F5, 02, 11, CF, 44, 25, 33),
+	},
+	{ /* 39G */
+		BYTES_TO_WORDS_8(C4, 76, 27, FB, DD, 99, C1, A0),
+		BYTES_TO_WORDS_8(D4, 38, D1, D2, 2D, 94, 7B, 54),
+		BYTES_TO_WORDS_8(6E, 04, 79, A1, 76, 49, 01, 42),
+		BYTES_TO_WORDS_8(4D, 6D, 99, C3, F7, 82, A6, 22),
+		BYTES_TO_WORDS_8(5D, 28, AA, CB, 49, F6, 47, 53),
+		BYTES_TO_WORDS_8(68, B0, 65, 02, 31, CC, 9D, 97),
+		BYTES_TO_WORDS_8(6C, 35, 54, 5A, 83, C9, 18, B9),
+		BYTES_TO_WORDS_8(EE, 23, 22, 10, B0, 06, 46, 4F),
+	},
+	{ /* 41G */
+		BYTES_TO_WORDS_8(A2, 2F, 5D, 99, 94, E6, 7D, 3A),
+		BYTES_TO_WORDS_8(59, 5A, 17, D4, C3, C5, 67, 60),
+		BYTES_TO_WORDS_8(AA, E8, CF, E6, D2, 58, F2, 1C),
+		BYTES_TO_WORDS_8(65, E0, DE, 40, C2, BE, A6, 67),
+		BYTES_TO_WORDS_8(D5, EE, 1F, 44, E1, 4C, C2, 49),
+		BYTES_TO_WORDS_8(6C, CA, 9A, 20, EE, C7, 42, 15),
+		BYTES_TO_WORDS_8(99, 44, 4D, 46, 49, 9B, 24, 6C),
+		BYTES_TO_WORDS_8(58, 31, D1, 22, 70, 2B, 69, DE),
+	},
+	{ /* 43G */
+		BYTES_TO_WORDS_8(8D, D2, 82, 9B, 12, DC, 44, 75),
+		BYTES_TO_WORDS_8(0F, B3, 09, D0, C6, C4, 4B, 8F),
+		BYTES_TO_WORDS_8(49, 4B, 8F, 1D, 86, 30, 42, D0),
+		BYTES_TO_WORDS_8(04, F1, 1F, 6F, 50, E2, 6A, 98),
+		BYTES_TO_WORDS_8(97, 7E, B0, 1B, 44, 0C, 11, 25),
+		BYTES_TO_WORDS_8(25, 9F, 18, 9C, 28, C6, 6F, D8),
+		BYTES_TO_WORDS_8(61, 7B, 3C, 7D, D9, A4, 28, E3),
+		BYTES_TO_WORDS_8(0A, 0E, 46, A6, C0, CC, 3C, 00),
+	},
+	{ /* 45G */
+		BYTES_TO_WORDS_8(03, BA, E0, FA, 80, 80, C7, 79),
+		BYTES_TO_WORDS_8(D9, D6, 29, DD, 9E, 60, 5F, 0F),
+		BYTES_TO_WORDS_8(2E, 67, F0, DF, 5D, 0F, CD, 3E),
+		BYTES_TO_WORDS_8(9B, E9, BD, 70, 66, D0, 91, A8),
+		BYTES_TO_WORDS_8(AE, 34, 69, 16, C8, ED, C3, EF),
+		BYTES_TO_WORDS_8(CC, F2, B0, FE, F0, 38, 6B, 1C),
+		BYTES_TO_WORDS_8(E7, 1C, 3C, 03, C4, 88, 9A, 41),
+		BYTES_TO_WORDS_8(C1, A1, BF, 2C, 92, CD, 96, B5),
+	},
+	{ /* 47G */
+		BYTES_TO_WORDS_8(7C, 0D, 1C, 7B, 22, 89, D6, 51),
+		BYTES_TO_WORDS_8(6D, 06, 19, 3E, 58, 31, 5B, DD),
+		BYTES_TO_WORDS_8(BC, 1B, 07, 83, EA, 61, 53, 59),
+		BYTES_TO_WORDS_8(08, 87, 95, 48, CC, 15, C3, 42),
+		BYTES_TO_WORDS_8(B9, B1, F9, B2, 2B, A7, C4, D6),
+		BYTES_TO_WORDS_8(64, F1, 87, EB, E1, A1, F1, 74),
+		BYTES_TO_WORDS_8(90, 79, 7A, BB, DF, D1, 14, 29),
+		BYTES_TO_WORDS_8(85, 95, 1B, 57, CE, 61, 9A, 64),
+	},
+	{ /* 49G */
+		BYTES_TO_WORDS_8(55, 44, 67, A5, E6, 8C, 22, 7D),
+		BYTES_TO_WORDS_8(FD, D4, 8F, 75, A9, 7E, FB, 28),
+		BYTES_TO_WORDS_8(05, 6C, 6E, 86, 46, B1, 22, BB),
+		BYTES_TO_WORDS_8(75, 88, 06, 98, E0, B0, 85, F7),
+		BYTES_TO_WORDS_8(08, 24, D6, 10, 0C, 49, BC, E7),
+		BYTES_TO_WORDS_8(0A, A6, 3A, 5F, FD, B6, 04, 4B),
+		BYTES_TO_WORDS_8(41, 5B, 9F, 0D, 7F, 76, 5C, E1),
+		BYTES_TO_WORDS_8(6E, DA, 80, 60, BF, B0, FD, 73),
+	},
+	{ /* 51G */
+		BYTES_TO_WORDS_8(B1, 22, 8E, 01, F0, 60, 43, 04),
+		BYTES_TO_WORDS_8(FF, 08, 10, E8, 56, EB, F7, 95),
+		BYTES_TO_WORDS_8(BC, 68, 1D, 3C, 86, E6, DE, AA),
+		BYTES_TO_WORDS_8(3E, E4, 9D, 4D, 51, 4A, 2C, 67),
+		BYTES_TO_WORDS_8(04, 71, F3, 91, 91, 39, 35, 99),
+		BYTES_TO_WORDS_8(41, D9, 04, 97, 58, 46, 62, 13),
+		BYTES_TO_WORDS_8(F7, 03, E2, AC, A4, E5, 1D, 61),
+		BYTES_TO_WORDS_8(FE, 5B, A2, 96, 91, 7E, 8C, 54),
+	},
+	{ /* 53G */
+		BYTES_TO_WORDS_8(36, D0, 49, 74, 9F, EC, 26, F1),
+		BYTES_TO_WORDS_8(83, B9, E9, 8D, A7, 1C, 2B, 98),
+		BYTES_TO_WORDS_8(39, 80, B8, 54, 22, 80, 47, 5A),
+		BYTES_TO_WORDS_8(45, 52, D9, C9, 49, BD, 01, 6F),
+		BYTES_TO_WORDS_8(DB, 17, 9E, 98, DD, 33, 02, 36),
+		BYTES_TO_WORDS_8(08, 9B, 74, C3, BF, 51, 85, A7),
+		BYTES_TO_WORDS_8(CE, 76, 87, 60, 1A, F2, A0, 11),
+		BYTES_TO_WORDS_8(AB, DE, D5, F1, 0F, 08, 62, 15),
+	},
+	{ /* 55G */
+		BYTES_TO_WORDS_8(A0, 60, 6E, DF, F7, DF, C1, DE),
+		BYTES_TO_WORDS_8(DA, EA, C1, 62, B7, 95, A5, C2),
+		BYTES_TO_WORDS_8(2C, EA, 7F, FE, 09, A1, 71, 75),
+		BYTES_TO_WORDS_8(26, C9, 68, A0, 7B, BA, 9D, 07),
+		BYTES_TO_WORDS_8(EA, 4D, 82, B4, AE, A5, 0D, FB),
+		BYTES_TO_WORDS_8(97, A3, 51, 57, F3, 2D, EB, 83),
+		BYTES_TO_WORDS_8(AB, 88, 95, 2A, 9D, 3F, 22, 1D),
+		BYTES_TO_WORDS_8(81, D1, D4, 43, B7, 19, 1E, DC),
+	},
+	{ /* 57G */
+		BYTES_TO_WORDS_8(77, 60, F5, D0, B1, 97, BD, 8A),
+		BYTES_TO_WORDS_8(D8, 6B, 6C, 2D, 6E, 40, 9D, 28),
+		BYTES_TO_WORDS_8(86, 7F, 90, EA, A8, 45, 6D, 12),
+		BYTES_TO_WORDS_8(65, 28, 4D, BB, 0E, E3, 16, C1),
+		BYTES_TO_WORDS_8(06, C2, 10, A4, FD, D7, 3F, 31),
+		BYTES_TO_WORDS_8(C5, C8, 59, 9E, E8, D5, 5B, 7D),
+		BYTES_TO_WORDS_8(65, 87, 3B, B1, 9B, 6D, B1, B8),
+		BYTES_TO_WORDS_8(C2, 30, 5B, C3, 23, 88, 47, E9),
+	},
+	{ /* 59G */
+		BYTES_TO_WORDS_8(45, 4B, AA, 0F, 0E, EA, B6, A2),
+		BYTES_TO_WORDS_8(EC, C8, 8D, 9E, 11, 41, 09, E5),
+		BYTES_TO_WORDS_8(F7, BD, A9, FC, 84, 27, 5B, 76),
+		BYTES_TO_WORDS_8(37, 64, 0C, FE, 6F, 1A, 5F, 66),
+		BYTES_TO_WORDS_8(CF, 4C, 7F, 2B, 60, A6, 25, 6E),
+		BYTES_TO_WORDS_8(BC, 15, E2, 81, BF, E5, ED, 7D),
+		BYTES_TO_WORDS_8(7F, C3, EA, F7, 29, CA, 8C, 6E),
+		BYTES_TO_WORDS_8(C2, 18, FD, 9F, A4, 2C, 0E, 49),
+	},
+	{ /* 61G */
+		BYTES_TO_WORDS_8(0E, AF, 32, 0D, 38, AC, 39, 59),
+		BYTES_TO_WORDS_8(D5, 4F, 72, 8B, A0, 10, 79, 3E),
+		BYTES_TO_WORDS_8(01, 00, 99, 8D, 3D, 6B, 3A, 2D),
+		BYTES_TO_WORDS_8(9A, DA, D3, ED, 19, CB, 9C, 05),
+		BYTES_TO_WORDS_8(D1, 91, FE, 97, 3C, 1E, 8E, 92),
+		BYTES_TO_WORDS_8(CD, CE, 56, 39, A3, F7, 21, 16),
+		BYTES_TO_WORDS_8(8E, 63, 45, 93, 1B, 28, 65, DA),
+		BYTES_TO_WORDS_8(59, 91, D4, CA, EC, D7, 6A, BB),
+	},
+	{ /* 63G */
+		BYTES_TO_WORDS_8(C1, DA, 8B, 5D, 82, 90, A2, 32),
+		BYTES_TO_WORDS_8(38, CD, A7, 01, AF, C8, 53, DF),
+		BYTES_TO_WORDS_8(8F, 7D, CC, 8A, A0, 28, 1F, 2A),
+		BYTES_TO_WORDS_8(80, DC, F5, 5B, D8, 01, 95, 6A),
+		BYTES_TO_WORDS_8(A3, F1, 1E, 5F, 3D, F5, AF, 30),
+		BYTES_TO_WORDS_8(35, 6F, 7A, 69, 5C, 1B, 46, F8),
+		BYTES_TO_WORDS_8(A3, 56, 3C, 4A, E4, C6, C6, 81),
+		BYTES_TO_WORDS_8(43, 37, 47, 93, D1, 0A, 64, CA),
+	},
+#endif
+#if uECC_VERIFY_G_WINDOW >= 8
+	{ /* 65G */
+		BYTES_TO_WORDS_8(10, 34, EA, 54, C2, 2E, AA, 11),
+		BYTES_TO_WORDS_8(66, 9F, F3, CB, AF, 46, 70, 9C),
+		BYTES_TO_WORDS_8(E0, D5, 7D, 53, 35, 05, 3D, 34),
+		BYTES_TO_WORDS_8(5B, 8E, 8D, 45, CB, 5D, 32, 34),
+		BYTES_TO_WORDS_8(C9, 69, C8, F3, 01, 16, 3B, 6F),
+		BYTES_TO_WORDS_8(B8, FE, 76, AD, 3E, EB, 4D, 79),
+		BYTES_TO_WORDS_8(18, 67, 67, 49, 8C, 23, CD, 96),
+		BYTES_TO_WORDS_8(47, 55, 29, 50, DC, D1, 68, 85),
+	},
+	{ /* 67G */
+		BYTES_TO_WORDS_8(3C, 48, A6, 10, 0B, CD, 16, D9),
+		BYTES_TO_WORDS_8(F8, 6F, 59, CE, 29, 65, 6A, A4),
+		BYTES_TO_WORDS_8(83, 68, 46, 52, 7B, 89, EF, EA),
+		BYTES_TO_WORDS_8(8C, FA, 22, B6, 3C, 03, 27, 2D),
+		BYTES_TO_WORDS_8(B2, 31, C3, ED, F4, 4B, 9A, 59),
+		BYTES_TO_WORDS_8(F9, 7B, 14, AB, 94, D5, 05, 2A),
+		BYTES_TO_WORDS_8(88, 26, 83, 09, 6D, 3F, 12, D0),
+		BYTES_TO_WORDS_8(A4, 92, 8E, 14, 93, 74, 17, EA),
+	},
+	{ /* 69G */
+		BYTES_TO_WORDS_8(FE, 74, 18, 5C, 9F, 2B, B8, 1D),
+		BYTES_TO_WORDS_8(B2, 59, 74, 6B, 23, 33, AB, 1B),
+		BYTES_TO_WORDS_8(85, 55, CB, 99, A2, 03, 0D, E9),
+		BYTES_TO_WORDS_8(0B, 81, 65, 15, 01, 0A, 91, 52),
+		BYTES_TO_WORDS_8(62, A5, 42, CA, 04, 25, 2B, DD),
+		BYTES_TO_WORDS_8(33, 72, 59, 4C, FC, 0F, 49, 05),
+		BYTES_TO_WORDS_8(D1, DF, BC, 65, 18, 2B, 1C, 51),
+		BYTES_TO_WORDS_8(8D, 52, 60, F6, 39, 33, D0, E3),
+	},
+	{ /* 71G */
+		BYTES_TO_WORDS_8(69, E9, 60, 92, 9D, BB, 49, 8B),
+		BYTES_TO_WORDS_8(DA, A1, F2, BF, B0, 27, AE, 9F),
+		BYTES_TO_WORDS_8(0A, DC, 01, F6, 7C, 89, 5D, AA),
+		BYTES_TO_WORDS_8(6A, 9F, F2, 4A, 57, 20, 4B, 6E),
+		BYTES_TO_WORDS_8(13, 62, A1, AF, 58, 3C, AC, C0),
+		BYTES_TO_WORDS_8(59, 46, D0, EF, 54, 7C, 93, 3E),
+		BYTES_TO_WORDS_8(D2, B1, 96, 08, AD, EA, D7, 46),
+		BYTES_TO_WORDS_8(26, 4F, 6C, A8, EE, 96, D4, 61),
+	},
+	{ /* 73G */
+		BYTES_TO_WORDS_8(CD, 40, 49, CC, 63, 0E, 92, 36),
+		BYTES_TO_WORDS_8(13, 4A, 29, EF, 3B, 95, 2B, D6),
+		BYTES_TO_WORDS_8(98, A1, 46, BB, 1D, D5, 57, 44),
+		BYTES_TO_WORDS_8(24, 06, 61, 3E, BA, 4B, 2C, 39),
+		BYTES_TO_WORDS_8(D2, 6B, 14, 87, 82, D5, DE, 5F),
+		BYTES_TO_WORDS_8(09, 22, 88, 56, 79, 86, FD, FC),
+		BYTES_TO_WORDS_8(91, 4C, 59, 6B, BF, D7, C3, B3),
+		BYTES_TO_WORDS_8(9D, 84, AF, D6, 1A, 82, 0C, E5),
+	},
+	{ /* 75G */
+		BYTES_TO_WORDS_8(4B, 93, 21, E0, 29, ED, D5, 6C),
+		BYTES_TO_WORDS_8(FC, D4, BB, 71, CD, 43, A0, 61),
+		BYTES_TO_WORDS_8(05, 24, 43, D4, EE, D4, 1C, 3E),
+		BYTES_TO_WORDS_8(1F, 43, 81, DD, 0F, 5A, 43, 8D),
+		BYTES_TO_WORDS_8(AC, D1, A1, EA, EC, 1C, 8F, 96),
+		BYTES_TO_WORDS_8(9B, EB, FE, 75, 94, CE, F9, 08),
+		BYTES_TO_WORDS_8(76, 10, 67, 2A, CB, 12, 29, 53),
+		BYTES_TO_WORDS_8(85, 2C, B3, 81, 36, 43, D8, BC),
+	},
+	{ /* 77G */
+		BYTES_TO_WORDS_8(7B, BE, 93, 08, 34, 71, D8, 17),
+		BYTES_TO_WORDS_8(C0, 29, 80, B3, 21, E0, EF, F4),
+		BYTES_TO_WORDS_8(20, C7, D5, 72, EB, 18, 9D, 1A),
+		BYTES_TO_WORDS_8(25, 77, A2, DB, 02, B0, 21, 58),
+		BYTES_TO_WORDS_8(63, 23, 9F, E5, 40, 95, BE, 1B),
+		BYTES_TO_WORDS_8(C3, D1, DE, 25, F1, 04, 9C, 86),
+		BYTES_TO_WORDS_8(66, 58, FF, 3F, F6, 62, 9B, DF),
+		BYTES_TO_WORDS_8(34, 85, 53, 7A, D6, 12, EC, 23),
+	},
+	{ /* 79G */
+		BYTES_TO_WORDS_8(57, 29, 22, F0, 4D, C7, DB, D4),
+		BYTES_TO_WORDS_8(8B, 8B, B5, DC, E1, 89, 42, 62),
+		BYTES_TO_WORDS_8(25, A6, AE, D3, 96, F2, 1E, 12),
+		BYTES_TO_WORDS_8(77, BF, EE, 4B, D3, F3, D2, DB),
+		BYTES_TO_WORDS_8(9F, FB, 38, 38, 3B, 4B, 34, 3E),
+		BYTES_TO_WORDS_8(9E, 80, DB, 3E, 13, 52, 7E, 58),
+		BYTES_TO_WORDS_8(34, ED, 26, BC, 0A, 89, 3E, EB),
+		BYTES_TO_WORDS_8(D0, 62, 57, 7E, BE, 6B, A1, 94),
+	},
+	{ /* 81G */
+		BYTES_TO_WORDS_8(72, B0, A3, A8, C2, F0, DC, 2C),
+		BYTES_TO_WORDS_8(B1, B9, 0B, 70, 96, 1B, 2A, 1E),
+		BYTES_TO_WORDS_8(91, 2E, C7, 3D, 09, C3, 64, 84),
+		BYTES_TO_WORDS_8(8C, 35, ED, 2E, 2D, AB, 29, D8),
+		BYTES_TO_WORDS_8(5E, 77, 43, B5, B0, C0, 3B, CF),
+		BYTES_TO_WORDS_8(F7, AA, 06, D4, E2, 73, 62, 16),
+		BYTES_TO_WORDS_8(59, 80, 59, 2A, BE, C7, F6, E1),
+		BYTES_TO_WORDS_8(99, E8, CA, 59, E4, BB, C1, 3E),
+	},
+	{ /* 83G */
+		BYTES_TO_WORDS_8(E8, 45, E0, 67, C8, 45, B9, 28),
+		BYTES_TO_WORDS_8(BD, A0, 1A, FE, DD, 6E, 1E, 63),
+		BYTES_TO_WORDS_8(57, 0A, 63, 85, 02, FE, E3, 61),
+		BYTES_TO_WORDS_8(57, DA, FD, 82, A6, 1D, F0, 8F),
+		BYTES_TO_WORDS_8(D8, 52, 7D, 1B, 1B, 9B, 03, 5E),
+		BYTES_TO_WORDS_8(7F, 55, 0F, 7B, EC, 5C, 56, 72),
+		BYTES_TO_WORDS_8(B4, 38, 80, E5, E2, 91, 52, 64),
+		BYTES_TO_WORDS_8(92, BC, 09, F7, 1E, B9, E3, 3B),
+	},
+	{ /* 85G */
+		BYTES_TO_WORDS_8(8B, 4E, F6, C9, A1, FE, 97, 1F),
+		BYTES_TO_WORDS_8(75, 91, AB, 5D, F9, F1, 42, A9),
+		BYTES_TO_WORDS_8(42, D2, BD, 65, CF, A9, BE, 3F),
+		BYTES_TO_WORDS_8(0E, FC, AF, 1C, 19, 67, D0, 84),
+		BYTES_TO_WORDS_8(D9, 00, 09, B3, D4, BC, 6F, C4),
+		BYTES_TO_WORDS_8(83, F6, 1E, 35, 7C, 4A, 30, 61),
+		BYTES_TO_WORDS_8(B3, F8, F3, CA, 91, FD, 8B, C6),
+		BYTES_TO_WORDS_8(38, EA, B6, F5, 18, D8, C9, D8),
+	},
+	{ /* 87G */
+		BYTES_TO_WORDS_8(FC, 34, 93, 88, 26, C4, 2F, 67),
+		BYTES_TO_WORDS_8(1C, 6F, 29, 9D, 3B, 54, 33, 94),
+		BYTES_TO_WORDS_8(87, 86, E4, AE, 6F, 99, 9D, F4),
+		BYTES_TO_WORDS_8(C5, F9, BF, 3C, 86, EF, B3, D2),
+		BYTES_TO_WORDS_8(0E, 4F, 2F, 8E, 8E, 1C, 51, D4),
+		BYTES_TO_WORDS_8(EB, BA, B1, F1, 97, A7, 1B, 92),
+		BYTES_TO_WORDS_8(3C, F8, 5C, 03, 29, 66, 04, 5B),
+		BYTES_TO_WORDS_8(EE, A8, 25, 10, 00, 7E, 6D, 56),
+	},
+	{ /* 89G */
+		BYTES_TO_WORDS_8(42, 10, 46, 1F, 75, 49, 6A, C9),
+		BYTES_TO_WORDS_8(0F, 58, 1F, 14, 95, FA, B5, 21),
+		BYTES_TO_WORDS_8(FA, 34, 1A, E3, 28, B7, 70, 3E),
+		BYTES_TO_WORDS_8(9A, B4, 84, FD, 62, 9E, 8B, FC),
+		BYTES_TO_WORDS_8(0D, 82, 3D, 4F, 52, B6, 1D, F5),
+		BYTES_TO_WORDS_8(B0, 4A, 01, 5A, 7C, 7B, A7, 6D),
+		BYTES_TO_WORDS_8(08, B6, 63, 0B, CB, 86, FC, 8B),
+		BYTES_TO_WORDS_8(F7, 16, 58, 2A, 7A, 28, B4, D5),
+	},
+	{ /* 91G */
+		BYTES_TO_WORDS_8(CA, 38, 77, 38, 1D, CC, C4, 89),
+		BYTES_TO_WORDS_8(01, 71, 70, BC, 7E, 90, 40, F2),
+		BYTES_TO_WORDS_8(1E, F7, D3, 6D, 43, 19, C6, 30),
+		BYTES_TO_WORDS_8(A1, 6B, DE, C7, E2, E7, A1, 07),
+		BYTES_TO_WORDS_8(49, 70, 3C, 4D, 71, D7, A8, 41),
+		BYTES_TO_WORDS_8(D2, 5D, E4, 58, E1, 3F, 12, 03),
+		BYTES_TO_WORDS_8(6D, 80, 47, CB, 04, 82, 82, B2),
+		BYTES_TO_WORDS_8(FF, D5, 3F, AA, 45, 49, FC, 9C),
+	},
+	{ /* 93G */
+		BYTES_TO_WORDS_8(9D, 4A, 0A, B9, 0A, 9C, 1D, 29),
+		BYTES_TO_WORDS_8(94, E2, 79, 36, 83, CD, 5A, E5),
+		BYTES_TO_WORDS_8(C6, A3, 29, DC, E1, 94, 49, 41),
+		BYTES_TO_WORDS_8(55, A3, 14, 06, 30, C6, 3F, D7),
+		BYTES_TO_WORDS_8(B1, 3E, E8, 78, 11, 94, DD, 31),
+		BYTES_TO_WORDS_8(92, 87, C8, 00, 80, 3D, D4, C0),
+		BYTES_TO_WORDS_8(31, E6, 01, CE, 30, 1C, B7, B1),
+		BYTES_TO_WORDS_8(0D, 9C, D6, 2C, 0E, 6F, ED, 03),
+	},
+	{ /* 95G */
+		BYTES_TO_WORDS_8(74, 27, 46, 7D, 95, 7C, A1, 8A),
+		BYTES_TO_WORDS_8(C8, 88, 43, DD, 0B, 38, F5, ED),
+		BYTES_TO_WORDS_8(C0, B0, A2, A1, EB, E1, F9, 29),
+		BYTES_TO_WORDS_8(13, 0D, 4D, 9B, 02, 62, BD, DA),
+		BYTES_TO_WORDS_8(3F, A9, 7E, A7, 12, C4, 0C, ED),
+		BYTES_TO_WORDS_8(2E, E4, 77, D5, 96, 34, 26, CC),
+		BYTES_TO_WORDS_8(81, 46, 42, 65, 89, 98, CB, 31),
+		BYTES_TO_WORDS_8(CD, 3F, AD, C8, CD, 84, C7, 9A),
+	},
+	{ /* 97G */
+		BYTES_TO_WORDS_8(19, 9A, BF, 34, E6, 49, 19, BF),
+		BYTES_TO_WORDS_8(D3, E6, 7F, D1, 3C, B1, 67, B0),
+		BYTES_TO_WORDS_8(62, AA, 9F, 6B, 41, 8A, BD, B6),
+		BYTES_TO_WORDS_8(D0, 47, 45, 71, 09, 82, 66, 20),
+		BYTES_TO_WORDS_8(83, FD, D1, A9, 65, 49, 6A, 07),
+		BYTES_TO_WORDS_8(BD, 2F, 68, AA, F8, 67, FD, A1),
+		BYTES_TO_WORDS_8(6D, E0, 0D, 93, A8, 38, 57, DE),
+		BYTES_TO_WORDS_8(5D, FE, 68, 01, C8, A8, 3C, 11),
+	},
+	{ /* 99G */
+		BYTES_TO_WORDS_8(9C, 60, 8C, 4C, 17, 83, 0E, 8A),
+		BYTES_TO_WORDS_8(4C, A7, E3, 11, C9, 8D, 68, 49),
+		BYTES_TO_WORDS_8(C7, BC, 1D, 7E, 7E, 85, D0, 1A),
+		BYTES_TO_WORDS_8(F0, E0, AF, B4, 35, 8B, 50, 21),
+		BYTES_TO_WORDS_8(B5, FC, F7, 40, 41, DF, 08, 94),
+		BYTES_TO_WORDS_8(2D, E1, 6F, 44, FC, 53, CD, 8C),
+		BYTES_TO_WORDS_8(E9, 4A, D6, 4A, 41, 1E, 68, 83),
+		BYTES_TO_WORDS_8(CD, E2, 8B, F5, D3, F5, F8, E2),
+	},
+	{ /* 101G */
+		BYTES_TO_WORDS_8(AF, 33, 98, 74, 0E, 0B, AE, 76),
+		BYTES_TO_WORDS_8(C2, 17, E7, FB, 59, D2, 7A, B1),
+		BYTES_TO_WORDS_8(D1, 9A, 26, C7, 94, BF, B3, 85),
+		BYTES_TO_WORDS_8(07, 14, 4A, 9E, 58, 46, C7, CF),
+		BYTES_TO_WORDS_8(F8, 8E, 97, 30, 19, BB, E7, 11),
+		BYTES_TO_WORDS_8(F6, 41, 0E, EF, 6A, 00, A1, E8),
+		BYTES_TO_WORDS_8(2C, 32, 71, E2, 67, 93, 4F, BE),
+		BYTES_TO_WORDS_8(79, E9, 5B, 0B, 02, 5D, E2, 9E),
+	},
+	{ /* 103G */
+		BYTES_TO_WORDS_8(F6, AB, 2A, FC, C1, B1, 3F, 7F),
+		BYTES_TO_WORDS_8(29, ED, D5, 31, 71, 98, 79, F3),
+		BYTES_TO_WORDS_8(D6, 32, 72, 4F, 11, C6, 33, 60),
+		BYTES_TO_WORDS_8(5D, 3F, 2B, 11, FF, 88, F8, 99),
+		BYTES_TO_WORDS_8(67, 6F, CE, DF, 89, 37, 98, FC),
+		BYTES_TO_WORDS_8(82, C2, 6A, 70, B0, A2, BF, E4),
+		BYTES_TO_WORDS_8(2D, 3A, 8B, 3F, D9, 31, 35, 4F),
+		BYTES_TO_WORDS_8(23, 1B, 27, 80, 43, B1, 6C, 5D),
+	},
+	{ /* 105G */
+		BYTES_TO_WORDS_8(C2, 6C, AB, 62, 61, BC, 6B, 49),
+		BYTES_TO_WORDS_8(AA, C3, BB, 9A, DC, 9B, F5, FF),
+		BYTES_TO_WORDS_8(12, FE, B1, 6D, 3E, 31, A8, 70),
+		BYTES_TO_WORDS_8(67, 4A, 90, 52, 9B, 29, CF, D4),
+		BYTES_TO_WORDS_8(F9, 69, 17, E5, 44, 65, 34, F9),
+		BYTES_TO_WORDS_8(1E, 75, 2D, C2, 46, 45, ED, FF),
+		BYTES_TO_WORDS_8(28, 24, 29, 5F, 13, A1, D8, E4),
+		BYTES_TO_WORDS_8(83, 4C, 2A, A5, E7, 4C, 49, FC),
+	},
+	{ /* 107G */
+		BYTES_TO_WORDS_8(7F, CE, 49, E6, CF, 99, EA, D4),
+		BYTES_TO_WORDS_8(BB, 75, 7D, FC, A5, E7, 97, D8),
+		BYTES_TO_WORDS_8(C2, DA, DE, 28, 5D, 91, 7A, E7),
+		BYTES_TO_WORDS_8(C3, 1F, AC, 9A, 0B, C9, C1, F9),
+		BYTES_TO_WORDS_8(6B, A0, 54, FA, 2D, 3C, 11, AB),
+		BYTES_TO_WORDS_8(DC, D3, 38, 5D, 23, EC, 4B, 14),
+		BYTES_TO_WORDS_8(7F, 1A, 2F, EF, E2, 9E, 42, 42),
+		BYTES_TO_WORDS_8(38, CD, 44, A8, 67, EB, 7D, 7C),
+	},
+	{ /* 109G */
+		BYTES_TO_WORDS_8(43, 5F, 58, 39, 12, 19, 32, 04),
+		BYTES_TO_WORDS_8(24, 76, A1, B9, 1E, D2, 00, 57),
+		BYTES_TO_WORDS_8(3B, 99, 19, 90, 89, 9F, 39, 72),
+		BYTES_TO_WORDS_8(A1, 7F, 25, 07, 04, 9C, 94, 05),
+		BYTES_TO_WORDS_8(06, 36, 23, F7, 7B, 1E, 40, 07),
+		BYTES_TO_WORDS_8(D9, F1, 71, DC, E8, D4, F0, 9B),
+		BYTES_TO_WORDS_8(59, 17, DB, 12, 73, F1, DF, 45),
+		BYTES_TO_WORDS_8(56, 97, C3, 1D, EA, D7, F1, BD),
+	},
+	{ /* 111G */
+		BYTES_TO_WORDS_8(9E, 08, 5B, B8, CD, CC, D2, CA),
+		BYTES_TO_WORDS_8(B1, 3C, 06, E8, 2B, 00, 33, 62),
+		BYTES_TO_WORDS_8(4F, 72, 93, 10, AE, C0, E2, 0F),
+		BYTES_TO_WORDS_8(9B, 67, 1F, 7A, 06, 24, C4, 3F),
+		BYTES_TO_WORDS_8(CF, 9E, 62, C6, F8, AE, AA, 66),
+		BYTES_TO_WORDS_8(94, 4C, 93, F7, 00, C8, 9F, CF),
+		BYTES_TO_WORDS_8(26, 8D, A9, ED, 47, BB, ED, 2A),
+		BYTES_TO_WORDS_8(E5, 1B, 58, 9E, 00, 43, B2, 5B),
+	},
+	{ /* 113G */
+		BYTES_TO_WORDS_8(13, 5E, D8, 04, 30, 1A, 3C, A7),
+		BYTES_TO_WORDS_8(E1, BF, B4, F5, D7, 00, 41, 8E),
+		BYTES_TO_WORDS_8(D7, 3F, C1, 88, BF, 26, 7D, 46),
+		BYTES_TO_WORDS_8(4D, 45, A9, 96, 6B, 47, E3, 95),
+		BYTES_TO_WORDS_8(CA, BC, B7, 32, A1, 92, FD, 9B),
+		BYTES_TO_WORDS_8(8E, 22, 30, C8, D4, F9, 43, 40),
+		BYTES_TO_WORDS_8(EC, E0, 40, F3, F9, CB, 8D, A8),
+		BYTES_TO_WORDS_8(50, 75, 0F, A1, 5E, 64, 76, 46),
+	},
+	{ /* 115G */
+		BYTES_TO_WORDS_8(E4, 50, 6B, 40, 71, 46, BC, F4),
+		BYTES_TO_WORDS_8(8D, B1, 09, 22, D5, B8, CB, 03),
+		BYTES_TO_WORDS_8(BA, 7B, B6, EC, 37, 66, 6E, 8F),
+		BYTES_TO_WORDS_8(E3, 8F, 97, A3, F0, A5, EF, 49),
+		BYTES_TO_WORDS_8(72, F8, EE, 6D, 6A, 0C, 21, B7),
+		BYTES_TO_WORDS_8(71, 53, 55, CB, 6A, E0, D2, 0B),
+		BYTES_TO_WORDS_8(35, 3B, 15, AC, 2B, FF, 48, 91),
+		BYTES_TO_WORDS_8(52, 34, E9, 05, 36, C5, 51, 85),
+	},
+	{ /* 117G */
+		BYTES_TO_WORDS_8(2D, 6F, E1, 3D, 31, EF, 97, A6),
+		BYTES_TO_WORDS_8(83, 12, B9, B2, 83, 03, 85, 72),
+		BYTES_TO_WORDS_8(B0, C5, 97, 04, 20, 77, BD, 45),
+		BYTES_TO_WORDS_8(48, 10, 3D, 0C, 0C, F0, D9, F9),
+		BYTES_TO_WORDS_8(09, 4E, C3, A4, D1, E9, F8, 85),
+		BYTES_TO_WORDS_8(BA, 6C, 2B, B9, 6D, EF, 99, 4D),
+		BYTES_TO_WORDS_8(CD, 8F, 7B, 53, 6A, 88, 3F, 47),
+		BYTES_TO_WORDS_8(79, 4E, 15, 04, F4, E1, DE, 0D),
+	},
+	{ /* 119G */
+		BYTES_TO_WORDS_8(C5, 20, 5A, 4D, 1D, 9B, 9C, D1),
+		BYTES_TO_WORDS_8(23, B2, A4, 2B, AE, 2E, AF, 41),
+		BYTES_TO_WORDS_8(AF, A0, 6F, 26, 17, 32, F3, 59),
+		BYTES_TO_WORDS_8(68, 47, 20, F0, 73, 19, 0F, 05),
+		BYTES_TO_WORDS_8(F0, 6D, E1, 92, 10, 3A, 2B, B0),
+		BYTES_TO_WORDS_8(AE, 40, B5, B6, A9, E0, D0, 13),
+		BYTES_TO_WORDS_8(AF, FE, 72, A2, A5, A9, FE, D1),
+		BYTES_TO_WORDS_8(2A, DF, 64, 8D, EF, 23, A7, E3),
+	},
+	{ /* 121G */
+		BYTES_TO_WORDS_8(69, 7A, CB, 00, 63, E9, A7, AD),
+		BYTES_TO_WORDS_8(6E, D8, 6C, B2, 4D, 4E, C0, BE),
+		BYTES_TO_WORDS_8(1B, 74, F6, 8A, FC, 4C, AA, D9),
+		BYTES_TO_WORDS_8(73, 70, 0E, FF, 2A, 6B, 8E, E7),
+		BYTES_TO_WORDS_8(C8, 38, 16, 31, 73, EA, 68, 3B),
+		BYTES_TO_WORDS_8(7D, 6B, 49, B0, 42, 2B, 04, C3),
+		BYTES_TO_WORDS_8(A8, EE, DA, AD, 99, A2, 36, 9E),
+		BYTES_TO_WORDS_8(DE, 7B, C8, E6, B0, 2E, 44, 14),
+	},
+	{ /* 123G */
+		BYTES_TO_WORDS_8(39, AC, 9A, E9, 7B, 23, 2B, 7C),
+		BYTES_TO_WORDS_8(02, 4F, 02, B0, F9, C3, E7, 19),
+		BYTES_TO_WORDS_8(77, C4, FE, 97, 72, 74, 84, DD),
+		BYTES_TO_WORDS_8(D0, 47, A5, D2, 2B, 6C, 1A, 81),
+		BYTES_TO_WORDS_8(64, FF, 83, D0, C4, A0, 2A, A1),
+		BYTES_TO_WORDS_8(72, 8F, 36, 18, 6F, EC, 8C, 05),
+		BYTES_TO_WORDS_8(D6, FE, 4B, EA, F5, A0, 24, 15),
+		BYTES_TO_WORDS_8(CB, D0, 63, D1, CB, 0A, 23, A9),
+	},
+	{ /* 125G */
+		BYTES_TO_WORDS_8(56, 89, 24, 32, 37, 2D, 9B, EC),
+		BYTES_TO_WORDS_8(6D, DB, 05, EC, 6E, DB, 27, E8),
+		BYTES_TO_WORDS_8(C6, 38, 15, 7C, 49, 1B, 3B, D8),
+		BYTES_TO_WORDS_8(DE, 85, D3, 4E, B9, E1, C7, 8A),
+		BYTES_TO_WORDS_8(3C, E6, B1, AD, 4A, 4C, 75, 01),
+		BYTES_TO_WORDS_8(D8, 43, 97, C8, BF, F1, 44, 64),
+		BYTES_TO_WORDS_8(48, 8A, 44, E2, D8, CF, 67, 70),
+		BYTES_TO_WORDS_8(B5, CC, 13, 39, 27, 5C, C1, 2B),
+	},
+	{ /* 127G */
+		BYTES_TO_WORDS_8(3C, 62, 2D, C4, FA, BD, CE, 67),
+		BYTES_TO_WORDS_8(35, AD, AA, C6, 58, EB, D4, A8),
+		BYTES_TO_WORDS_8(13, 60, F1, 65, A7, D0, A5, D2),
+		BYTES_TO_WORDS_8(E2, A8, AC, 6B, DB, 45, 4D, 53),
+		BYTES_TO_WORDS_8(0C, 50, 9E, 41, 64, F6, FD, 17),
+		BYTES_TO_WORDS_8(1D, 63, 3A, F2, E0, 93, F0, EE),
+		BYTES_TO_WORDS_8(C8, CE, 2C, 99, 7F, 35, 54, 41),
+		BYTES_TO_WORDS_8(E4, 54, 2A, 9A, C8, 69, D6, FA),
+	},
+#endif
+};
@@ -33,6 +33,18 @@
 /* Uncomment for ECDSA signatures using curve P-256. */
 /* #define MCUBOOT_SIGN_EC256 */
 
+/* Uncomment for Ed25519 signatures. */
+/* #define MCUBOOT_SIGN_ED25519 */
+
+#ifdef MCUBOOT_SIGN_ED25519
+/* Number of decoded public keys kept in RAM, about 200 bytes each (1 if
+ * not defined, 0 to disable). */
+/* #define MCUBOOT_ED25519_CACHED_KEYS 1 */
+/* Uncomment to check signatures with 32 multiples of the base point instead
+ * of 8, which is faster and takes 2.8 KiB more flash. */
+/* #define MCUBOOT_ED25519_LARGE_B_TABLE */
+#endif
+
 
 /*
  * Upgrade mode
@@ -51,6 +63,12 @@
 /* #define MCUBOOT_OVERWRITE_ONLY_FAST */
 #endif
 
+#ifndef MCUBOOT_OVERWRITE_ONLY
+/* Uncomment to leave sectors which hold the same data in both slots
+ * untouched when swapping, which speeds up incremental upgrades. */
+/* #define MCUBOOT_SWAP_SKIP_IDENTICAL */
+#endif
+
 /*
  * Cryptographic settings
  *
@@ -64,6 +82,23 @@
 /* Uncomment to use Tinycrypt's. */
 /* #define MCUBOOT_USE_TINYCRYPT */
 
+/*
+ * Uncomment to hash images with bootutil's own SHA256, whatever the library
+ * above.  Also uncomment MCUBOOT_SHA256_PLATFORM_BLOCKS if the port provides
+ * a faster bootutil_sha256_platform_blocks(), e.g. using a hash accelerator.
+ */
+/* #define MCUBOOT_USE_BOOTUTIL_SHA256 */
+/* #define MCUBOOT_SHA256_PLATFORM_BLOCKS */
+
+/*
+ * Uncomment one of these to hash images with SHA384 or SHA512 instead of
+ * SHA256 (imgtool's --hash option).  Not supported with RSA signatures nor
+ * with MCUBOOT_HASH_CHUNKS; with TinyCrypt, ext/tinycrypt-sha512 must be
+ * built in.
+ */
+/* #define MCUBOOT_SHA384 */
+/* #define MCUBOOT_SHA512 */
+
 /*
  * Always check the signature of the image in the primary slot before booting,
  * even if no upgrade was performed. This is recommended if the boot
@@ -71,6 +106,38 @@
  */
 #define MCUBOOT_VALIDATE_PRIMARY_SLOT
 
+/*
+ * Uncomment to accept images whose signed hash covers a list of per-chunk
+ * digests (imgtool's --hash-chunk-size), which are rejected on the first
+ * bad chunk.
+ */
+/* #define MCUBOOT_HASH_CHUNKS */
+
+/*
+ * Uncomment to record in the primary slot's trailer, authenticated with a
+ * device-unique key, that its image was validated, and to only check that
+ * record on later boots.  The port must implement
+ * boot_validated_record_key_get() from bootutil/validated_record.h.
+ */
+/* #define MCUBOOT_VALIDATED_RECORD */
+
+/*
+ * Uncomment to compute the hash of a new image while the upgrade copies it
+ * into the primary slot, when it does so in order (overwrite only, swap
+ * using move), so that the validation of the primary slot that follows
+ * doesn't read the slot again.
+ */
+/* #define MCUBOOT_HASH_ON_COPY */
+
+/*
+ * Uncomment to hash and check the primary slots of all images first, and
+ * then verify their Ed25519 signatures together, which is faster than one
+ * at a time.  All Ed25519 signatures are then checked with the cofactored
+ * equation, as a batch must be.  Needs MCUBOOT_VALIDATE_PRIMARY_SLOT and
+ * MCUBOOT_SIGN_ED25519.
+ */
+/* #define MCUBOOT_BATCH_VERIFY */
+
 /*
  * Flash abstraction
  */
@@ -79,10 +146,45 @@
  * See the flash APIs for more details. */
 /* #define MCUBOOT_USE_FLASH_AREA_GET_SECTORS */
 
+/* Uncomment if your flash map API supports flash_area_write_submit() and
+ * flash_area_write_complete(). Image copies then overlap reading the next
+ * chunk with programming the previous one. */
+/* #define MCUBOOT_USE_FLASH_ASYNC */
+
+/* Uncomment if your flash map API supports flash_area_erase_sizes().
+ * Adjacent sectors are then erased together using the largest block
+ * erase the flash device supports. */
+/* #define MCUBOOT_USE_FLASH_ERASE_SIZES */
+
+/* Uncomment if your flash map API supports flash_area_get_mapped().
+ * Images in memory-mapped flash are then hashed in place instead of
+ * being copied to a buffer first. */
+/* #define MCUBOOT_USE_FLASH_MAPPED */
+
 /* Default maximum number of flash sectors per image slot; change
  * as desirable. */
 #define MCUBOOT_MAX_IMG_SECTORS 128
 
+/* Uncomment if the image slots and the scratch area are all made of sectors
+ * of the same size.  The sector layout is then fixed at build time, and the
+ * flash map's sector functions are not used, except that with
+ * MCUBOOT_HAVE_ASSERT_H and MCUBOOT_USE_FLASH_AREA_GET_SECTORS each area is
+ * checked once against flash_area_get_sectors(). */
+/* #define MCUBOOT_UNIFORM_SECTOR_SIZE 4096 */
+
+/* Uncomment to store the sector layout of each area as runs of equally
+ * sized sectors rather than one entry per sector; the value is the maximum
+ * number of runs in an area.  Not compatible with
+ * MCUBOOT_UNIFORM_SECTOR_SIZE. */
+/* #define MCUBOOT_MAX_SECTOR_RUNS 4 */
+
+/* Size and alignment of the buffers used to copy and hash images; the
+ * size should preferably be a multiple of the flash program page size.
+ * An alignment above 8 also needs MCUBOOT_BUF_ALIGN_ATTR, the compiler
+ * attribute producing it, e.g. __attribute__((aligned(32))) with GCC. */
+#define MCUBOOT_BUF_SZ 1024
+#define MCUBOOT_BUF_ALIGN 8
+
 /* Default number of separately updateable images; change in case of
  * multiple images. */
 #define MCUBOOT_IMAGE_NUMBER 1
@@ -121,6 +223,18 @@
  * "assert" is used. */
 /* #define MCUBOOT_HAVE_ASSERT_H */
 
+/*
+ * Signature timing
+ */
+
+/* Uncomment to log how long each image signature check takes, in the
+ * units of MCUBOOT_CYCLE_COUNT(), which must then return a free running
+ * 32-bit counter, such as the CPU cycle counter.
+ *
+ * #define MCUBOOT_SIG_VERIFY_TIMING
+ * #define MCUBOOT_CYCLE_COUNT() read_cycle_counter()
+ */
+
 /*
  * Watchdog feeding
  */
@@ -0,0 +1,69 @@
+#! /usr/bin/env python3
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Generate the table of odd multiples of the P-256 generator used by
+TinyCrypt's uECC_verify() when built with uECC_VERIFY_G_WINDOW.
+
+    ./scripts/ecc_g_table.py > ext/tinycrypt/lib/source/ecc_dsa_g_table.h
+"""
+
+P = 0xffffffff00000001000000000000000000000000ffffffffffffffffffffffff
+GX = 0x6b17d1f2e12c4247f8bce6e563a440f277037d812deb33a0f4a13945d898c296
+GY = 0x4fe342e2fe1a7f9b8ee7eb4a7c0f9e162bce33576b315ececbb6406837bf51f5
+
+# Largest window supported, giving 2^(MAX_WINDOW-2) points.
+MAX_WINDOW = 8
+
+
+def add(a, b):
+    """Add two distinct affine points."""
+    lam = (b[1] - a[1]) * pow(b[0] - a[0], P - 2, P) % P
+    x = (lam * lam - a[0] - b[0]) % P
+    return (x, (lam * (a[0] - x) - a[1]) % P)
+
+
+def double(a):
+    lam = (3 * a[0] * a[0] - 3) * pow(2 * a[1], P - 2, P) % P
+    x = (lam * lam - 2 * a[0]) % P
+    return (x, (lam * (a[0] - x) - a[1]) % P)
+
+
+def words(value):
+    """Format a coordinate the way TinyCrypt's curve constants are."""
+    data = value.to_bytes(32, 'little')
+    return ["BYTES_TO_WORDS_8({})".format(
+                ", ".join("{:02X}".format(b) for b in data[i:i+8]))
+            for i in range(0, 32, 8)]
+
+
+def main():
+    g2 = double((GX, GY))
+    points = [(GX, GY)]
+    for _ in range(1, 1 << (MAX_WINDOW - 2)):
+        points.append(add(points[-1], g2))
+
+    print("/* Autogenerated by scripts/ecc_g_table.py, do not edit. */")
+    print()
+    print("/*")
+    print(" * (2i + 1)G for the P-256 generator G, in affine coordinates.  Only")
+    print(" * the 2^(uECC_VERIFY_G_WINDOW - 2) points used are built in.")
+    print(" */")
+    print("static const uECC_word_t "
+          "ecc_g_odd_multiples[G_POINTS][NUM_ECC_WORDS * 2] = {")
+    for i, (x, y) in enumerate(points):
+        if i > 0 and i & (i - 1) == 0:
+            if i > 1:
+                print("#endif")
+            print("#if uECC_VERIFY_G_WINDOW >= {}".format(i.bit_length() + 2))
+        print("\t{{ /* {}G */".format(2 * i + 1))
+        for w in words(x) + words(y):
+            print("\t\t{},".format(w))
+        print("\t},")
+    print("#endif")
+    print("};")
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,72 @@
+#! /usr/bin/env python3
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Generate the odd multiples of the Ed25519 base point B, beyond the eight in
+curve25519_tables.h, used by ED25519_verify() when built with
+MCUBOOT_ED25519_LARGE_B_TABLE.
+
+    ./scripts/ed25519_b_table.py > ext/fiat/src/curve25519_b_table.h
+"""
+
+P = 2**255 - 19
+D = -121665 * pow(121666, P - 2, P) % P
+BY = 4 * pow(5, P - 2, P) % P
+BX = 15112221349535400772501151409588531511454012693041857206046113283949847762202
+
+# Width of the signed digits, giving 2^(WINDOW-2) points.
+WINDOW = 7
+# Points already in Bi[] of curve25519_tables.h.
+SMALL_POINTS = 8
+
+
+def add(a, b):
+    """Add two affine points of the twisted Edwards curve."""
+    t = D * a[0] * b[0] * a[1] * b[1] % P
+    x = (a[0] * b[1] + a[1] * b[0]) * pow(1 + t, P - 2, P) % P
+    y = (a[1] * b[1] + a[0] * b[0]) * pow(1 - t, P - 2, P) % P
+    return (x, y)
+
+
+def limbs(value):
+    """Split a field element into fiat's 26 and 25 bit limbs."""
+    out = []
+    for i in range(10):
+        bits = 26 if i % 2 == 0 else 25
+        out.append(value & ((1 << bits) - 1))
+        value >>= bits
+    return out
+
+
+def fe(value):
+    values = [str(v) for v in limbs(value)]
+    return "        {{{{{}}}}},".format(
+        ",\n          ".join([", ".join(values[:7]), ", ".join(values[7:])]))
+
+
+def main():
+    assert (BX * BX * -1 + BY * BY - 1 - D * BX * BX * BY * BY) % P == 0
+
+    b2 = add((BX, BY), (BX, BY))
+    points = [(BX, BY)]
+    for _ in range(1, 1 << (WINDOW - 2)):
+        points.append(add(points[-1], b2))
+
+    print("// This file is generated from")
+    print("//    ./scripts/ed25519_b_table.py > curve25519_b_table.h")
+    print()
+    print("// Bi_large[i] = (2*(i+{})+1)*B".format(SMALL_POINTS))
+    print("static const ge_precomp Bi_large[{}] = {{".format(
+        len(points) - SMALL_POINTS))
+    for x, y in points[SMALL_POINTS:]:
+        print("    {")
+        print(fe((y + x) % P))
+        print(fe((y - x) % P))
+        print(fe(2 * D * x * y % P))
+        print("    },")
+    print("};")
+
+
+if __name__ == '__main__':
+    main()
@@ -26,8 +26,9 @@ from intelhex import IntelHex
 import hashlib
 import struct
 import os.path
-from .keys import rsa, ecdsa
+from .keys import rsa, ecdsa, x25519, aeskw
 from cryptography.hazmat.primitives.asymmetric import ec, padding
+from cryptography.hazmat.primitives.asymmetric.x25519 import X25519PrivateKey
 from cryptography.hazmat.primitives.ciphers import Cipher, algorithms, modes
 from cryptography.hazmat.primitives.kdf.hkdf import HKDF
 from cryptography.hazmat.primitives.serialization import Encoding, PublicFormat
@@ -41,6 +42,7 @@ BIN_EXT = "bin"
 INTEL_HEX_EXT = "hex"
 DEFAULT_MAX_SECTORS = 128
 MAX_ALIGN = 8
+BOOT_VALIDATED_RECORD_SZ = 32
 DEP_IMAGES_KEY = "images"
 DEP_VERSIONS_KEY = "versions"
 MAX_SW_TYPE_LENGTH = 12  # Bytes
@@ -50,11 +52,15 @@ IMAGE_F = {
         'PIC':                   0x0000001,
         'NON_BOOTABLE':          0x0000010,
         'ENCRYPTED':             0x0000004,
+        'HASH_CHUNKS':           0x0000040,
 }
 
 TLV_VALUES = {
         'KEYHASH': 0x01,
         'SHA256': 0x10,
+        'SHA384': 0x11,
+        'SHA512': 0x12,
+        'SHA256_CHUNKS': 0x14,
         'RSA2048': 0x20,
         'ECDSA224': 0x21,
         'ECDSA256': 0x22,
@@ -63,6 +69,7 @@ TLV_VALUES = {
         'ENCRSA2048': 0x30,
         'ENCKW128': 0x31,
         'ENCEC256': 0x32,
+        'ENCX25519': 0x33,
         'DEPENDENCY': 0x40,
         'SEC_CNT': 0x50,
         'BOOT_RECORD': 0x60,
@@ -84,6 +91,14 @@ STRUCT_ENDIAN_DICT = {
         'big':    '>'
 }
 
+# Image hashes, by hashlib name, with the matching cryptography hash used
+# by ECDSA signatures.
+IMAGE_HASHES = {
+        'sha256': hashes.SHA256,
+        'sha384': hashes.SHA384,
+        'sha512': hashes.SHA512,
+}
+
 VerifyResult = Enum('VerifyResult',
                     """
                     OK INVALID_MAGIC INVALID_TLV_INFO_MAGIC INVALID_HASH
@@ -123,7 +138,9 @@ class Image():
                  pad_header=False, pad=False, confirm=False, align=1,
                  slot_size=0, max_sectors=DEFAULT_MAX_SECTORS,
                  overwrite_only=False, endian="little", load_addr=0,
-                 erased_val=None, save_enctlv=False, security_counter=None):
+                 erased_val=None, save_enctlv=False, security_counter=None,
+                 hash_chunk_size=None, hash_alg='sha256', enc_keylen=128,
+                 validated_record=False):
         self.version = version or versmod.decode_version("0")
         self.header_size = header_size
         self.pad_header = pad_header
@@ -141,6 +158,16 @@ class Image():
         self.enckey = None
         self.save_enctlv = save_enctlv
         self.enctlv_len = 0
+        self.hash_chunk_size = hash_chunk_size
+        self.hash_alg = hash_alg
+        self.enc_keylen = enc_keylen
+        self.validated_record = validated_record
+
+        if hash_alg not in IMAGE_HASHES:
+            raise click.UsageError("Unsupported image hash '{}'".format(
+                                   hash_alg))
+        if hash_alg != 'sha256' and hash_chunk_size is not None:
+            raise click.UsageError("Hashing in chunks requires SHA256")
 
         if security_counter == 'auto':
             # Security counter has not been explicitly provided,
@@ -240,9 +267,13 @@ class Image():
                           len(self.payload), tsize, self.slot_size)
                 raise click.UsageError(msg)
 
-    def ecies_p256_hkdf(self, enckey, plainkey):
-        newpk = ec.generate_private_key(ec.SECP256R1(), default_backend())
-        shared = newpk.exchange(ec.ECDH(), enckey._get_public())
+    def ecies_hkdf(self, enckey, plainkey):
+        if isinstance(enckey, ecdsa.ECDSA256P1Public):
+            newpk = ec.generate_private_key(ec.SECP256R1(), default_backend())
+            shared = newpk.exchange(ec.ECDH(), enckey._get_public())
+        else:
+            newpk = X25519PrivateKey.generate()
+            shared = newpk.exchange(enckey._get_public())
         derived_key = HKDF(
             algorithm=hashes.SHA256(), length=48, salt=None,
             info=b'MCUBoot_ECIES_v1', backend=default_backend()).derive(shared)
@@ -254,14 +285,23 @@ class Image():
                         backend=default_backend())
         mac.update(cipherkey)
         ciphermac = mac.finalize()
-        pubk = newpk.public_key().public_bytes(
-            encoding=Encoding.X962,
-            format=PublicFormat.UncompressedPoint)
+        if isinstance(enckey, ecdsa.ECDSA256P1Public):
+            pubk = newpk.public_key().public_bytes(
+                encoding=Encoding.X962,
+                format=PublicFormat.UncompressedPoint)
+        else:
+            pubk = newpk.public_key().public_bytes(
+                encoding=Encoding.Raw,
+                format=PublicFormat.Raw)
         return cipherkey, ciphermac, pubk
 
     def create(self, key, enckey, dependencies=None, sw_type=None):
         self.enckey = enckey
 
+        if self.hash_alg != 'sha256' and isinstance(key, rsa.RSAPublic):
+            raise click.UsageError("RSA signatures require a SHA256 image "
+                                   "hash")
+
         # Calculate the hash of the public key
         if key is not None:
             pub = key.get_public_bytes()
@@ -295,12 +335,12 @@ class Image():
             # before it is even calculated. For this reason the script fills
             # this field with zeros and the bootloader will insert the right
             # value later.
-            digest = bytes(hashlib.sha256().digest_size)
+            digest = bytes(hashlib.new(self.hash_alg).digest_size)
 
             # Create CBOR encoded boot record
             boot_record = create_sw_component_data(sw_type, image_version,
-                                                   "SHA256", digest,
-                                                   pubbytes)
+                                                   self.hash_alg.upper(),
+                                                   digest, pubbytes)
 
             protected_tlv_size += TLV_SIZE + len(boot_record)
 
@@ -351,13 +391,21 @@ class Image():
 
         tlv = TLV(self.endian)
 
+        # With chunked hashing, the image hash and the signature cover the
+        # list of chunk digests instead of the payload itself.
+        signed = bytes(self.payload)
+        if self.hash_chunk_size is not None:
+            e = STRUCT_ENDIAN_DICT[self.endian]
+            signed = make_hash_chunks(e, self.hash_chunk_size, signed)
+            tlv.add('SHA256_CHUNKS', signed)
+
         # Note that ecdsa wants to do the hashing itself, which means
         # we get to hash it twice.
-        sha = hashlib.sha256()
-        sha.update(self.payload)
+        sha = hashlib.new(self.hash_alg)
+        sha.update(signed)
         digest = sha.digest()
 
-        tlv.add('SHA256', digest)
+        tlv.add(self.hash_alg.upper(), digest)
 
         if key is not None:
             tlv.add('KEYHASH', pubbytes)
@@ -366,7 +414,10 @@ class Image():
             # while `sign_digest` expects only the digest of the payload
 
             if hasattr(key, 'sign'):
-                sig = key.sign(bytes(self.payload))
+                if self.hash_alg == 'sha256':
+                    sig = key.sign(signed)
+                else:
+                    sig = key.sign(signed, IMAGE_HASHES[self.hash_alg])
             else:
                 sig = key.sign_digest(digest)
             tlv.add(key.sig_tlv(), sig)
@@ -377,7 +428,13 @@ class Image():
             self.payload = self.payload[:protected_tlv_off]
 
         if enckey is not None:
-            plainkey = os.urandom(16)
+            if self.enc_keylen != 128 and not isinstance(enckey,
+                                                         (rsa.RSAPublic,
+                                                          aeskw.AESKW)):
+                raise click.UsageError("AES-{} encryption is only supported "
+                                       "with RSA and AES-KW encryption "
+                                       "keys".format(self.enc_keylen))
+            plainkey = os.urandom(self.enc_keylen // 8)
 
             if isinstance(enckey, rsa.RSAPublic):
                 cipherkey = enckey._get_public().encrypt(
@@ -387,11 +444,25 @@ class Image():
                         label=None))
                 self.enctlv_len = len(cipherkey)
                 tlv.add('ENCRSA2048', cipherkey)
-            elif isinstance(enckey, ecdsa.ECDSA256P1Public):
-                cipherkey, mac, pubk = self.ecies_p256_hkdf(enckey, plainkey)
+            elif isinstance(enckey, aeskw.AESKW):
+                # MCUboot unwraps with a key of the size of the image key.
+                if enckey.key_size() != self.enc_keylen:
+                    raise click.UsageError("AES-{} encryption needs a {} byte "
+                                           "AES-KW key".format(
+                                               self.enc_keylen,
+                                               self.enc_keylen // 8))
+                cipherkey = enckey.wrap(plainkey)
+                self.enctlv_len = len(cipherkey)
+                tlv.add('ENCKW128', cipherkey)
+            elif isinstance(enckey, (ecdsa.ECDSA256P1Public,
+                                     x25519.X25519Public)):
+                cipherkey, mac, pubk = self.ecies_hkdf(enckey, plainkey)
                 enctlv = pubk + mac + cipherkey
                 self.enctlv_len = len(enctlv)
-                tlv.add('ENCEC256', enctlv)
+                if isinstance(enckey, ecdsa.ECDSA256P1Public):
+                    tlv.add('ENCEC256', enctlv)
+                else:
+                    tlv.add('ENCX25519', enctlv)
 
             nonce = bytes([0] * 16)
             cipher = Cipher(algorithms.AES(plainkey), modes.CTR(nonce),
@@ -412,6 +483,8 @@ class Image():
         flags = 0
         if enckey is not None:
             flags |= IMAGE_F['ENCRYPTED']
+        if self.hash_chunk_size is not None:
+            flags |= IMAGE_F['HASH_CHUNKS']
 
         e = STRUCT_ENDIAN_DICT[self.endian]
         fmt = (e +
@@ -458,8 +531,10 @@ class Image():
                     # TLV saved by the bootloader is aligned
                     keylen = (int((enctlv_len - 1) / MAX_ALIGN) + 1) * MAX_ALIGN
                 else:
-                    keylen = 16
+                    keylen = self.enc_keylen // 8
                 trailer += keylen * 2  # encryption keys
+            if self.validated_record:
+                trailer += BOOT_VALIDATED_RECORD_SZ
             trailer += MAX_ALIGN * 4  # image_ok/copy_done/swap_info/swap_size
             trailer += magic_size
             return trailer
@@ -482,7 +557,8 @@ class Image():
         with open(imgfile, "rb") as f:
             b = f.read()
 
-        magic, _, header_size, _, img_size = struct.unpack('IIHHI', b[:16])
+        magic, _, header_size, _, img_size, flags = \
+            struct.unpack('IIHHII', b[:20])
         version = struct.unpack('BBHI', b[20:28])
 
         if magic != IMAGE_MAGIC:
@@ -493,17 +569,37 @@ class Image():
         if magic != TLV_INFO_MAGIC:
             return VerifyResult.INVALID_TLV_INFO_MAGIC, None
 
-        sha = hashlib.sha256()
-        sha.update(b[:header_size+img_size])
-        digest = sha.digest()
-
         tlv_off = header_size + img_size
         tlv_end = tlv_off + tlv_tot
         tlv_off += TLV_INFO_SIZE  # skip tlv info
+
+        payload = b[:header_size+img_size]
+        if flags & IMAGE_F['HASH_CHUNKS']:
+            chunks = find_tlv(b, tlv_off, tlv_end, 'SHA256_CHUNKS')
+            if chunks is None or len(chunks) < 4:
+                return VerifyResult.INVALID_HASH, None
+            chunk_size, = struct.unpack('I', chunks[:4])
+            if (chunk_size == 0 or
+                    make_hash_chunks('<', chunk_size, payload)[4:] !=
+                    chunks[4:]):
+                return VerifyResult.INVALID_HASH, None
+            payload = chunks
+
+        hash_alg = 'sha256'
+        for alg in IMAGE_HASHES:
+            if find_tlv(b, tlv_off, tlv_end, alg.upper()) is not None:
+                hash_alg = alg
+                break
+        if hash_alg != 'sha256' and isinstance(key, rsa.RSAPublic):
+            return VerifyResult.INVALID_SIGNATURE, None
+        sha = hashlib.new(hash_alg)
+        sha.update(payload)
+        digest = sha.digest()
+
         while tlv_off < tlv_end:
             tlv = b[tlv_off:tlv_off+TLV_SIZE]
             tlv_type, _, tlv_len = struct.unpack('BBH', tlv)
-            if tlv_type == TLV_VALUES["SHA256"]:
+            if tlv_type == TLV_VALUES[hash_alg.upper()]:
                 off = tlv_off + TLV_SIZE
                 if digest == b[off:off+tlv_len]:
                     if key is None:
@@ -513,10 +609,13 @@ class Image():
             elif key is not None and tlv_type == TLV_VALUES[key.sig_tlv()]:
                 off = tlv_off + TLV_SIZE
                 tlv_sig = b[off:off+tlv_len]
-                payload = b[:header_size+img_size]
                 try:
                     if hasattr(key, 'verify'):
-                        key.verify(tlv_sig, payload)
+                        if hash_alg == 'sha256':
+                            key.verify(tlv_sig, payload)
+                        else:
+                            key.verify(tlv_sig, payload,
+                                       IMAGE_HASHES[hash_alg])
                     else:
                         key.verify_digest(tlv_sig, digest)
                     return VerifyResult.OK, version
@@ -525,3 +624,23 @@ class Image():
                     pass
             tlv_off += TLV_SIZE + tlv_len
         return VerifyResult.INVALID_SIGNATURE, None
+
+
+def make_hash_chunks(e, chunk_size, payload):
+    """Return the chunk size followed by the SHA256 of each chunk of
+    payload, as stored in the SHA256_CHUNKS TLV."""
+    table = struct.pack(e + 'I', chunk_size)
+    for off in range(0, len(payload), chunk_size):
+        table += hashlib.sha256(payload[off:off+chunk_size]).digest()
+    return table
+
+
+def find_tlv(b, tlv_off, tlv_end, kind):
+    """Return the value of the first TLV of the given kind, if any."""
+    while tlv_off < tlv_end:
+        tlv_type, _, tlv_len = struct.unpack('BBH', b[tlv_off:tlv_off+TLV_SIZE])
+        if tlv_type == TLV_VALUES[kind]:
+            off = tlv_off + TLV_SIZE
+            return b[off:off+tlv_len]
+        tlv_off += TLV_SIZE + tlv_len
+    return None
@@ -21,10 +21,13 @@ from cryptography.hazmat.primitives import serialization
 from cryptography.hazmat.primitives.asymmetric.rsa import RSAPrivateKey, RSAPublicKey
 from cryptography.hazmat.primitives.asymmetric.ec import EllipticCurvePrivateKey, EllipticCurvePublicKey
 from cryptography.hazmat.primitives.asymmetric.ed25519 import Ed25519PrivateKey, Ed25519PublicKey
+from cryptography.hazmat.primitives.asymmetric.x25519 import X25519PrivateKey, X25519PublicKey
 
 from .rsa import RSA, RSAPublic, RSAUsageError, RSA_KEY_SIZES
 from .ecdsa import ECDSA256P1, ECDSA256P1Public, ECDSAUsageError
 from .ed25519 import Ed25519, Ed25519Public, Ed25519UsageError
+from .x25519 import X25519, X25519Public, X25519UsageError
+from .aeskw import AESKW, AESKWUsageError
 
 class PasswordRequired(Exception):
     """Raised to indicate that the key is password protected, but a
@@ -35,6 +38,9 @@ def load(path, passwd=None):
     """Try loading a key from the given path.  Returns None if the password wasn't specified."""
     with open(path, 'rb') as f:
         raw_pem = f.read()
+    # AES-KW key-encryption keys are plain base64, as generated for newt.
+    if not raw_pem.lstrip().startswith(b'-----BEGIN'):
+        return AESKW.from_base64(raw_pem)
     try:
         pk = serialization.load_pem_private_key(
                 raw_pem,
@@ -78,5 +84,9 @@ def load(path, passwd=None):
         return Ed25519(pk)
     elif isinstance(pk, Ed25519PublicKey):
         return Ed25519Public(pk)
+    elif isinstance(pk, X25519PrivateKey):
+        return X25519(pk)
+    elif isinstance(pk, X25519PublicKey):
+        return X25519Public(pk)
     else:
         raise Exception("Unknown key type: " + str(type(pk)))
@@ -0,0 +1,48 @@
+"""
+AES-KW key-encryption key management
+"""
+
+import base64
+import binascii
+
+from cryptography.hazmat.backends import default_backend
+from cryptography.hazmat.primitives.keywrap import aes_key_wrap
+
+
+class AESKWUsageError(Exception):
+    pass
+
+
+class AESKW(object):
+    """
+    A key-encryption key wrapping the image key with AES-KW (RFC 3394).
+    Like newt, keys are stored base64 encoded in a text file.
+    """
+
+    KEK_SIZES = [16, 32]
+
+    def __init__(self, kek):
+        """kek should be the 16 or 32 bytes of the key"""
+        if len(kek) not in self.KEK_SIZES:
+            raise AESKWUsageError("Unsupported AES-KW key size: {} bytes"
+                                  .format(len(kek)))
+        self.kek = kek
+
+    @staticmethod
+    def from_base64(data):
+        try:
+            kek = base64.b64decode(data.strip(), validate=True)
+        except binascii.Error:
+            raise AESKWUsageError("AES-KW key files must be base64 encoded")
+        return AESKW(kek)
+
+    def shortname(self):
+        return "aeskw"
+
+    def key_size(self):
+        """Size in bits of the key-encryption key, and of the image keys it
+        can wrap for MCUboot."""
+        return len(self.kek) * 8
+
+    def wrap(self, plainkey):
+        return aes_key_wrap(self.kek, plainkey, backend=default_backend())
@@ -0,0 +1,57 @@
+"""
+Tests for AES-KW keys
+"""
+
+import base64
+import os.path
+import sys
+import tempfile
+import unittest
+
+sys.path.insert(0, os.path.abspath(os.path.join(os.path.dirname(__file__), '../..')))
+
+from imgtool.keys import load, AESKW, AESKWUsageError
+
+
+class AESKWKeys(unittest.TestCase):
+
+    def setUp(self):
+        self.test_dir = tempfile.TemporaryDirectory()
+
+    def tname(self, base):
+        return os.path.join(self.test_dir.name, base)
+
+    def tearDown(self):
+        self.test_dir.cleanup()
+
+    def save(self, base, data):
+        name = self.tname(base)
+        with open(name, 'wb') as f:
+            f.write(data)
+        return name
+
+    def test_load(self):
+        for size in AESKW.KEK_SIZES:
+            kek = os.urandom(size)
+            k = load(self.save('kek.b64', base64.b64encode(kek) + b'\n'))
+            self.assertIsInstance(k, AESKW)
+            self.assertEqual(k.kek, kek)
+            self.assertEqual(k.key_size(), size * 8)
+
+    def test_bad_keys(self):
+        self.assertRaises(AESKWUsageError, load,
+                          self.save('short.b64', base64.b64encode(bytes(8))))
+        self.assertRaises(AESKWUsageError, load,
+                          self.save('bad.b64', b'not a key!'))
+
+    def test_wrap(self):
+        """The RFC 3394 test vector for a 128-bit key and KEK."""
+        k = AESKW(bytes(range(16)))
+        plain = bytes.fromhex('00112233445566778899aabbccddeeff')
+        self.assertEqual(k.wrap(plain).hex(),
+                         '1fa68b0a8112b447aef34bd8fb5a7b82'
+                         '9d3e862371d2cfe5')
+
+
+if __name__ == '__main__':
+    unittest.main()
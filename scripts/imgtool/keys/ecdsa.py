@@ -65,14 +65,14 @@ class ECDSA256P1Public(KeyClass):
         # requested.
         return 72
 
-    def verify(self, signature, payload):
+    def verify(self, signature, payload, hash_alg=SHA256):
         # strip possible paddings added during sign
         signature = signature[:signature[1] + 2]
         k = self.key
         if isinstance(self.key, ec.EllipticCurvePrivateKey):
             k = self.key.public_key()
         return k.verify(signature=signature, data=payload,
-                        signature_algorithm=ec.ECDSA(SHA256()))
+                        signature_algorithm=ec.ECDSA(hash_alg()))
 
 
 class ECDSA256P1(ECDSA256P1Public):
@@ -141,14 +141,15 @@ class ECDSA256P1(ECDSA256P1Public):
         with open(path, 'wb') as f:
             f.write(pem)
 
-    def raw_sign(self, payload):
-        """Return the actual signature"""
+    def raw_sign(self, payload, hash_alg=SHA256):
+        """Return the actual signature.  Hashes longer than the curve
+        order, such as SHA384, are truncated to its size."""
         return self.key.sign(
                 data=payload,
-                signature_algorithm=ec.ECDSA(SHA256()))
+                signature_algorithm=ec.ECDSA(hash_alg()))
 
-    def sign(self, payload):
-        sig = self.raw_sign(payload)
+    def sign(self, payload, hash_alg=SHA256):
+        sig = self.raw_sign(payload, hash_alg)
         if self.pad_sig:
             # To make fixed length, pad with one or two zeros.
             sig += b'\000' * (self.sig_len() - len(sig))
@@ -1,12 +1,15 @@
 """General key class."""
 
+import hashlib
 import sys
 
 AUTOGEN_MESSAGE = "/* Autogenerated by imgtool.py, do not edit. */"
 
 class KeyClass(object):
-    def _emit(self, header, trailer, encoded_bytes, indent, file=sys.stdout, len_format=None):
-        print(AUTOGEN_MESSAGE, file=file)
+    def _emit(self, header, trailer, encoded_bytes, indent, file=sys.stdout,
+              len_format=None, autogen=True):
+        if autogen:
+            print(AUTOGEN_MESSAGE, file=file)
         print(header, end='', file=file)
         for count, b in enumerate(encoded_bytes):
             if count % 8 == 0:
@@ -26,6 +29,14 @@ class KeyClass(object):
                 indent="    ",
                 len_format="const unsigned int {}_pub_key_len = {{}};".format(self.shortname()),
                 file=file)
+        # The SHA256 matched against the KEYHASH TLV of images.
+        self._emit(
+                header="const unsigned char {}_pub_key_hash[] = {{".format(self.shortname()),
+                trailer="};",
+                encoded_bytes=hashlib.sha256(self.get_public_bytes()).digest(),
+                indent="    ",
+                file=file,
+                autogen=False)
 
     def emit_rust_public(self, file=sys.stdout):
         self._emit(
@@ -2,6 +2,8 @@
 RSA Key management
 """
 
+import sys
+
 from cryptography.hazmat.backends import default_backend
 from cryptography.hazmat.primitives import serialization
 from cryptography.hazmat.primitives.asymmetric import rsa
@@ -45,6 +47,42 @@ class RSAPublic(KeyClass):
     def get_private_bytes(self, minimal):
         self._unsupported('get_private_bytes')
 
+    def emit_c_public(self, file=sys.stdout):
+        super().emit_c_public(file=file)
+
+        # The Montgomery form of the key, sparing its parsing and the
+        # computation of R^2 mod N for each signature checked.
+        numbers = self._get_public().public_numbers()
+        print("#include <bootutil/sign_key.h>", file=file)
+        if numbers.e != 65537:
+            # Other exponents are not supported, the key is then parsed.
+            print("const struct bootutil_rsa_key {}_pub_key_mont = {{\n"
+                  "    .words = 0,\n"
+                  "}};".format(self.shortname()), file=file)
+            return
+        n = numbers.n
+        words = (n.bit_length() + 31) // 32
+        n0inv = -pow(n, 2**31 - 1, 2**32) % 2**32
+        rr = pow(2, 64 * words, n)
+
+        for name, value in (("n", n), ("rr", rr)):
+            print("static const uint32_t {}_pub_key_{}[] = {{".format(
+                  self.shortname(), name), end='', file=file)
+            for i in range(words):
+                if i % 4 == 0:
+                    print("\n    ", end='', file=file)
+                else:
+                    print(" ", end='', file=file)
+                print("0x{:08x},".format((value >> (32 * i)) & 0xffffffff),
+                      end='', file=file)
+            print("\n};", file=file)
+        print("const struct bootutil_rsa_key {0}_pub_key_mont = {{\n"
+              "    .words = {1},\n"
+              "    .n0inv = 0x{2:08x},\n"
+              "    .n = {0}_pub_key_n,\n"
+              "    .rr = {0}_pub_key_rr,\n"
+              "}};".format(self.shortname(), words, n0inv), file=file)
+
     def export_private(self, path, passwd=None):
         self._unsupported('export_private')
 
@@ -0,0 +1,63 @@
+"""
+Tests for X25519 keys
+"""
+
+import io
+import os.path
+import sys
+import tempfile
+import unittest
+
+sys.path.insert(0, os.path.abspath(os.path.join(os.path.dirname(__file__), '../..')))
+
+from imgtool.keys import load, X25519, X25519Public, X25519UsageError
+
+
+class X25519KeyGeneration(unittest.TestCase):
+
+    def setUp(self):
+        self.test_dir = tempfile.TemporaryDirectory()
+
+    def tname(self, base):
+        return os.path.join(self.test_dir.name, base)
+
+    def tearDown(self):
+        self.test_dir.cleanup()
+
+    def test_keygen(self):
+        name1 = self.tname("keygen.pem")
+        k = X25519.generate()
+        k.export_private(name1, b'secret')
+
+        self.assertIsNone(load(name1))
+
+        k2 = load(name1, b'secret')
+        self.assertIsInstance(k2, X25519)
+
+        pubname = self.tname('keygen-pub.pem')
+        k2.export_public(pubname)
+        pk2 = load(pubname)
+        self.assertIsInstance(pk2, X25519Public)
+
+        # We should be able to export the public key from the loaded
+        # public key, but not the private key.
+        pk2.export_public(self.tname('keygen-pub2.pem'))
+        self.assertRaises(X25519UsageError,
+                          pk2.export_private, self.tname('keygen-priv2.pem'))
+
+    def test_emit_private(self):
+        """The private key is emitted in PKCS#8 form for the bootloader."""
+        k = X25519.generate()
+
+        ccode = io.StringIO()
+        k.emit_private(False, ccode)
+        self.assertIn("enc_priv_key", ccode.getvalue())
+        self.assertIn("enc_priv_key_len = 48", ccode.getvalue())
+
+        self.assertRaises(X25519UsageError,
+                          X25519Public(k.key.public_key()).get_private_bytes,
+                          False)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -22,7 +22,8 @@ import imgtool.keys as keys
 import sys
 from imgtool import image, imgtool_version
 from imgtool.version import decode_version
-from .keys import RSAUsageError, ECDSAUsageError, Ed25519UsageError
+from .keys import (
+    RSAUsageError, ECDSAUsageError, Ed25519UsageError, X25519UsageError)
 
 MIN_PYTHON_VERSION = (3, 6)
 if sys.version_info < MIN_PYTHON_VERSION:
@@ -51,6 +52,10 @@ def gen_ed25519(keyfile, passwd):
     keys.Ed25519.generate().export_private(path=keyfile, passwd=passwd)
 
 
+def gen_x25519(keyfile, passwd):
+    keys.X25519.generate().export_private(path=keyfile, passwd=passwd)
+
+
 valid_langs = ['c', 'rust']
 keygens = {
     'rsa-2048':   gen_rsa2048,
@@ -58,6 +63,7 @@ keygens = {
     'ecdsa-p256': gen_ecdsa_p256,
     'ecdsa-p224': gen_ecdsa_p224,
     'ed25519': gen_ed25519,
+    'x25519': gen_x25519,
 }
 
 
@@ -124,7 +130,8 @@ def getpriv(key, minimal):
         print("Invalid passphrase")
     try:
         key.emit_private(minimal)
-    except (RSAUsageError, ECDSAUsageError, Ed25519UsageError) as e:
+    except (RSAUsageError, ECDSAUsageError, Ed25519UsageError,
+            X25519UsageError) as e:
         raise click.UsageError(e)
 
 
@@ -229,12 +236,31 @@ class BasedIntParamType(click.ParamType):
               help='When upgrading, save encrypted key TLVs instead of plain '
                    'keys. Enable when BOOT_SWAP_SAVE_ENCTLV config option '
                    'was set.')
+@click.option('--validated-record', default=False, is_flag=True,
+              help='Leave room in the trailer for the record of a validated '
+                   'image. Enable when MCUBOOT_VALIDATED_RECORD is set.')
 @click.option('-E', '--encrypt', metavar='filename',
-              help='Encrypt image using the provided public key')
+              help='Encrypt image using the provided public key, or AES-KW '
+                   'key-encryption key')
+@click.option('--encrypt-keylen', type=click.Choice(['128', '256']),
+              default='128', help='Size in bits of the AES key the image is '
+                                  'encrypted with, which must match '
+                                  'MCUBOOT_AES_256 in the bootloader.  256 '
+                                  'is only supported with RSA and AES-KW '
+                                  'keys.')
 @click.option('-e', '--endian', type=click.Choice(['little', 'big']),
               default='little', help="Select little or big endian")
 @click.option('--overwrite-only', default=False, is_flag=True,
               help='Use overwrite-only instead of swap upgrades')
+@click.option('--hash-chunk-size', type=BasedIntParamType(), required=False,
+              help='Hash the image in chunks of this many bytes, and sign '
+                   'the list of chunk hashes. Enable when MCUBOOT_HASH_CHUNKS '
+                   'is set.')
+@click.option('--hash', 'hash_alg', type=click.Choice(['sha256', 'sha384',
+                                                      'sha512']),
+              default='sha256', help='Image hash, which must match '
+                                     'MCUBOOT_SHA384/MCUBOOT_SHA512 in the '
+                                     'bootloader.  Not supported with RSA.')
 @click.option('--boot-record', metavar='sw_type', help='Create CBOR encoded '
               'boot record TLV. The sw_type represents the role of the '
               'software component (e.g. CoFM for coprocessor firmware). '
@@ -270,20 +296,29 @@ class BasedIntParamType(click.ParamType):
                INFILE and OUTFILE are parsed as Intel HEX if the params have
                .hex extension, otherwise binary format is used''')
 def sign(key, align, version, pad_sig, header_size, pad_header, slot_size, pad, confirm,
-         max_sectors, overwrite_only, endian, encrypt, infile, outfile,
-         dependencies, load_addr, hex_addr, erased_val, save_enctlv,
+         max_sectors, overwrite_only, hash_chunk_size, hash_alg, endian,
+         encrypt, encrypt_keylen, infile, outfile, dependencies, load_addr,
+         hex_addr, erased_val, save_enctlv, validated_record,
          security_counter, boot_record):
+    if hash_chunk_size is not None and hash_chunk_size <= 0:
+        raise click.BadParameter("Hash chunk size must be positive")
     img = image.Image(version=decode_version(version), header_size=header_size,
                       pad_header=pad_header, pad=pad, confirm=confirm,
                       align=int(align), slot_size=slot_size,
                       max_sectors=max_sectors, overwrite_only=overwrite_only,
                       endian=endian, load_addr=load_addr, erased_val=erased_val,
                       save_enctlv=save_enctlv,
-                      security_counter=security_counter)
+                      security_counter=security_counter,
+                      hash_chunk_size=hash_chunk_size, hash_alg=hash_alg,
+                      enc_keylen=int(encrypt_keylen),
+                      validated_record=validated_record)
     img.load(infile)
     key = load_key(key) if key else None
     enckey = load_key(encrypt) if encrypt else None
-    if enckey and key:
+    # X25519 and AES-KW keys can be used to encrypt images signed with any
+    # key type.
+    if enckey and key and not isinstance(enckey, (keys.X25519Public,
+                                                  keys.AESKW)):
         if ((isinstance(key, keys.ECDSA256P1) and
              not isinstance(enckey, keys.ECDSA256P1Public))
                 or (isinstance(key, keys.RSA) and
@@ -20,9 +20,27 @@ fn main() {
     let enc_rsa = env::var("CARGO_FEATURE_ENC_RSA").is_ok();
     let enc_kw = env::var("CARGO_FEATURE_ENC_KW").is_ok();
     let enc_ec256 = env::var("CARGO_FEATURE_ENC_EC256").is_ok();
+    let enc_x25519 = env::var("CARGO_FEATURE_ENC_X25519").is_ok();
     let bootstrap = env::var("CARGO_FEATURE_BOOTSTRAP").is_ok();
     let multiimage = env::var("CARGO_FEATURE_MULTIIMAGE").is_ok();
     let downgrade_prevention = env::var("CARGO_FEATURE_DOWNGRADE_PREVENTION").is_ok();
+    let async_flash = env::var("CARGO_FEATURE_ASYNC_FLASH").is_ok();
+    let skip_identical = env::var("CARGO_FEATURE_SKIP_IDENTICAL").is_ok();
+    let erase_coalesce = env::var("CARGO_FEATURE_ERASE_COALESCE").is_ok();
+    let flash_mapped = env::var("CARGO_FEATURE_FLASH_MAPPED").is_ok();
+    let sector_runs = env::var("CARGO_FEATURE_SECTOR_RUNS").is_ok();
+    let uniform_sector_size = env::var("CARGO_FEATURE_UNIFORM_SECTOR_SIZE").is_ok();
+    let hash_on_copy = env::var("CARGO_FEATURE_HASH_ON_COPY").is_ok();
+    let validated_record = env::var("CARGO_FEATURE_VALIDATED_RECORD").is_ok();
+    let hash_chunks = env::var("CARGO_FEATURE_HASH_CHUNKS").is_ok();
+    let bootutil_sha256 = env::var("CARGO_FEATURE_BOOTUTIL_SHA256").is_ok();
+    let sha384 = env::var("CARGO_FEATURE_SHA384").is_ok();
+    let sha512 = env::var("CARGO_FEATURE_SHA512").is_ok();
+    let ecdsa_g_table = env::var("CARGO_FEATURE_ECDSA_G_TABLE").is_ok();
+    let ed25519_large_b_table = env::var("CARGO_FEATURE_ED25519_LARGE_B_TABLE").is_ok();
+    let batch_verify = env::var("CARGO_FEATURE_BATCH_VERIFY").is_ok();
+    let aes256 = env::var("CARGO_FEATURE_AES256").is_ok();
+    let rsa_parsed_key = env::var("CARGO_FEATURE_RSA_PARSED_KEY").is_ok();
 
     let mut conf = cc::Build::new();
     conf.define("__BOOTSIM__", None);
@@ -48,12 +66,101 @@ fn main() {
         conf.define("MCUBOOT_DOWNGRADE_PREVENTION", None);
     }
 
+    if async_flash {
+        conf.define("MCUBOOT_USE_FLASH_ASYNC", None);
+    }
+
+    if skip_identical {
+        conf.define("MCUBOOT_SWAP_SKIP_IDENTICAL", None);
+    }
+
+    if erase_coalesce {
+        conf.define("MCUBOOT_USE_FLASH_ERASE_SIZES", None);
+    }
+
+    if flash_mapped {
+        conf.define("MCUBOOT_USE_FLASH_MAPPED", None);
+    }
+
+    if sector_runs {
+        conf.define("MCUBOOT_MAX_SECTOR_RUNS", Some("4"));
+    }
+
+    if uniform_sector_size {
+        if sector_runs {
+            panic!("uniform-sector-size and sector-runs are exclusive");
+        }
+        // The sector size of the devices that don't reject the feature.
+        conf.define("MCUBOOT_UNIFORM_SECTOR_SIZE", Some("4096"));
+    }
+
+    if hash_on_copy {
+        conf.define("MCUBOOT_HASH_ON_COPY", None);
+    }
+
+    if validated_record {
+        conf.define("MCUBOOT_VALIDATED_RECORD", None);
+    }
+
+    if hash_chunks {
+        conf.define("MCUBOOT_HASH_CHUNKS", None);
+    }
+
+    if bootutil_sha256 {
+        conf.define("MCUBOOT_USE_BOOTUTIL_SHA256", None);
+    }
+
+    if sha384 || sha512 {
+        if sha384 && sha512 {
+            panic!("Only one of sha384 and sha512 can be selected");
+        }
+        // Ring only makes RSA and ECDSA signatures over SHA256.
+        if sig_rsa || sig_rsa3072 || sig_ecdsa {
+            panic!("sha384 and sha512 are only simulated with ed25519 or no signature");
+        }
+        if hash_chunks || enc_rsa || enc_kw {
+            panic!("sha384 and sha512 don't support hash-chunks, enc-rsa or enc-kw");
+        }
+        conf.define(if sha384 { "MCUBOOT_SHA384" } else { "MCUBOOT_SHA512" }, None);
+    }
+
     // Currently no more than one sig type can be used simultaneously.
     if vec![sig_rsa, sig_rsa3072, sig_ecdsa, sig_ed25519].iter()
         .fold(0, |sum, &v| sum + v as i32) > 1 {
         panic!("mcuboot does not support more than one sig type at the same time");
     }
 
+    if ecdsa_g_table && !sig_ecdsa {
+        panic!("ecdsa-g-table requires sig-ecdsa");
+    }
+
+    if ed25519_large_b_table && !sig_ed25519 {
+        panic!("ed25519-large-b-table requires sig-ed25519");
+    }
+
+    if aes256 {
+        // TinyCrypt, used by the ECIES variants and with ECDSA or ed25519
+        // signatures, only has AES-128.
+        if !(enc_rsa || enc_kw) || enc_ec256 || enc_x25519 || sig_ecdsa || sig_ed25519 {
+            panic!("aes256 requires enc-rsa or enc-kw, without sig-ecdsa or sig-ed25519");
+        }
+        conf.define("MCUBOOT_AES_256", None);
+    }
+
+    if batch_verify {
+        if !sig_ed25519 {
+            panic!("batch-verify requires sig-ed25519");
+        }
+        conf.define("MCUBOOT_BATCH_VERIFY", None);
+    }
+
+    if rsa_parsed_key {
+        if !(sig_rsa || sig_rsa3072) {
+            panic!("rsa-parsed-key requires sig-rsa or sig-rsa3072");
+        }
+        conf.define("MCUBOOT_SIM_RSA_PARSED_KEY", None);
+    }
+
     if sig_rsa || sig_rsa3072 {
         conf.define("MCUBOOT_SIGN_RSA", None);
         // The Kconfig style defines must be added here as well because
@@ -79,6 +186,9 @@ fn main() {
     } else if sig_ecdsa {
         conf.define("MCUBOOT_SIGN_EC256", None);
         conf.define("MCUBOOT_USE_TINYCRYPT", None);
+        if ecdsa_g_table {
+            conf.define("uECC_VERIFY_G_WINDOW", Some("6"));
+        }
 
         if !enc_kw {
             conf.include("../../ext/mbedtls-asn1/include");
@@ -97,6 +207,9 @@ fn main() {
         conf.file("../../ext/mbedtls-asn1/src/asn1parse.c");
     } else if sig_ed25519 {
         conf.define("MCUBOOT_SIGN_ED25519", None);
+        if ed25519_large_b_table {
+            conf.define("MCUBOOT_ED25519_LARGE_B_TABLE", None);
+        }
         conf.define("MCUBOOT_USE_TINYCRYPT", None);
 
         conf.include("../../ext/tinycrypt/lib/include");
@@ -109,13 +222,16 @@ fn main() {
         conf.file("../../ext/fiat/src/curve25519.c");
         conf.file("../../ext/mbedtls-asn1/src/platform_util.c");
         conf.file("../../ext/mbedtls-asn1/src/asn1parse.c");
-    } else if !enc_ec256 {
+    } else if !enc_ec256 && !enc_x25519 {
         // No signature type, only sha256 validation. The default
         // configuration file bundled with mbedTLS is sufficient.
-        // When using ECIES-P256 rely on Tinycrypt.
+        // When using ECIES-P256 or ECIES-X25519 rely on Tinycrypt.
         conf.define("MCUBOOT_USE_MBED_TLS", None);
         conf.include("../../ext/mbedtls/crypto/include");
         conf.file("../../ext/mbedtls/crypto/library/sha256.c");
+        if sha384 || sha512 {
+            conf.file("../../ext/mbedtls/crypto/library/sha512.c");
+        }
     }
 
     if overwrite_only {
@@ -212,6 +328,44 @@ fn main() {
         conf.file("../../ext/tinycrypt/lib/source/ctr_mode.c");
         conf.file("../../ext/tinycrypt/lib/source/hmac.c");
         conf.file("../../ext/tinycrypt/lib/source/ecc_dh.c");
+
+        // With ed25519, SHA512 is already built in.
+        if (sha384 || sha512) && !sig_ed25519 {
+            conf.include("../../ext/tinycrypt-sha512/lib/include");
+            conf.file("../../ext/tinycrypt-sha512/lib/source/sha512.c");
+        }
+    }
+
+    if enc_x25519 {
+        conf.define("MCUBOOT_ENCRYPT_X25519", None);
+        conf.define("MCUBOOT_ENC_IMAGES", None);
+        conf.define("MCUBOOT_USE_TINYCRYPT", None);
+        conf.define("MCUBOOT_SWAP_SAVE_ENCTLV", None);
+
+        conf.file("../../boot/bootutil/src/encrypted.c");
+        conf.file("csupport/keys.c");
+
+        conf.include("../../ext/mbedtls-asn1/include");
+        conf.include("../../ext/tinycrypt/lib/include");
+        conf.include("../../ext/tinycrypt-sha512/lib/include");
+
+        // The X25519 ladder lives with the ed25519 code, which also
+        // needs SHA512.
+        if !sig_ed25519 {
+            conf.file("../../ext/fiat/src/curve25519.c");
+            conf.file("../../ext/tinycrypt-sha512/lib/source/sha512.c");
+        }
+
+        conf.file("../../ext/tinycrypt/lib/source/utils.c");
+        conf.file("../../ext/tinycrypt/lib/source/sha256.c");
+
+        conf.file("../../ext/mbedtls-asn1/src/platform_util.c");
+        conf.file("../../ext/mbedtls-asn1/src/asn1parse.c");
+
+        conf.file("../../ext/tinycrypt/lib/source/aes_encrypt.c");
+        conf.file("../../ext/tinycrypt/lib/source/aes_decrypt.c");
+        conf.file("../../ext/tinycrypt/lib/source/ctr_mode.c");
+        conf.file("../../ext/tinycrypt/lib/source/hmac.c");
     }
 
 
@@ -219,7 +373,7 @@ fn main() {
         conf.define("MBEDTLS_CONFIG_FILE", Some("<config-rsa-kw.h>"));
     } else if sig_rsa || sig_rsa3072 || enc_rsa {
         conf.define("MBEDTLS_CONFIG_FILE", Some("<config-rsa.h>"));
-    } else if (sig_ecdsa || enc_ec256) && !enc_kw {
+    } else if (sig_ecdsa || enc_ec256 || enc_x25519) && !enc_kw {
         conf.define("MBEDTLS_CONFIG_FILE", Some("<config-asn1.h>"));
     } else if sig_ed25519 {
         conf.define("MBEDTLS_CONFIG_FILE", Some("<config-asn1.h>"));
@@ -242,6 +396,9 @@ fn main() {
     conf.file("../../boot/bootutil/src/caps.c");
     conf.file("../../boot/bootutil/src/bootutil_misc.c");
     conf.file("../../boot/bootutil/src/tlv.c");
+    conf.file("../../boot/bootutil/src/validated_record.c");
+    conf.file("../../boot/bootutil/src/sha256.c");
+    conf.file("../../boot/bootutil/src/aes_ctr.c");
     conf.file("csupport/run.c");
     conf.include("../../boot/bootutil/include");
     conf.include("csupport");
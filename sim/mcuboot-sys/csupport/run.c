@@ -7,6 +7,8 @@
 #include <string.h>
 #include <bootutil/bootutil.h>
 #include <bootutil/image.h>
+#include <bootutil/sha256.h>
+#include <bootutil/sign_key.h>
 
 #include <flash_map_backend/flash_map_backend.h>
 
@@ -42,6 +44,7 @@ extern int sim_flash_read(uint8_t flash_id, uint32_t offset, uint8_t *dest,
         uint32_t size);
 extern int sim_flash_write(uint8_t flash_id, uint32_t offset, const uint8_t *src,
         uint32_t size);
+extern const uint8_t *sim_flash_mapped(uint8_t flash_id, uint32_t offset);
 extern uint8_t sim_flash_align(uint8_t flash_id);
 extern uint8_t sim_flash_erased_val(uint8_t flash_id);
 
@@ -50,9 +53,41 @@ struct sim_context {
     int jumped;
     uint8_t c_asserts;
     uint8_t c_catch_asserts;
+    uint8_t async_pending;
+    uint8_t async_dev;
+    uint64_t flash_time;
+    uint64_t async_done;
     jmp_buf boot_jmpbuf;
 };
 
+/*
+ * Relative per byte costs of flash operations, used to model the time spent
+ * on flash accesses.  The units are arbitrary; they only serve to compare
+ * access patterns, like how much programming time an asynchronous copy
+ * manages to hide behind reads.
+ */
+#define SIM_READ_COST       1
+#define SIM_PROG_COST       8
+#define SIM_ERASE_COST      2
+#define SIM_ERASE_OP_COST   4096
+
+/*
+ * Account for a synchronous operation on a device.  A device that is still
+ * busy programming an asynchronous write must finish it first, other devices
+ * keep working in parallel.
+ */
+static void
+sim_flash_time(uint8_t dev_id, uint32_t cost)
+{
+    struct sim_context *ctx = sim_get_context();
+
+    if (ctx->async_pending && ctx->async_dev == dev_id &&
+        ctx->flash_time < ctx->async_done) {
+        ctx->flash_time = ctx->async_done;
+    }
+    ctx->flash_time += cost;
+}
+
 #ifdef MCUBOOT_ENCRYPT_RSA
 static int
 parse_pubkey(mbedtls_rsa_context *ctx, uint8_t **p, uint8_t *end)
@@ -171,7 +206,8 @@ done:
 #endif
 }
 
-int kw_encrypt_(const uint8_t *kek, const uint8_t *seckey, uint8_t *encbuf)
+int kw_encrypt_(const uint8_t *kek, uint32_t kek_len, const uint8_t *seckey,
+                uint32_t seckey_len, uint8_t *encbuf)
 {
 #ifdef MCUBOOT_ENCRYPT_KW
     mbedtls_nist_kw_context kw;
@@ -182,13 +218,13 @@ int kw_encrypt_(const uint8_t *kek, const uint8_t *seckey, uint8_t *encbuf)
 
     mbedtls_nist_kw_init(&kw);
 
-    rc = mbedtls_nist_kw_setkey(&kw, MBEDTLS_CIPHER_ID_AES, kek, 128, 1);
+    rc = mbedtls_nist_kw_setkey(&kw, MBEDTLS_CIPHER_ID_AES, kek, kek_len * 8, 1);
     if (rc) {
         goto done;
     }
 
-    rc = mbedtls_nist_kw_wrap(&kw, MBEDTLS_KW_MODE_KW, seckey, 16, encbuf,
-            &olen, 24);
+    rc = mbedtls_nist_kw_wrap(&kw, MBEDTLS_KW_MODE_KW, seckey, seckey_len,
+            encbuf, &olen, seckey_len + 8);
 
 done:
     mbedtls_nist_kw_free(&kw);
@@ -196,7 +232,9 @@ done:
 
 #else
     (void)kek;
+    (void)kek_len;
     (void)seckey;
+    (void)seckey_len;
     (void)encbuf;
     return 0;
 #endif
@@ -306,6 +344,7 @@ int flash_area_read(const struct flash_area *area, uint32_t off, void *dst,
 {
     BOOT_LOG_SIM("%s: area=%d, off=%x, len=%x",
                  __func__, area->fa_id, off, len);
+    sim_flash_time(area->fa_device_id, len * SIM_READ_COST);
     return sim_flash_read(area->fa_device_id, area->fa_off + off, dst, len);
 }
 
@@ -319,9 +358,52 @@ int flash_area_write(const struct flash_area *area, uint32_t off, const void *sr
         ctx->jumped++;
         longjmp(ctx->boot_jmpbuf, 1);
     }
+    sim_flash_time(area->fa_device_id, len * SIM_PROG_COST);
     return sim_flash_write(area->fa_device_id, area->fa_off + off, src, len);
 }
 
+/*
+ * The data is stored right away, so that power failures hit the same write
+ * operations as in synchronous mode, but the programming time only gets
+ * accounted for once the write is completed, overlapping any access to other
+ * devices done in between.
+ */
+int flash_area_write_submit(const struct flash_area *area, uint32_t off,
+                            const void *src, uint32_t len)
+{
+    BOOT_LOG_SIM("%s: area=%d, off=%x, len=%x", __func__,
+                 area->fa_id, off, len);
+    struct sim_context *ctx = sim_get_context();
+    if (ctx->async_pending) {
+        printf("Async write submitted while another one is pending\n");
+        abort();
+    }
+    if (--(ctx->flash_counter) == 0) {
+        ctx->jumped++;
+        longjmp(ctx->boot_jmpbuf, 1);
+    }
+    sim_flash_time(area->fa_device_id, 0);
+    ctx->async_pending = 1;
+    ctx->async_dev = area->fa_device_id;
+    ctx->async_done = ctx->flash_time + len * SIM_PROG_COST;
+    return sim_flash_write(area->fa_device_id, area->fa_off + off, src, len);
+}
+
+int flash_area_write_complete(const struct flash_area *area)
+{
+    struct sim_context *ctx = sim_get_context();
+
+    if (!ctx->async_pending || ctx->async_dev != area->fa_device_id) {
+        printf("No async write pending on area %d\n", area->fa_id);
+        abort();
+    }
+    if (ctx->flash_time < ctx->async_done) {
+        ctx->flash_time = ctx->async_done;
+    }
+    ctx->async_pending = 0;
+    return 0;
+}
+
 int flash_area_erase(const struct flash_area *area, uint32_t off, uint32_t len)
 {
     BOOT_LOG_SIM("%s: area=%d, off=%x, len=%x", __func__,
@@ -331,18 +413,40 @@ int flash_area_erase(const struct flash_area *area, uint32_t off, uint32_t len)
         ctx->jumped++;
         longjmp(ctx->boot_jmpbuf, 1);
     }
+    sim_flash_time(area->fa_device_id,
+                   SIM_ERASE_OP_COST + len * SIM_ERASE_COST);
     return sim_flash_erase(area->fa_device_id, area->fa_off + off, len);
 }
 
+/*
+ * Like many NOR parts, pretend 32 and 64 KiB blocks can be erased at once;
+ * simflash accepts any erase that starts and ends on sector boundaries.
+ */
+uint32_t flash_area_erase_sizes(const struct flash_area *area)
+{
+    (void)area;
+    return (1 << 15) | (1 << 16);
+}
+
+/*
+ * Every simulated device is memory mapped.
+ */
+const void *flash_area_get_mapped(const struct flash_area *area)
+{
+    BOOT_LOG_SIM("%s: area=%d", __func__, area->fa_id);
+    return sim_flash_mapped(area->fa_device_id, area->fa_off);
+}
+
 int flash_area_read_is_empty(const struct flash_area *area, uint32_t off,
         void *dst, uint32_t len)
 {
-    uint8_t i;
+    uint32_t i;
     uint8_t *u8dst;
     int rc;
 
     BOOT_LOG_SIM("%s: area=%d, off=%x, len=%x", __func__, area->fa_id, off, len);
 
+    sim_flash_time(area->fa_device_id, len * SIM_READ_COST);
     rc = sim_flash_read(area->fa_device_id, area->fa_off + off, dst, len);
     if (rc) {
         return -1;
@@ -450,6 +554,19 @@ void sim_assert(int x, const char *assertion, const char *file, unsigned int lin
     }
 }
 
+#ifdef MCUBOOT_VALIDATED_RECORD
+#include <bootutil/validated_record.h>
+
+int32_t boot_validated_record_key_get(const uint8_t **key, uint32_t *key_len)
+{
+    static const uint8_t sim_device_key[32] = "mcuboot-sim-validated-record-key";
+
+    *key = sim_device_key;
+    *key_len = sizeof sim_device_key;
+    return 0;
+}
+#endif
+
 uint32_t boot_max_align(void)
 {
     return BOOT_MAX_ALIGN;
@@ -459,3 +576,169 @@ uint32_t boot_magic_sz(void)
 {
     return BOOT_MAGIC_SZ;
 }
+
+uint32_t boot_buf_sz(void)
+{
+    return BOOT_BUF_SZ;
+}
+
+uint32_t boot_buf_count(void)
+{
+    return BOOT_BUF_COUNT;
+}
+
+/*
+ * SHA256 implementations compared by "bootsim hashbench": the crypto library
+ * the simulator is built with, then, with MCUBOOT_USE_BOOTUTIL_SHA256, each
+ * block function bootutil can use on this host.
+ */
+const char *sha256_backend_name_(int idx)
+{
+#ifdef MCUBOOT_USE_BOOTUTIL_SHA256
+    const struct bootutil_sha256_impl *impls;
+#endif
+
+    if (idx == 0) {
+#if defined(MCUBOOT_USE_TINYCRYPT)
+        return "tinycrypt";
+#else
+        return "mbedtls";
+#endif
+    }
+#ifdef MCUBOOT_USE_BOOTUTIL_SHA256
+    if (idx <= bootutil_sha256_impls(&impls)) {
+        return impls[idx - 1].name;
+    }
+#endif
+    return NULL;
+}
+
+int sha256_backend_hash_(int idx, const uint8_t *data, uint32_t len,
+                         uint8_t *out)
+{
+#ifdef MCUBOOT_USE_BOOTUTIL_SHA256
+    const struct bootutil_sha256_impl *impls;
+    bootutil_sha256_context ctx;
+#endif
+
+    if (idx == 0) {
+#if defined(MCUBOOT_USE_TINYCRYPT)
+        struct tc_sha256_state_struct tc_ctx;
+
+        tc_sha256_init(&tc_ctx);
+        tc_sha256_update(&tc_ctx, data, len);
+        tc_sha256_final(out, &tc_ctx);
+        return 0;
+#else
+        return mbedtls_sha256_ret(data, len, out, 0);
+#endif
+    }
+#ifdef MCUBOOT_USE_BOOTUTIL_SHA256
+    if (idx <= bootutil_sha256_impls(&impls)) {
+        bootutil_sha256_init(&ctx);
+        ctx.blocks = impls[idx - 1].blocks;
+        bootutil_sha256_update(&ctx, data, len);
+        bootutil_sha256_finish(&ctx, out);
+        return 0;
+    }
+#endif
+    return -1;
+}
+
+/*
+ * Checks a signature against the given built in key, the way image
+ * validation does, for "bootsim verifybench".  Returns 1 for a good
+ * signature, 0 for a bad one and -1 if the simulator doesn't verify
+ * signatures or has no such key.
+ */
+int sig_verify_(uint8_t key_id, uint8_t *hash, uint32_t hlen, uint8_t *sig,
+                uint32_t slen)
+{
+#if defined(MCUBOOT_SIGN_RSA) || defined(MCUBOOT_SIGN_EC256) || \
+    defined(MCUBOOT_SIGN_ED25519)
+    if (key_id >= bootutil_key_cnt) {
+        return -1;
+    }
+    return bootutil_verify_sig(hash, hlen, sig, slen, key_id) == 0;
+#else
+    (void)key_id;
+    (void)hash;
+    (void)hlen;
+    (void)sig;
+    (void)slen;
+    return -1;
+#endif
+}
+
+/*
+ * AES-CTR implementations compared by "bootsim encbench": the crypto
+ * library's AES, then AES-NI when this host has it.  NULL when the simulator
+ * doesn't support encrypted images.
+ */
+const char *enc_backend_name_(int idx)
+{
+#ifdef MCUBOOT_ENC_IMAGES
+    if (idx == 0) {
+#if defined(MCUBOOT_USE_TINYCRYPT)
+        return "tinycrypt";
+#else
+        return "mbedtls";
+#endif
+    }
+    if (idx == 1 && bootutil_aes_ctr_aesni_usable()) {
+        return "aes-ni";
+    }
+#else
+    (void)idx;
+#endif
+    return NULL;
+}
+
+/*
+ * Encrypts `len` bytes of payload found at `off` with the AES key `key`
+ * and the implementation `idx`, handing `chunk` bytes at a time to
+ * boot_encrypt() as image copies do.  The key must be BOOT_ENC_KEY_SIZE
+ * bytes long.
+ */
+int enc_encrypt_(int idx, const uint8_t *key, uint32_t key_len, uint32_t off,
+                 uint8_t *buf, uint32_t len, uint32_t chunk)
+{
+#ifdef MCUBOOT_ENC_IMAGES
+    struct enc_key_data enc_state[BOOT_NUM_SLOTS];
+    struct boot_status bs;
+    struct flash_area fa;
+    uint32_t blk_sz;
+
+    if (enc_backend_name_(idx) == NULL || key_len != BOOT_ENC_KEY_SIZE) {
+        return -1;
+    }
+
+    memset(&bs, 0, sizeof bs);
+    memcpy(bs.enckey[0], key, BOOT_ENC_KEY_SIZE);
+    if (boot_enc_set_key(enc_state, 0, &bs)) {
+        return -1;
+    }
+#ifdef BOOTUTIL_AES_CTR_HAVE_AESNI
+    enc_state[0].aes_ctr.aesni = (idx == 1);
+#endif
+
+    memset(&fa, 0, sizeof fa);
+    fa.fa_id = FLASH_AREA_IMAGE_PRIMARY(0);
+    for (; len > 0; len -= blk_sz, off += blk_sz, buf += blk_sz) {
+        blk_sz = len < chunk ? len : chunk;
+        boot_encrypt(enc_state, 0, &fa, off, blk_sz, off & 0xf, buf);
+    }
+
+    boot_enc_zeroize(enc_state);
+    return 0;
+#else
+    (void)idx;
+    (void)key;
+    (void)key_len;
+    (void)off;
+    (void)buf;
+    (void)len;
+    (void)chunk;
+    return -1;
+#endif
+}
@@ -54,6 +54,11 @@ pub struct CSimContext {
     pub jumped: libc::c_int,
     pub c_asserts: u8,
     pub c_catch_asserts: u8,
+    pub async_pending: u8,
+    pub async_dev: u8,
+    // Simulated time spent accessing the flash, see run.c for the costs.
+    pub flash_time: u64,
+    pub async_done: u64,
     // NOTE: Always leave boot_jmpbuf declaration at the end; this should
     // store a "jmp_buf" which is arch specific and not defined by libc crate.
     // The size below is enough to store data on a x86_64 machine.
@@ -178,6 +183,20 @@ pub extern fn sim_flash_write(dev_id: u8, offset: u32, src: *const u8, size: u32
     rc
 }
 
+#[no_mangle]
+pub extern fn sim_flash_mapped(dev_id: u8, offset: u32) -> *const u8 {
+    let mut mapped: *const u8 = ptr::null();
+    THREAD_CTX.with(|ctx| {
+        if let Some(flash) = ctx.borrow().flash_map.get(&dev_id) {
+            let dev = unsafe { &*(flash.ptr) };
+            if let Some(data) = dev.mapped().get(offset as usize ..) {
+                mapped = data.as_ptr();
+            }
+        }
+    });
+    mapped
+}
+
 #[no_mangle]
 pub extern fn sim_flash_align(id: u8) -> u8 {
     THREAD_CTX.with(|ctx| {
@@ -9,6 +9,7 @@
 use crate::area::AreaDesc;
 use simflash::SimMultiFlash;
 use libc;
+use log::debug;
 use crate::api;
 
 /// Invoke the bootloader on this flash device.
@@ -27,12 +28,17 @@ pub fn boot_go(multiflash: &mut SimMultiFlash, areadesc: &AreaDesc,
         jumped: 0,
         c_asserts: 0,
         c_catch_asserts: if catch_asserts { 1 } else { 0 },
+        async_pending: 0,
+        async_dev: 0,
+        flash_time: 0,
+        async_done: 0,
         boot_jmpbuf: [0; 16],
     };
     let result = unsafe {
         raw::invoke_boot_go(&mut sim_ctx as *mut _, &areadesc.get_c() as *const _) as i32
     };
     let asserts = sim_ctx.c_asserts;
+    debug!("boot_go: simulated flash time {}", sim_ctx.flash_time);
     counter.map(|c| *c = sim_ctx.flash_counter);
     unsafe {
         for (&dev_id, _) in multiflash {
@@ -58,6 +64,14 @@ pub fn boot_max_align() -> usize {
     unsafe { raw::boot_max_align() as usize }
 }
 
+pub fn boot_buf_sz() -> usize {
+    unsafe { raw::boot_buf_sz() as usize }
+}
+
+pub fn boot_buf_count() -> usize {
+    unsafe { raw::boot_buf_count() as usize }
+}
+
 pub fn rsa_oaep_encrypt(pubkey: &[u8], seckey: &[u8]) -> Result<[u8; 256], &'static str> {
     unsafe {
         let mut encbuf: [u8; 256] = [0; 256];
@@ -70,16 +84,82 @@ pub fn rsa_oaep_encrypt(pubkey: &[u8], seckey: &[u8]) -> Result<[u8; 256], &'sta
     }
 }
 
-pub fn kw_encrypt(kek: &[u8], seckey: &[u8]) -> Result<[u8; 24], &'static str> {
+pub fn kw_encrypt(kek: &[u8], seckey: &[u8]) -> Result<Vec<u8>, &'static str> {
     unsafe {
-        let mut encbuf = [0u8; 24];
-        if raw::kw_encrypt_(kek.as_ptr(), seckey.as_ptr(), encbuf.as_mut_ptr()) == 0 {
+        let mut encbuf = vec![0u8; seckey.len() + 8];
+        if raw::kw_encrypt_(kek.as_ptr(), kek.len() as u32, seckey.as_ptr(),
+                            seckey.len() as u32, encbuf.as_mut_ptr()) == 0 {
             return Ok(encbuf);
         }
         return Err("Failed to encrypt buffer");
     }
 }
 
+/// Names of the SHA256 implementations that can be compared, the crypto
+/// library first.
+pub fn sha256_backends() -> Vec<String> {
+    let mut names = vec![];
+    loop {
+        let name = unsafe { raw::sha256_backend_name_(names.len() as libc::c_int) };
+        if name.is_null() {
+            return names;
+        }
+        let name = unsafe { std::ffi::CStr::from_ptr(name) };
+        names.push(name.to_string_lossy().into_owned());
+    }
+}
+
+pub fn sha256_backend_hash(idx: usize, data: &[u8]) -> [u8; 32] {
+    let mut out = [0u8; 32];
+    let rc = unsafe {
+        raw::sha256_backend_hash_(idx as libc::c_int, data.as_ptr(),
+                                  data.len() as u32, out.as_mut_ptr())
+    };
+    assert_eq!(rc, 0);
+    out
+}
+
+/// Verify a signature of `hash` with the simulator's root key, the first
+/// built in key.  RSA builds have the same key without its precomputed form
+/// as the second one.  Returns None when the simulator doesn't verify
+/// signatures, or has no such key.
+pub fn sig_verify(key_id: u8, hash: &[u8], sig: &[u8]) -> Option<bool> {
+    let mut hash = hash.to_vec();
+    let mut sig = sig.to_vec();
+    let rc = unsafe {
+        raw::sig_verify_(key_id, hash.as_mut_ptr(), hash.len() as u32,
+                         sig.as_mut_ptr(), sig.len() as u32)
+    };
+    match rc {
+        -1 => None,
+        rc => Some(rc == 1),
+    }
+}
+
+/// The AES-CTR implementations built into the simulator, empty when it
+/// doesn't support encrypted images.
+pub fn enc_backends() -> Vec<String> {
+    let mut names = vec![];
+    loop {
+        let name = unsafe { raw::enc_backend_name_(names.len() as libc::c_int) };
+        if name.is_null() {
+            return names;
+        }
+        let name = unsafe { std::ffi::CStr::from_ptr(name) };
+        names.push(name.to_string_lossy().into_owned());
+    }
+}
+
+/// Encrypt `buf`, found at `off` in an image payload, with the bootloader's
+/// AES-CTR implementation `idx`, passing it `chunk` bytes at a time.
+pub fn enc_encrypt(idx: usize, key: &[u8], off: u32, buf: &mut [u8], chunk: u32) {
+    let rc = unsafe {
+        raw::enc_encrypt_(idx as libc::c_int, key.as_ptr(), key.len() as u32, off,
+                          buf.as_mut_ptr(), buf.len() as u32, chunk)
+    };
+    assert_eq!(rc, 0);
+}
+
 mod raw {
     use crate::area::CAreaDesc;
     use crate::api::CSimContext;
@@ -97,11 +177,25 @@ mod raw {
         pub fn boot_magic_sz() -> u32;
         pub fn boot_max_align() -> u32;
 
+        pub fn boot_buf_sz() -> u32;
+        pub fn boot_buf_count() -> u32;
+
         pub fn rsa_oaep_encrypt_(pubkey: *const u8, pubkey_len: libc::c_uint,
                                  seckey: *const u8, seckey_len: libc::c_uint,
                                  encbuf: *mut u8) -> libc::c_int;
 
-        pub fn kw_encrypt_(kek: *const u8, seckey: *const u8,
-                           encbuf: *mut u8) -> libc::c_int;
+        pub fn kw_encrypt_(kek: *const u8, kek_len: u32, seckey: *const u8,
+                           seckey_len: u32, encbuf: *mut u8) -> libc::c_int;
+
+        pub fn sha256_backend_name_(idx: libc::c_int) -> *const libc::c_char;
+        pub fn sha256_backend_hash_(idx: libc::c_int, data: *const u8, len: u32,
+                                    out: *mut u8) -> libc::c_int;
+
+        pub fn sig_verify_(key_id: u8, hash: *mut u8, hlen: u32, sig: *mut u8,
+                           slen: u32) -> libc::c_int;
+
+        pub fn enc_backend_name_(idx: libc::c_int) -> *const libc::c_char;
+        pub fn enc_encrypt_(idx: libc::c_int, key: *const u8, key_len: u32, off: u32,
+                            buf: *mut u8, len: u32, chunk: u32) -> libc::c_int;
     }
 }
@@ -60,6 +60,7 @@ pub trait Flash {
     fn erase(&mut self, offset: usize, len: usize) -> Result<()>;
     fn write(&mut self, offset: usize, payload: &[u8]) -> Result<()>;
     fn read(&self, offset: usize, data: &mut [u8]) -> Result<()>;
+    fn mapped(&self) -> &[u8];
 
     fn add_bad_region(&mut self, offset: usize, len: usize, rate: f32) -> Result<()>;
     fn reset_bad_regions(&mut self);
@@ -232,6 +233,11 @@ impl Flash for SimFlash {
         Ok(())
     }
 
+    /// The whole device contents, as a memory-mapped flash would show them.
+    fn mapped(&self) -> &[u8] {
+        &self.data
+    }
+
     /// Adds a new flash bad region. Writes to this area fail with a chance
     /// given by `rate`.
     fn add_bad_region(&mut self, offset: usize, len: usize, rate: f32) -> Result<()> {
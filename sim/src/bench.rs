@@ -0,0 +1,100 @@
+// SPDX-License-Identifier: Apache-2.0
+
+//! Crypto benchmarks
+//!
+//! "bootsim hashbench", "encbench" and "verifybench" time the bootloader's
+//! crypto code.  Each of them also checks the results against the Rust
+//! crates, so the tests run them with a few rounds, without timing.
+
+use log::error;
+use std::{
+    fmt,
+    time::{Duration, Instant},
+};
+
+/// One benchmark, the part specific to what it times.
+pub trait Bench {
+    /// What is timed, as in "Build with ... to time <what>".
+    fn what(&self) -> &'static str;
+
+    /// The features to build with when this build has nothing to time, or
+    /// None when it has.
+    fn missing(&self) -> Option<&'static str>;
+
+    /// Rounds run by the bootsim command.
+    fn rounds(&self) -> usize {
+        20
+    }
+
+    /// Rounds run by the tests, enough to check the results.
+    fn test_rounds(&self) -> usize {
+        1
+    }
+
+    /// Run `rounds` rounds, recording wrong results and timings in `report`.
+    fn run(&self, rounds: usize, report: &mut Report);
+}
+
+/// What a benchmark reports back.
+pub struct Report {
+    show: bool,
+    fails: bool,
+}
+
+impl Report {
+    /// Whether the timings are printed.
+    pub fn show(&self) -> bool {
+        self.show
+    }
+
+    /// Log a wrong result.
+    pub fn fail(&mut self, msg: fmt::Arguments) {
+        error!("{}", msg);
+        self.fails = true;
+    }
+
+    /// Print the throughput of processing `bytes` in `elapsed`, after `label`.
+    pub fn throughput(&self, label: fmt::Arguments, bytes: usize, elapsed: Duration) {
+        if self.show {
+            println!("{}: {:8.1} MB/s", label, bytes as f64 / elapsed.as_secs_f64() / 1e6);
+        }
+    }
+}
+
+/// Time `rounds` calls of `f`.
+pub fn time<F: FnMut()>(rounds: usize, mut f: F) -> Duration {
+    let start = Instant::now();
+    for _ in 0 .. rounds {
+        f();
+    }
+    start.elapsed()
+}
+
+/// The data hashed and encrypted, the same for every benchmark.
+pub fn bench_data(size: usize) -> Vec<u8> {
+    (0 .. size).map(|i| (i * 131 + (i >> 7)) as u8).collect()
+}
+
+/// Run `bench` for `rounds` rounds, printing the timings when `show` is set.
+/// Returns true if any result was wrong.
+pub fn run_bench(bench: &dyn Bench, rounds: usize, show: bool) -> bool {
+    if let Some(features) = bench.missing() {
+        if show {
+            println!("Build with {} to time {}", features, bench.what());
+        }
+        return false;
+    }
+
+    let mut report = Report {
+        show: show,
+        fails: false,
+    };
+    bench.run(rounds, &mut report);
+    report.fails
+}
+
+/// Check the results of `bench`, without timing it.  Returns true if any was
+/// wrong.
+pub fn check_bench(bench: &dyn Bench) -> bool {
+    run_bench(bench, bench.test_rounds(), false)
+}
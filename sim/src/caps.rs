@@ -23,6 +23,13 @@ pub enum Caps {
     EncEc256             = (1 << 10),
     SwapUsingMove        = (1 << 11),
     DowngradePrevention  = (1 << 12),
+    HashChunks           = (1 << 13),
+    Sha384               = (1 << 14),
+    Sha512               = (1 << 15),
+    EncX25519            = (1 << 16),
+    Aes256               = (1 << 17),
+    ValidatedRecord      = (1 << 18),
+    UniformSectorSize    = (1 << 19),
 }
 
 impl Caps {
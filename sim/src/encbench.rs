@@ -0,0 +1,102 @@
+// SPDX-License-Identifier: Apache-2.0
+
+//! AES-CTR throughput
+//!
+//! Encrypts image payloads with each AES-CTR implementation built into the
+//! simulator, the way upgrades and the validation of encrypted images do,
+//! checking the result against the aes-ctr crate's.
+
+use crate::bench::{self, Bench, Report};
+use crate::caps::Caps;
+use crate::tlv::aes_key_len;
+use aes_ctr::{
+    Aes128Ctr,
+    Aes256Ctr,
+    stream_cipher::{
+        generic_array::GenericArray,
+        NewFixStreamCipher,
+        StreamCipherCore,
+    },
+};
+use mcuboot_sys::c;
+
+/// Payload sizes encrypted, as for the hash benchmark.
+pub static ENC_BENCH_SIZES: &[usize] = &[42784, 128 * 1024, 512 * 1024];
+
+/// Where the data starts in the payload, and in the buffer holding it.
+static ENC_BENCH_OFFSETS: &[(usize, usize)] = &[(0, 0), (0x23, 3), (0x1000, 1)];
+
+/// "bootsim encbench"
+pub struct EncBench;
+
+impl Bench for EncBench {
+    fn what(&self) -> &'static str {
+        "image encryption"
+    }
+
+    fn missing(&self) -> Option<&'static str> {
+        if Caps::EncRsa.present() || Caps::EncKw.present() ||
+           Caps::EncEc256.present() || Caps::EncX25519.present() {
+            None
+        } else {
+            Some("enc-rsa, enc-kw, enc-ec256 or enc-x25519")
+        }
+    }
+
+    fn run(&self, rounds: usize, report: &mut Report) {
+        let feature = if Caps::EncRsa.present() {
+            "enc-rsa"
+        } else if Caps::EncKw.present() {
+            "enc-kw"
+        } else if Caps::EncEc256.present() {
+            "enc-ec256"
+        } else {
+            "enc-x25519"
+        };
+        let backends = c::enc_backends();
+        let key = [0x2bu8, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+                   0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c,
+                   0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe,
+                   0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81];
+        let key = &key[.. aes_key_len()];
+        let aes = if Caps::Aes256.present() { "aes-256" } else { "aes-128" };
+        let chunks = [c::boot_buf_sz() as u32, 1000];
+
+        for &size in ENC_BENCH_SIZES {
+            for &(off, skew) in ENC_BENCH_OFFSETS {
+                let data = bench::bench_data(size);
+
+                let mut expected = vec![0u8; off];
+                expected.extend_from_slice(&data);
+                let nonce = GenericArray::from_slice(&[0; 16]);
+                if Caps::Aes256.present() {
+                    Aes256Ctr::new(GenericArray::from_slice(key), nonce)
+                        .apply_keystream(&mut expected);
+                } else {
+                    Aes128Ctr::new(GenericArray::from_slice(key), nonce)
+                        .apply_keystream(&mut expected);
+                }
+
+                for (idx, name) in backends.iter().enumerate() {
+                    for &chunk in &chunks {
+                        let mut buf = vec![0u8; skew + size];
+                        let elapsed = bench::time(rounds, || {
+                            buf[skew ..].copy_from_slice(&data);
+                            c::enc_encrypt(idx, key, off as u32, &mut buf[skew ..], chunk);
+                        });
+
+                        if buf[skew ..] != expected[off ..] {
+                            report.fail(format_args!(
+                                "{} {} {}: wrong AES-CTR of {} bytes at {:#x}, {} byte chunks",
+                                feature, aes, name, size, off, chunk));
+                        }
+                        report.throughput(
+                            format_args!("{:>8} bytes at {:#06x}+{} {:>9} {} {:>9}, {:>5} byte chunks",
+                                         size, off, skew, feature, aes, name, chunk),
+                            size * rounds, elapsed);
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,48 @@
+// SPDX-License-Identifier: Apache-2.0
+
+//! SHA256 throughput
+//!
+//! Hashes the same buffers with each SHA256 implementation built into the
+//! simulator, checking the digests against ring's.
+
+use crate::bench::{self, Bench, Report};
+use mcuboot_sys::c;
+use ring::digest;
+
+/// Image sizes hashed, from the sizes the tests install to a full 512K slot.
+pub static HASH_BENCH_SIZES: &[usize] = &[42784, 46928, 128 * 1024, 512 * 1024];
+
+/// "bootsim hashbench"
+pub struct HashBench;
+
+impl Bench for HashBench {
+    fn what(&self) -> &'static str {
+        "SHA256"
+    }
+
+    fn missing(&self) -> Option<&'static str> {
+        None
+    }
+
+    fn run(&self, rounds: usize, report: &mut Report) {
+        let backends = c::sha256_backends();
+
+        for &size in HASH_BENCH_SIZES {
+            let data = bench::bench_data(size);
+            let expected = digest::digest(&digest::SHA256, &data);
+
+            for (idx, name) in backends.iter().enumerate() {
+                let mut hash = [0u8; 32];
+                let elapsed = bench::time(rounds, || {
+                    hash = c::sha256_backend_hash(idx, &data);
+                });
+
+                if &hash[..] != expected.as_ref() {
+                    report.fail(format_args!("{}: wrong SHA256 of {} bytes", name, size));
+                }
+                report.throughput(format_args!("{:>8} bytes {:>10}", size, name),
+                                  size * rounds, elapsed);
+            }
+        }
+    }
+}
@@ -26,6 +26,7 @@ use std::{
 };
 use aes_ctr::{
     Aes128Ctr,
+    Aes256Ctr,
     stream_cipher::{
         generic_array::GenericArray,
         NewFixStreamCipher,
@@ -49,7 +50,7 @@ use crate::depends::{
     PairDep,
     UpgradeInfo,
 };
-use crate::tlv::{ManifestGen, TlvGen, TlvFlags};
+use crate::tlv::{ManifestGen, TlvGen, TlvFlags, TlvKinds};
 
 /// A builder for Images.  This describes a single run of the simulator,
 /// capturing the configuration of a particular set of devices, including
@@ -257,7 +258,7 @@ impl ImagesBuilder {
 
                 let mut flash = SimMultiFlash::new();
                 flash.insert(dev_id, dev);
-                (flash, areadesc, &[Caps::SwapUsingMove])
+                (flash, areadesc, &[Caps::SwapUsingMove, Caps::UniformSectorSize])
             }
             DeviceName::K64f => {
                 // NXP style flash.  Small sectors, one small sector for scratch.
@@ -288,7 +289,7 @@ impl ImagesBuilder {
 
                 let mut flash = SimMultiFlash::new();
                 flash.insert(dev_id, dev);
-                (flash, areadesc, &[Caps::SwapUsingMove])
+                (flash, areadesc, &[Caps::SwapUsingMove, Caps::UniformSectorSize])
             }
             DeviceName::Nrf52840 => {
                 // Simulating the flash on the nrf52840 with partitions set up so that the scratch size
@@ -323,7 +324,29 @@ impl ImagesBuilder {
                 let mut flash = SimMultiFlash::new();
                 flash.insert(0, dev0);
                 flash.insert(1, dev1);
-                (flash, areadesc, &[Caps::SwapUsingMove])
+                (flash, areadesc, &[Caps::SwapUsingMove, Caps::UniformSectorSize])
+            }
+            DeviceName::MixedSectors => {
+                // Flash made of runs of small and larger sectors, with each
+                // slot spanning two runs.
+                let mut sectors = Vec::new();
+                for _ in 0..2 {
+                    sectors.extend_from_slice(&[4096; 32]);
+                    sectors.extend_from_slice(&[8192; 16]);
+                }
+                sectors.extend_from_slice(&[8192; 2]);
+                let dev = SimFlash::new(sectors, align as usize, erased_val);
+
+                let dev_id = 0;
+                let mut areadesc = AreaDesc::new();
+                areadesc.add_flash_sectors(dev_id, &dev);
+                areadesc.add_image(0x000000, 0x040000, FlashId::Image0, dev_id);
+                areadesc.add_image(0x040000, 0x040000, FlashId::Image1, dev_id);
+                areadesc.add_image(0x080000, 0x004000, FlashId::ImageScratch, dev_id);
+
+                let mut flash = SimMultiFlash::new();
+                flash.insert(dev_id, dev);
+                (flash, areadesc, &[Caps::SwapUsingMove, Caps::UniformSectorSize])
             }
             DeviceName::K64fMulti => {
                 // NXP style flash, but larger, to support multiple images.
@@ -823,6 +846,244 @@ impl Images {
         }
     }
 
+    /// Resumes a swap whose status area has gaps between written entries,
+    /// as a failed status write would leave it. The boot loader must
+    /// detect the inconsistent status, which asserts unless the primary
+    /// slot is validated anyway.
+    pub fn run_with_inconsistent_status(&self) -> bool {
+        if Caps::OverwriteUpgrade.present() {
+            return false;
+        }
+
+        let mut flash = self.flash.clone();
+        let mut fails = 0;
+
+        info!("Try resuming a swap with inconsistent status");
+
+        self.mark_permanent_upgrades(&mut flash, 1);
+        self.mark_inconsistent_status(&mut flash, 0);
+
+        let (_, asserts) = c::boot_go(&mut flash, &self.areadesc, None, true);
+        if !Caps::ValidatePrimarySlot.present() && asserts == 0 {
+            warn!("No assert() detected");
+            fails += 1;
+        }
+
+        if fails > 0 {
+            error!("Error resuming upgrade with inconsistent status");
+        }
+
+        fails > 0
+    }
+
+    /// Boots twice, so the image in the primary slot has been validated
+    /// before, then alters its header: the image must be rejected no matter
+    /// what was recorded about it.
+    pub fn run_with_tampered_header(&self) -> bool {
+        if !Caps::ValidatePrimarySlot.present() {
+            return false;
+        }
+
+        let mut flash = self.flash.clone();
+        let mut fails = 0;
+
+        info!("Try booting an image altered after being validated");
+
+        for _ in 0..2 {
+            let (result, _) = c::boot_go(&mut flash, &self.areadesc, None, false);
+            if result != 0 {
+                warn!("Failed boot of an unaltered image");
+                fails += 1;
+            }
+        }
+
+        // Change the build number in the version of the first image.
+        let slot = &self.images[0].slots[0];
+        let dev = flash.get_mut(&slot.dev_id).unwrap();
+        let align = dev.align();
+        let off = slot.base_off + 24;
+        let mut buf = vec![0u8; align];
+        dev.read(off, &mut buf).unwrap();
+        buf[0] ^= 0x01;
+        dev.set_verify_writes(false);
+        dev.write(off, &buf).unwrap();
+        dev.set_verify_writes(true);
+
+        let (result, _) = c::boot_go(&mut flash, &self.areadesc, None, false);
+        if result == 0 {
+            warn!("Booted an altered image");
+            fails += 1;
+        }
+
+        if fails > 0 {
+            error!("Error booting an image altered after validation");
+        }
+
+        fails > 0
+    }
+
+    /// Checks that the validated record stands in for the image it was
+    /// written for, and only for that one: once an image has been booted,
+    /// a bit flipped in its payload, which the record doesn't cover, goes
+    /// unnoticed, showing that the image is not hashed again.  Moved to the
+    /// trailer of another image, the record must not spare that image from
+    /// being validated.
+    pub fn run_with_validated_record(&self) -> bool {
+        if !Caps::ValidatedRecord.present() {
+            return false;
+        }
+
+        let mut fails = 0;
+
+        info!("Try booting images with a validated record");
+
+        let slot = &self.images[0].slots[0];
+        let mut flash = self.flash.clone();
+        let (result, _) = c::boot_go(&mut flash, &self.areadesc, None, false);
+        if result != 0 {
+            warn!("Failed boot of an unaltered image");
+            fails += 1;
+        }
+        let record = self.read_validated_record(&flash, slot);
+
+        flip_payload_bit(&mut flash, slot);
+        let (result, _) = c::boot_go(&mut flash, &self.areadesc, None, false);
+        if result != 0 {
+            warn!("Image validated again despite its record");
+            fails += 1;
+        }
+
+        // Upgrade to the images in the secondary slots, then give the new
+        // image the record of the old one.
+        let mut flash = self.flash.clone();
+        for image in &self.images {
+            mark_upgrade(&mut flash, &image.slots[1]);
+        }
+        self.mark_permanent_upgrades(&mut flash, 1);
+        let (result, _) = c::boot_go(&mut flash, &self.areadesc, None, false);
+        if result != 0 {
+            warn!("Failed upgrade");
+            fails += 1;
+        }
+        if self.read_validated_record(&flash, slot) == record {
+            warn!("Same record written for different images");
+            fails += 1;
+        }
+
+        self.write_validated_record(&mut flash, slot, &record);
+        flip_payload_bit(&mut flash, slot);
+        let (result, _) = c::boot_go(&mut flash, &self.areadesc, None, false);
+        if result == 0 {
+            warn!("Booted an altered image with the record of another one");
+            fails += 1;
+        }
+
+        if fails > 0 {
+            error!("Error booting images with a validated record");
+        }
+
+        fails > 0
+    }
+
+    /// Offset of the validated record in the trailer of a slot, after the
+    /// status area.
+    fn validated_record_off(&self, slot: &SlotInfo, align: usize) -> usize {
+        slot.base_off + slot.len - self.trailer_sz(align) + self.status_sz(align)
+    }
+
+    fn read_validated_record(&self, flash: &SimMultiFlash, slot: &SlotInfo) -> Vec<u8> {
+        let dev = flash.get(&slot.dev_id).unwrap();
+        let mut record = vec![0u8; VALIDATED_RECORD_SZ];
+        dev.read(self.validated_record_off(slot, dev.align()), &mut record).unwrap();
+        record
+    }
+
+    fn write_validated_record(&self, flash: &mut SimMultiFlash, slot: &SlotInfo,
+                              record: &[u8]) {
+        let dev = flash.get_mut(&slot.dev_id).unwrap();
+        let off = self.validated_record_off(slot, dev.align());
+        dev.set_verify_writes(false);
+        dev.write(off, record).unwrap();
+        dev.set_verify_writes(true);
+    }
+
+    /// Alters the signature of each image in the primary slot in turn: the
+    /// boot must fail whichever image holds the bad signature, also when
+    /// the signatures are verified together.
+    pub fn run_with_bad_primary_signature(&self) -> bool {
+        if !Caps::ValidatePrimarySlot.present() {
+            return false;
+        }
+
+        let mut fails = 0;
+
+        info!("Try booting with a bad signature in the primary slot");
+
+        let mut flash = self.flash.clone();
+        let (result, _) = c::boot_go(&mut flash, &self.areadesc, None, false);
+        if result != 0 {
+            warn!("Failed boot of unaltered images");
+            fails += 1;
+        }
+
+        for (image_num, image) in self.images.iter().enumerate() {
+            let mut flash = self.flash.clone();
+            let slot = &image.slots[0];
+            let off = match find_signature(&flash, slot) {
+                Some(off) => slot.base_off + off,
+                // Nothing to alter without a signature.
+                None => return false,
+            };
+
+            // Flip a bit of the first byte of the signature.
+            let dev = flash.get_mut(&slot.dev_id).unwrap();
+            let align = dev.align();
+            let block = off - off % align;
+            let mut buf = vec![0u8; align];
+            dev.read(block, &mut buf).unwrap();
+            buf[off - block] ^= 0x01;
+            dev.set_verify_writes(false);
+            dev.write(block, &buf).unwrap();
+            dev.set_verify_writes(true);
+
+            let (result, _) = c::boot_go(&mut flash, &self.areadesc, None, false);
+            if result == 0 {
+                warn!("Booted with a bad signature in image {}", image_num);
+                fails += 1;
+            }
+        }
+
+        if fails > 0 {
+            error!("Error booting with a bad signature in the primary slot");
+        }
+
+        fails > 0
+    }
+
+    /// Makes the trailer of the given slot look like an interrupted swap
+    /// whose status entries 0, 2 and 4 were written, but not 1 and 3.
+    fn mark_inconsistent_status(&self, flash: &mut SimMultiFlash, slot: usize) {
+        for image in &self.images {
+            mark_upgrade(flash, &image.slots[slot]);
+
+            let dev_id = &image.slots[slot].dev_id;
+            let dev = flash.get_mut(&dev_id).unwrap();
+            let align = dev.align();
+            let off = &image.slots[slot].base_off;
+            let len = &image.slots[slot].len;
+            let status_off = off + len - self.trailer_sz(align);
+
+            let mut entry = vec![dev.erased_val(); align];
+            entry[0] = 1;
+            for i in &[0, 2, 4] {
+                dev.write(status_off + i * align, &entry).unwrap();
+            }
+
+            // The resumed swap rewrites the entries that are already set.
+            dev.set_verify_writes(false);
+        }
+    }
+
     /// Adds a new flash area that fails statistically
     fn mark_bad_status_with_rate(&self, flash: &mut SimMultiFlash, slot: usize,
                                  rate: f32) {
@@ -1181,11 +1442,16 @@ fn install_image(flash: &mut SimMultiFlash, slot: &SlotInfo, len: usize,
     if is_encrypted {
         tlv.generate_enc_key();
         let enc_key = tlv.get_enc_key();
-        let key = GenericArray::from_slice(enc_key.as_slice());
+        let key = enc_key.as_slice();
         let nonce = GenericArray::from_slice(&[0; 16]);
-        let mut cipher = Aes128Ctr::new(&key, &nonce);
         b_encimg = b_img.clone();
-        cipher.apply_keystream(&mut b_encimg);
+        if Caps::Aes256.present() {
+            Aes256Ctr::new(GenericArray::from_slice(key), &nonce)
+                .apply_keystream(&mut b_encimg);
+        } else {
+            Aes128Ctr::new(GenericArray::from_slice(key), &nonce)
+                .apply_keystream(&mut b_encimg);
+        }
     }
 
     // Build the TLV itself.
@@ -1285,6 +1551,57 @@ fn install_no_image() -> ImageData {
     }
 }
 
+/// Flips a bit of the first byte of the payload of the image in a slot.
+fn flip_payload_bit(flash: &mut SimMultiFlash, slot: &SlotInfo) {
+    let dev = flash.get_mut(&slot.dev_id).unwrap();
+    let mut hdr = [0u8; 16];
+    dev.read(slot.base_off, &mut hdr).unwrap();
+    let off = slot.base_off + u16::from_le_bytes([hdr[8], hdr[9]]) as usize;
+
+    let align = dev.align();
+    let block = off - off % align;
+    let mut buf = vec![0u8; align];
+    dev.read(block, &mut buf).unwrap();
+    buf[off - block] ^= 0x01;
+    dev.set_verify_writes(false);
+    dev.write(block, &buf).unwrap();
+    dev.set_verify_writes(true);
+}
+
+/// Returns the offset within the slot of the signature of the image in it,
+/// if it has one.
+fn find_signature(flash: &SimMultiFlash, slot: &SlotInfo) -> Option<usize> {
+    let dev = flash.get(&slot.dev_id).unwrap();
+    let read_u16 = |off: usize| {
+        let mut buf = [0u8; 2];
+        dev.read(slot.base_off + off, &mut buf).unwrap();
+        u16::from_le_bytes(buf) as usize
+    };
+
+    let mut hdr = [0u8; 16];
+    dev.read(slot.base_off, &mut hdr).unwrap();
+    let hdr_size = u16::from_le_bytes([hdr[8], hdr[9]]) as usize;
+    let protect_size = u16::from_le_bytes([hdr[10], hdr[11]]) as usize;
+    let img_size = u32::from_le_bytes([hdr[12], hdr[13], hdr[14], hdr[15]]) as usize;
+
+    // Skip the protected TLVs, and the info of the others.
+    let start = hdr_size + img_size + protect_size;
+    let end = start + read_u16(start + 2);
+    let mut off = start + 4;
+    while off < end {
+        let kind = read_u16(off);
+        let len = read_u16(off + 2);
+        if kind == TlvKinds::RSA2048 as usize ||
+           kind == TlvKinds::ECDSA256 as usize ||
+           kind == TlvKinds::RSA3072 as usize ||
+           kind == TlvKinds::ED25519 as usize {
+            return Some(off + 4);
+        }
+        off += 4 + len;
+    }
+    None
+}
+
 fn make_tlv() -> TlvGen {
     if Caps::EcdsaP224.present() {
         panic!("Ecdsa P224 not supported in Simulator");
@@ -1310,6 +1627,14 @@ fn make_tlv() -> TlvGen {
         } else {
             TlvGen::new_ecies_p256()
         }
+    } else if Caps::EncX25519.present() {
+        if Caps::EcdsaP256.present() {
+            TlvGen::new_ecdsa_ecies_x25519()
+        } else if Caps::Ed25519.present() {
+            TlvGen::new_ed25519_ecies_x25519()
+        } else {
+            TlvGen::new_ecies_x25519()
+        }
     } else {
         // The non-encrypted configuration.
         if Caps::RSA2048.present() {
@@ -1331,7 +1656,7 @@ impl ImageData {
     /// is unencrypted, and slot 1 is encrypted.
     fn find(&self, slot: usize) -> &Vec<u8> {
         let encrypted = Caps::EncRsa.present() || Caps::EncKw.present() ||
-            Caps::EncEc256.present();
+            Caps::EncEc256.present() || Caps::EncX25519.present();
         match (encrypted, slot) {
             (false, _) => &self.plain,
             (true, 0) => &self.plain,
@@ -1520,6 +1845,9 @@ const MAGIC: &[u8] = &[0x77, 0xc2, 0x95, 0xf3,
                        0x35, 0x52, 0x50, 0x0f,
                        0x2c, 0xb6, 0x79, 0x80];
 
+// Replicates BOOT_VALIDATED_RECORD_SZ in bootutil_priv.h
+const VALIDATED_RECORD_SZ: usize = 32;
+
 // Replicates defines found in bootutil.h
 const BOOT_MAGIC_GOOD: Option<u8> = Some(1);
 const BOOT_MAGIC_UNSET: Option<u8> = Some(3);
@@ -1583,6 +1911,12 @@ pub fn show_sizes() {
         let msize = c::boot_trailer_sz(*min);
         println!("{:2}: {} (0x{:x})", min, msize, msize);
     }
+
+    // The copy, hashing and status scanning code all share a single pool
+    // of buffers, so this is the only flash buffer RAM used by the loader.
+    let (bsize, bcount) = (c::boot_buf_sz(), c::boot_buf_count());
+    println!("buffers: {} x {} = {} (0x{:x})", bcount, bsize,
+             bcount * bsize, bcount * bsize);
 }
 
 #[cfg(not(feature = "large-write"))]
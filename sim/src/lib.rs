@@ -12,13 +12,21 @@ use std::{
 };
 use serde_derive::Deserialize;
 
+mod bench;
 mod caps;
 mod depends;
+mod encbench;
+mod hashbench;
 mod image;
 mod tlv;
+mod verifybench;
 pub mod testlog;
 
 pub use crate::{
+    bench::{
+        Bench,
+        check_bench,
+    },
     depends::{
         DepTest,
         DepType,
@@ -26,11 +34,14 @@ pub use crate::{
         NO_DEPS,
         REV_DEPS,
     },
+    encbench::EncBench,
+    hashbench::HashBench,
     image::{
         ImagesBuilder,
         Images,
         show_sizes,
     },
+    verifybench::VerifyBench,
 };
 
 const USAGE: &'static str = "
@@ -38,6 +49,9 @@ Mcuboot simulator
 
 Usage:
   bootsim sizes
+  bootsim hashbench
+  bootsim encbench
+  bootsim verifybench
   bootsim run --device TYPE [--align SIZE]
   bootsim runall
   bootsim (--help | --version)
@@ -57,12 +71,15 @@ struct Args {
     flag_device: Option<DeviceName>,
     flag_align: Option<AlignArg>,
     cmd_sizes: bool,
+    cmd_hashbench: bool,
+    cmd_encbench: bool,
+    cmd_verifybench: bool,
     cmd_run: bool,
     cmd_runall: bool,
 }
 
 #[derive(Copy, Clone, Debug, Deserialize)]
-pub enum DeviceName { Stm32f4, K64f, K64fBig, K64fMulti, Nrf52840, Nrf52840SpiFlash, }
+pub enum DeviceName { Stm32f4, K64f, K64fBig, K64fMulti, Nrf52840, Nrf52840SpiFlash, MixedSectors, }
 
 pub static ALL_DEVICES: &'static [DeviceName] = &[
     DeviceName::Stm32f4,
@@ -71,6 +88,7 @@ pub static ALL_DEVICES: &'static [DeviceName] = &[
     DeviceName::K64fMulti,
     DeviceName::Nrf52840,
     DeviceName::Nrf52840SpiFlash,
+    DeviceName::MixedSectors,
 ];
 
 impl fmt::Display for DeviceName {
@@ -82,6 +100,7 @@ impl fmt::Display for DeviceName {
             DeviceName::K64fMulti => "k64fmulti",
             DeviceName::Nrf52840 => "nrf52840",
             DeviceName::Nrf52840SpiFlash => "Nrf52840SpiFlash",
+            DeviceName::MixedSectors => "mixedsectors",
         };
         f.write_str(name)
     }
@@ -131,6 +150,22 @@ pub fn main() {
         return;
     }
 
+    let bench: Option<&dyn Bench> = if args.cmd_hashbench {
+        Some(&HashBench)
+    } else if args.cmd_encbench {
+        Some(&EncBench)
+    } else if args.cmd_verifybench {
+        Some(&VerifyBench)
+    } else {
+        None
+    };
+    if let Some(bench) = bench {
+        if crate::bench::run_bench(bench, bench.rounds(), true) {
+            process::exit(1);
+        }
+        return;
+    }
+
     let mut status = RunStatus::new();
     if args.cmd_run {
 
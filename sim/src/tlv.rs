@@ -16,6 +16,7 @@
 use byteorder::{
     LittleEndian, WriteBytesExt,
 };
+use crate::caps::Caps;
 use crate::image::ImageVersion;
 use pem;
 use base64;
@@ -45,6 +46,9 @@ use mcuboot_sys::c;
 pub enum TlvKinds {
     KEYHASH = 0x01,
     SHA256 = 0x10,
+    SHA384 = 0x11,
+    SHA512 = 0x12,
+    SHA256CHUNKS = 0x14,
     RSA2048 = 0x20,
     ECDSA224 = 0x21,
     ECDSA256 = 0x22,
@@ -53,6 +57,7 @@ pub enum TlvKinds {
     ENCRSA2048 = 0x30,
     ENCKW128 = 0x31,
     ENCEC256 = 0x32,
+    ENCX25519 = 0x33,
     DEPENDENCY = 0x40,
 }
 
@@ -61,6 +66,7 @@ pub enum TlvFlags {
     PIC = 0x01,
     NON_BOOTABLE = 0x02,
     ENCRYPTED = 0x04,
+    HASH_CHUNKS = 0x40,
     RAM_LOAD = 0x20,
 }
 
@@ -116,7 +122,24 @@ struct Dependency {
     version: ImageVersion,
 }
 
-const AES_KEY_LEN: usize = 16;
+/// The size of the AES keys images are encrypted with.
+pub fn aes_key_len() -> usize {
+    if Caps::Aes256.present() { 32 } else { 16 }
+}
+
+/// Size of the chunks hashed separately when the bootloader supports it.
+const HASH_CHUNK_SIZE: usize = 4096;
+
+/// The image hash the bootloader was built to expect, and its TLV.
+pub(crate) fn image_hash_alg() -> (&'static digest::Algorithm, TlvKinds) {
+    if Caps::Sha384.present() {
+        (&digest::SHA384, TlvKinds::SHA384)
+    } else if Caps::Sha512.present() {
+        (&digest::SHA512, TlvKinds::SHA512)
+    } else {
+        (&digest::SHA256, TlvKinds::SHA256)
+    }
+}
 
 impl TlvGen {
     /// Construct a new tlv generator that will only contain a hash of the data.
@@ -222,6 +245,33 @@ impl TlvGen {
             ..Default::default()
         }
     }
+
+    #[allow(dead_code)]
+    pub fn new_ecies_x25519() -> TlvGen {
+        TlvGen {
+            flags: TlvFlags::ENCRYPTED as u32,
+            kinds: vec![TlvKinds::SHA256, TlvKinds::ENCX25519],
+            ..Default::default()
+        }
+    }
+
+    #[allow(dead_code)]
+    pub fn new_ecdsa_ecies_x25519() -> TlvGen {
+        TlvGen {
+            flags: TlvFlags::ENCRYPTED as u32,
+            kinds: vec![TlvKinds::SHA256, TlvKinds::ECDSA256, TlvKinds::ENCX25519],
+            ..Default::default()
+        }
+    }
+
+    #[allow(dead_code)]
+    pub fn new_ed25519_ecies_x25519() -> TlvGen {
+        TlvGen {
+            flags: TlvFlags::ENCRYPTED as u32,
+            kinds: vec![TlvKinds::SHA256, TlvKinds::ED25519, TlvKinds::ENCX25519],
+            ..Default::default()
+        }
+    }
 }
 
 impl ManifestGen for TlvGen {
@@ -231,7 +281,11 @@ impl ManifestGen for TlvGen {
 
     /// Retrieve the header flags for this configuration.  This can be called at any time.
     fn get_flags(&self) -> u32 {
-        self.flags
+        if Caps::HashChunks.present() {
+            self.flags | TlvFlags::HASH_CHUNKS as u32
+        } else {
+            self.flags
+        }
     }
 
     /// Add bytes to the covered hash.
@@ -296,6 +350,20 @@ impl ManifestGen for TlvGen {
         let mut sig_payload = self.payload.clone();
         sig_payload.extend_from_slice(&protected_tlv);
 
+        // With chunked hashing, what gets hashed and signed is the list of
+        // chunk digests instead of the image itself.
+        let chunks = if Caps::HashChunks.present() {
+            let mut list: Vec<u8> = vec![];
+            list.write_u32::<LittleEndian>(HASH_CHUNK_SIZE as u32).unwrap();
+            for chunk in sig_payload.chunks(HASH_CHUNK_SIZE) {
+                list.extend_from_slice(digest::digest(&digest::SHA256, chunk).as_ref());
+            }
+            sig_payload = list.clone();
+            Some(list)
+        } else {
+            None
+        };
+
         let mut result: Vec<u8> = vec![];
 
         // add back signed payload
@@ -308,6 +376,8 @@ impl ManifestGen for TlvGen {
         // Placeholder for the size.
         result.write_u16::<LittleEndian>(0).unwrap();
 
+        // The SHA256 kind stands for the image hash, whose algorithm
+        // depends on how the bootloader was built.
         if self.kinds.contains(&TlvKinds::SHA256) {
             // If a signature is not requested, corrupt the hash we are
             // generating.  But, if there is a signature, output the
@@ -328,12 +398,12 @@ impl ManifestGen for TlvGen {
                 sig_payload[0] ^= 1;
             }
 
-            let hash = digest::digest(&digest::SHA256, &sig_payload);
+            let (alg, kind) = image_hash_alg();
+            let hash = digest::digest(alg, &sig_payload);
             let hash = hash.as_ref();
 
-            assert!(hash.len() == 32);
-            result.write_u16::<LittleEndian>(TlvKinds::SHA256 as u16).unwrap();
-            result.write_u16::<LittleEndian>(32).unwrap();
+            result.write_u16::<LittleEndian>(kind as u16).unwrap();
+            result.write_u16::<LittleEndian>(hash.len() as u16).unwrap();
             result.extend_from_slice(hash);
 
             // Undo the corruption.
@@ -343,6 +413,12 @@ impl ManifestGen for TlvGen {
 
         }
 
+        if let Some(list) = &chunks {
+            result.write_u16::<LittleEndian>(TlvKinds::SHA256CHUNKS as u16).unwrap();
+            result.write_u16::<LittleEndian>(list.len() as u16).unwrap();
+            result.extend_from_slice(list);
+        }
+
         if self.gen_corrupted {
             // Corrupt what is signed by modifying the input to the
             // signature code.
@@ -427,9 +503,8 @@ impl ManifestGen for TlvGen {
             result.write_u16::<LittleEndian>(32).unwrap();
             result.extend_from_slice(keyhash);
 
-            let hash = digest::digest(&digest::SHA256, &sig_payload);
+            let hash = digest::digest(image_hash_alg().0, &sig_payload);
             let hash = hash.as_ref();
-            assert!(hash.len() == 32);
 
             let key_bytes = pem::parse(include_bytes!("../../root-ed25519.pem").as_ref()).unwrap();
             assert_eq!(key_bytes.tag, "PRIVATE KEY");
@@ -464,8 +539,12 @@ impl ManifestGen for TlvGen {
         }
 
         if self.kinds.contains(&TlvKinds::ENCKW128) {
-            let key_bytes = base64::decode(
-                include_str!("../../enc-aes128kw.b64").trim()).unwrap();
+            // The key-encryption key has the size of the image keys.
+            let key_bytes = if Caps::Aes256.present() {
+                base64::decode(include_str!("../../enc-aes256kw.b64").trim()).unwrap()
+            } else {
+                base64::decode(include_str!("../../enc-aes128kw.b64").trim()).unwrap()
+            };
 
             let cipherkey = self.get_enc_key();
             let cipherkey = cipherkey.as_slice();
@@ -474,18 +553,26 @@ impl ManifestGen for TlvGen {
                 Err(_) => panic!("Failed to encrypt secret key"),
             };
 
-            assert!(encbuf.len() == 24);
+            assert!(encbuf.len() == aes_key_len() + 8);
             result.write_u16::<LittleEndian>(TlvKinds::ENCKW128 as u16).unwrap();
-            result.write_u16::<LittleEndian>(24).unwrap();
+            result.write_u16::<LittleEndian>(encbuf.len() as u16).unwrap();
             result.extend_from_slice(&encbuf);
         }
 
-        if self.kinds.contains(&TlvKinds::ENCEC256) {
-            let key_bytes = pem::parse(include_bytes!("../../enc-ec256-pub.pem").as_ref()).unwrap();
+        if self.kinds.contains(&TlvKinds::ENCEC256) || self.kinds.contains(&TlvKinds::ENCX25519) {
+            // The ephemeral key agreement, and the recipient's public key
+            // without its SubjectPublicKeyInfo header.
+            let (kind, alg, key_bytes, key_off) = if self.kinds.contains(&TlvKinds::ENCEC256) {
+                (TlvKinds::ENCEC256, &agreement::ECDH_P256,
+                 pem::parse(include_bytes!("../../enc-ec256-pub.pem").as_ref()).unwrap(), 26)
+            } else {
+                (TlvKinds::ENCX25519, &agreement::X25519,
+                 pem::parse(include_bytes!("../../enc-x25519-pub.pem").as_ref()).unwrap(), 12)
+            };
             assert_eq!(key_bytes.tag, "PUBLIC KEY");
 
             let rng = rand::SystemRandom::new();
-            let pk = match agreement::EphemeralPrivateKey::generate(&agreement::ECDH_P256, &rng) {
+            let pk = match agreement::EphemeralPrivateKey::generate(alg, &rng) {
                 Ok(v) => v,
                 Err(_) => panic!("Failed to generate ephemeral keypair"),
             };
@@ -495,7 +582,7 @@ impl ManifestGen for TlvGen {
                 Err(_) => panic!("Failed computing ephemeral public key"),
             };
 
-            let peer_pubk = agreement::UnparsedPublicKey::new(&agreement::ECDH_P256, &key_bytes.contents[26..]);
+            let peer_pubk = agreement::UnparsedPublicKey::new(alg, &key_bytes.contents[key_off..]);
 
             #[derive(Debug, PartialEq)]
             struct OkmLen<T: core::fmt::Debug + PartialEq>(T);
@@ -539,9 +626,9 @@ impl ManifestGen for TlvGen {
             buf.append(&mut tag.as_ref().to_vec());
             buf.append(&mut cipherkey);
 
-            assert!(buf.len() == 113);
-            result.write_u16::<LittleEndian>(TlvKinds::ENCEC256 as u16).unwrap();
-            result.write_u16::<LittleEndian>(113).unwrap();
+            assert!(buf.len() == if kind == TlvKinds::ENCEC256 { 113 } else { 80 });
+            result.write_u16::<LittleEndian>(kind as u16).unwrap();
+            result.write_u16::<LittleEndian>(buf.len() as u16).unwrap();
             result.extend_from_slice(&buf);
         }
 
@@ -555,7 +642,7 @@ impl ManifestGen for TlvGen {
 
     fn generate_enc_key(&mut self) {
         let rng = rand::SystemRandom::new();
-        let mut buf = vec![0u8; AES_KEY_LEN];
+        let mut buf = vec![0u8; aes_key_len()];
         match rng.fill(&mut buf) {
             Err(_) => panic!("Error generating encrypted key"),
             Ok(_) => (),
@@ -565,7 +652,7 @@ impl ManifestGen for TlvGen {
     }
 
     fn get_enc_key(&self) -> Vec<u8> {
-        if self.enc_key.len() != AES_KEY_LEN {
+        if self.enc_key.len() != aes_key_len() {
             panic!("No random key was generated");
         }
         self.enc_key.clone()
@@ -0,0 +1,178 @@
+// SPDX-License-Identifier: Apache-2.0
+
+//! Signature verification latency
+//!
+//! Signs messages with the simulator's RSA, ECDSA P-256 or ED25519 root key
+//! and times how long the bootloader takes to verify each signature.  Altered
+//! hashes must fail.  RSA signatures are checked with the precomputed form of
+//! the key and, when built with rsa-parsed-key, also by parsing it.
+
+use crate::bench::{self, Bench, Report};
+use crate::caps::Caps;
+use crate::tlv::image_hash_alg;
+use mcuboot_sys::c;
+use ring::{digest, rand};
+use ring::signature::{
+    EcdsaKeyPair,
+    ECDSA_P256_SHA256_ASN1_SIGNING,
+    Ed25519KeyPair,
+    RsaKeyPair,
+    RSA_PSS_SHA256,
+};
+use std::time::Duration;
+
+enum Signer {
+    Rsa(RsaKeyPair, &'static str),
+    Ecdsa(EcdsaKeyPair),
+    Ed25519(Ed25519KeyPair),
+}
+
+impl Signer {
+    /// The root key of the signature type the simulator verifies, if any.
+    fn new() -> Option<Signer> {
+        if Caps::RSA2048.present() || Caps::RSA3072.present() {
+            let (key_bytes, name) = if Caps::RSA2048.present() {
+                (pem::parse(include_bytes!("../../root-rsa-2048.pem").as_ref()).unwrap(),
+                 "RSA-2048")
+            } else {
+                (pem::parse(include_bytes!("../../root-rsa-3072.pem").as_ref()).unwrap(),
+                 "RSA-3072")
+            };
+            let key_pair = RsaKeyPair::from_der(&key_bytes.contents).unwrap();
+            Some(Signer::Rsa(key_pair, name))
+        } else if Caps::EcdsaP256.present() {
+            let key_bytes = pem::parse(include_bytes!("../../root-ec-p256-pkcs8.pem").as_ref()).unwrap();
+            let key_pair = EcdsaKeyPair::from_pkcs8(&ECDSA_P256_SHA256_ASN1_SIGNING,
+                                                    &key_bytes.contents).unwrap();
+            Some(Signer::Ecdsa(key_pair))
+        } else if Caps::Ed25519.present() {
+            let key_bytes = pem::parse(include_bytes!("../../root-ed25519.pem").as_ref()).unwrap();
+            let key_pair = Ed25519KeyPair::from_seed_and_public_key(
+                &key_bytes.contents[16..48], &ED25519_PUB_KEY[12..44]).unwrap();
+            Some(Signer::Ed25519(key_pair))
+        } else {
+            None
+        }
+    }
+
+    fn name(&self) -> &'static str {
+        match *self {
+            Signer::Rsa(_, name) => name,
+            Signer::Ecdsa(_) => "ECDSA P-256",
+            Signer::Ed25519(_) => "ED25519",
+        }
+    }
+
+    /// Hash `message` as an image would be, returning the hash and its
+    /// signature.
+    fn sign(&self, message: &[u8]) -> (Vec<u8>, Vec<u8>) {
+        match *self {
+            Signer::Rsa(ref key_pair, _) => {
+                let rng = rand::SystemRandom::new();
+                let hash = digest::digest(&digest::SHA256, message);
+                let mut signature = vec![0; key_pair.public_modulus_len()];
+                key_pair.sign(&RSA_PSS_SHA256, &rng, message, &mut signature).unwrap();
+                (hash.as_ref().to_vec(), signature)
+            }
+            Signer::Ecdsa(ref key_pair) => {
+                let rng = rand::SystemRandom::new();
+                let hash = digest::digest(&digest::SHA256, message);
+                let signature = key_pair.sign(&rng, message).unwrap();
+                (hash.as_ref().to_vec(), signature.as_ref().to_vec())
+            }
+            Signer::Ed25519(ref key_pair) => {
+                let hash = digest::digest(image_hash_alg().0, message);
+                let signature = key_pair.sign(hash.as_ref());
+                (hash.as_ref().to_vec(), signature.as_ref().to_vec())
+            }
+        }
+    }
+
+    /// The built in keys to check signatures with, and how they are stored.
+    fn keys(&self) -> &'static [(u8, &'static str)] {
+        match *self {
+            Signer::Rsa(..) => &[(0, "precomputed key"), (1, "parsed key")],
+            _ => &[(0, "")],
+        }
+    }
+}
+
+/// "bootsim verifybench"
+pub struct VerifyBench;
+
+impl Bench for VerifyBench {
+    fn what(&self) -> &'static str {
+        "signature verification"
+    }
+
+    fn missing(&self) -> Option<&'static str> {
+        if Caps::RSA2048.present() || Caps::RSA3072.present() ||
+           Caps::EcdsaP256.present() || Caps::Ed25519.present() {
+            None
+        } else {
+            Some("sig-rsa, sig-rsa3072, sig-ecdsa or sig-ed25519")
+        }
+    }
+
+    fn rounds(&self) -> usize {
+        100
+    }
+
+    fn test_rounds(&self) -> usize {
+        20
+    }
+
+    fn run(&self, rounds: usize, report: &mut Report) {
+        let signer = Signer::new().unwrap();
+
+        for &(key_id, key_name) in signer.keys() {
+            // The parsed RSA key is only built in with rsa-parsed-key.
+            if key_id > 0 && c::sig_verify(key_id, &[0; 32], &[0; 1]).is_none() {
+                continue;
+            }
+
+            let mut first = Duration::new(0, 0);
+            let mut total = Duration::new(0, 0);
+            let mut worst = Duration::new(0, 0);
+
+            for round in 0 .. rounds {
+                let message: Vec<u8> = (0 .. 64).map(|i| (i * 7 + round * 13) as u8).collect();
+                let (mut hash, signature) = signer.sign(&message);
+
+                let mut good = None;
+                let elapsed = bench::time(1, || {
+                    good = c::sig_verify(key_id, &hash, &signature);
+                });
+
+                if good != Some(true) {
+                    report.fail(format_args!("Good {} signature {} rejected",
+                                             signer.name(), round));
+                }
+                // The first check also decodes the key, when that is cached.
+                if round == 0 {
+                    first = elapsed;
+                } else {
+                    total += elapsed;
+                    worst = worst.max(elapsed);
+                }
+
+                hash[round % hash.len()] ^= 1 << (round % 8);
+                if c::sig_verify(key_id, &hash, &signature) != Some(false) {
+                    report.fail(format_args!("{} signature {} accepted for the wrong hash",
+                                             signer.name(), round));
+                }
+            }
+
+            if report.show() && rounds > 1 {
+                println!("{} verify: {:8.1} us first, {:8.1} us mean, {:8.1} us worst {}",
+                         signer.name(),
+                         first.as_secs_f64() * 1e6,
+                         total.as_secs_f64() * 1e6 / (rounds - 1) as f64,
+                         worst.as_secs_f64() * 1e6,
+                         key_name);
+            }
+        }
+    }
+}
+
+include!("ed25519_pub_key-rs.txt");
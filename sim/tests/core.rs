@@ -13,6 +13,10 @@ use bootsim::{
     Images,
     NO_DEPS,
     REV_DEPS,
+    EncBench,
+    HashBench,
+    VerifyBench,
+    check_bench,
     testlog,
 };
 use std::{
@@ -55,8 +59,29 @@ sim_test!(perm_with_random_fails, make_image(&NO_DEPS, true), run_perm_with_rand
 sim_test!(norevert, make_image(&NO_DEPS, true), run_norevert());
 sim_test!(status_write_fails_complete, make_image(&NO_DEPS, true), run_with_status_fails_complete());
 sim_test!(status_write_fails_with_reset, make_image(&NO_DEPS, true), run_with_status_fails_with_reset());
+sim_test!(status_inconsistent, make_image(&NO_DEPS, true), run_with_inconsistent_status());
+sim_test!(tampered_header, make_image(&NO_DEPS, true), run_with_tampered_header());
+sim_test!(validated_record, make_no_upgrade_image(&NO_DEPS), run_with_validated_record());
+sim_test!(bad_primary_signature, make_no_upgrade_image(&NO_DEPS), run_with_bad_primary_signature());
 sim_test!(downgrade_prevention, make_image(&REV_DEPS, true), run_nodowngrade());
 
+/// Check the results of one of the crypto benchmarks, without timing it.
+macro_rules! bench_test {
+    ($name:ident, $bench:expr) => {
+        #[test]
+        fn $name() {
+            testlog::setup();
+            assert!(!check_bench(&$bench));
+        }
+    };
+}
+
+// Each SHA256 implementation, AES-CTR for encrypted images, and signature
+// verification of good and altered hashes.
+bench_test!(sha256_backends, HashBench);
+bench_test!(enc_ctr, EncBench);
+bench_test!(sig_verify, VerifyBench);
+
 // Test various combinations of incorrect dependencies.
 test_shell!(dependency_combos, r, {
     // Only test setups with two images.